@@ -60,6 +60,8 @@ void CAppParamParser::DisplayHelp()
   printf("  --debug\t\tEnable debug logging\n");
   printf("  --version\t\tPrint version information\n");
   printf("  --test\t\tEnable test mode. [FILE] required.\n");
+  printf("  --trace\t\tRecord where the time goes during startup and in each frame.\n");
+  printf("\t\t\tThe traces are saved to special://temp/ on startup and exit.\n");
   printf("  --settings=<filename>\t\tLoads specified file after advancedsettings.xml replacing any settings specified\n");
   printf("  \t\t\t\tspecified file must exist in special://xbmc/system/\n");
   exit(0);
@@ -81,6 +83,8 @@ void CAppParamParser::ParseArg(const std::string &arg)
     m_logLevel = LOG_LEVEL_DEBUG;
   else if (arg == "--test")
     m_testmode = true;
+  else if (arg == "--trace")
+    m_trace = true;
   else if (arg.substr(0, 11) == "--settings=")
     m_settingsFile = arg.substr(11);
   else if (arg.length() != 0 && arg[0] != '-')
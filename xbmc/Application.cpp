@@ -37,6 +37,8 @@
 #include "GUIInfoManager.h"
 #include "playlists/PlayListFactory.h"
 #include "guilib/GUIFontManager.h"
+#include "guilib/GUIFrameStats.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/GUIColorManager.h"
 #include "guilib/StereoscopicsManager.h"
 #include "addons/Skin.h"
@@ -65,6 +67,7 @@
 #include "filesystem/PluginDirectory.h"
 #include "utils/SystemInfo.h"
 #include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 #include "GUILargeTextureManager.h"
 #include "TextureCache.h"
 #include "playlists/SmartPlayList.h"
@@ -362,6 +365,13 @@ void CApplication::Preflight()
 
 bool CApplication::Create(const CAppParamParser &params)
 {
+  if (params.m_trace)
+  {
+    CTraceRecorder::Start();
+    CTraceRecorder::SetThreadName("main");
+  }
+  KODI_TRACE_SCOPE("CApplication::Create");
+
   // Grab a handle to our thread to be used later in identifying the render thread.
   m_threadID = CThread::GetCurrentThreadId();
 
@@ -607,6 +617,7 @@ bool CApplication::Create(const CAppParamParser &params)
 
 bool CApplication::CreateGUI()
 {
+  KODI_TRACE_SCOPE("CApplication::CreateGUI");
   m_frameMoveGuard.lock();
 
   m_renderGUI = true;
@@ -672,6 +683,9 @@ bool CApplication::CreateGUI()
   m_pGUI.reset(new CGUIComponent());
   m_pGUI->Init();
 
+  const uint64_t textureMemoryBudget = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureMemoryBudget;
+  CGUITextureBudget::GetInstance().SetBudget(textureMemoryBudget ? textureMemoryBudget * 1024 * 1024 : CGUITextureBudget::GetDefaultBudget());
+
   // Splash requires gui component!!
   CServiceBroker::GetRenderSystem()->ShowSplash("");
 
@@ -714,6 +728,8 @@ bool CApplication::InitWindow(RESOLUTION res)
 
 bool CApplication::Initialize()
 {
+  KODI_TRACE_SCOPE("CApplication::Initialize");
+
 #if defined(HAS_DVD_DRIVE) && !defined(TARGET_WINDOWS) // somehow this throws an "unresolved external symbol" on win32
   // turn off cdio logging
   cdio_loglevel_default = CDIO_LOG_ERROR;
@@ -828,7 +844,10 @@ bool CApplication::Initialize()
     {
       // activate the configured start window
       int firstWindow = g_SkinInfo->GetFirstWindow();
-      CServiceBroker::GetGUI()->GetWindowManager().ActivateWindow(firstWindow);
+      {
+        KODI_TRACE_SCOPE("first window");
+        CServiceBroker::GetGUI()->GetWindowManager().ActivateWindow(firstWindow);
+      }
 
       if (CServiceBroker::GetGUI()->GetWindowManager().IsWindowActive(WINDOW_STARTUP_ANIM))
       {
@@ -1215,6 +1234,8 @@ bool CApplication::Save(TiXmlNode *settings) const
 
 bool CApplication::LoadSkin(const std::string& skinID)
 {
+  KODI_TRACE_SCOPE("CApplication::LoadSkin");
+
   SkinPtr skin;
   {
     AddonPtr addon;
@@ -1266,20 +1287,38 @@ bool CApplication::LoadSkin(const std::string& skinID)
 
   UnloadSkin();
 
-  skin->Start();
-
-  // migrate any skin-specific settings that are still stored in guisettings.xml
-  CSkinSettings::GetInstance().MigrateSettings(skin);
+  // time spent in each phase of loading the skin, reported once it's loaded
+  std::vector<std::pair<const char*, float>> phases;
+  const int64_t skinStart = CurrentHostCounter();
+  int64_t phaseStart = skinStart;
+  auto endPhase = [&phases, &phaseStart](const char* phase)
+  {
+    const int64_t now = CurrentHostCounter();
+    phases.emplace_back(phase, 1000.f * (now - phaseStart) / CurrentHostFrequency());
+    phaseStart = now;
+  };
 
-  // check if the skin has been properly loaded and if it has a Home.xml
-  if (!skin->HasSkinFile("Home.xml"))
   {
-    CLog::Log(LOGERROR, "failed to load requested skin '%s'", skin->ID().c_str());
-    return false;
+    KODI_TRACE_SCOPE("start");
+    skin->Start();
+
+    // migrate any skin-specific settings that are still stored in guisettings.xml
+    CSkinSettings::GetInstance().MigrateSettings(skin);
+
+    // check if the skin has been properly loaded and if it has a Home.xml
+    if (!skin->HasSkinFile("Home.xml"))
+    {
+      CLog::Log(LOGERROR, "failed to load requested skin '%s'", skin->ID().c_str());
+      return false;
+    }
+
+    CLog::Log(LOGNOTICE, "  load skin from: %s (version: %s)", skin->Path().c_str(), skin->Version().asString().c_str());
+    g_SkinInfo = skin;
   }
+  endPhase("start");
 
-  CLog::Log(LOGNOTICE, "  load skin from: %s (version: %s)", skin->Path().c_str(), skin->Version().asString().c_str());
-  g_SkinInfo = skin;
+  // parse the windows while the includes, fonts and strings are loaded
+  CServiceBroker::GetGUI()->GetWindowManager().PreloadWindows();
 
   CLog::Log(LOGINFO, "  load fonts for skin...");
   CServiceBroker::GetWinSystem()->GetGfxContext().SetMediaDir(skin->Path());
@@ -1288,46 +1327,64 @@ bool CApplication::LoadSkin(const std::string& skinID)
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
   CServiceBroker::GetGUI()->GetColorManager().Load(settings->GetString(CSettings::SETTING_LOOKANDFEEL_SKINCOLORS));
 
-  g_SkinInfo->LoadIncludes();
-
-  g_fontManager.LoadFonts(settings->GetString(CSettings::SETTING_LOOKANDFEEL_FONT));
-
-  // load in the skin strings
-  std::string langPath = URIUtils::AddFileToFolder(skin->Path(), "language");
-  URIUtils::AddSlashAtEnd(langPath);
+  {
+    KODI_TRACE_SCOPE("includes");
+    g_SkinInfo->LoadIncludes();
+  }
+  endPhase("includes");
 
-  g_localizeStrings.LoadSkinStrings(langPath, settings->GetString(CSettings::SETTING_LOCALE_LANGUAGE));
+  {
+    KODI_TRACE_SCOPE("fonts");
+    g_fontManager.LoadFonts(settings->GetString(CSettings::SETTING_LOOKANDFEEL_FONT));
+  }
+  endPhase("fonts");
 
+  {
+    KODI_TRACE_SCOPE("strings");
+    // load in the skin strings
+    std::string langPath = URIUtils::AddFileToFolder(skin->Path(), "language");
+    URIUtils::AddSlashAtEnd(langPath);
 
-  int64_t start;
-  start = CurrentHostCounter();
+    g_localizeStrings.LoadSkinStrings(langPath, settings->GetString(CSettings::SETTING_LOCALE_LANGUAGE));
+  }
+  endPhase("strings");
 
   CLog::Log(LOGINFO, "  load new skin...");
 
-  // Load custom windows
-  LoadCustomWindows();
-
-  int64_t end, freq;
-  end = CurrentHostCounter();
-  freq = CurrentHostFrequency();
-  CLog::Log(LOGDEBUG,"Load Skin XML: %.2fms", 1000.f * (end - start) / freq);
+  {
+    KODI_TRACE_SCOPE("custom windows");
+    // Load custom windows
+    LoadCustomWindows();
+  }
+  endPhase("custom windows");
 
   CLog::Log(LOGINFO, "  initialize new skin...");
-  CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(this);
-  CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&CServiceBroker::GetPlaylistPlayer());
-  CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&g_fontManager);
-  CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&CServiceBroker::GetGUI()->GetStereoscopicsManager());
-  CServiceBroker::GetGUI()->GetWindowManager().SetCallback(*this);
-  //@todo should be done by GUIComponents
-  CServiceBroker::GetGUI()->GetWindowManager().Initialize();
-  CTextureCache::GetInstance().Initialize();
-  CServiceBroker::GetGUI()->GetAudioManager().Enable(true);
-  CServiceBroker::GetGUI()->GetAudioManager().Load();
+  {
+    KODI_TRACE_SCOPE("windows");
+    CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(this);
+    CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&CServiceBroker::GetPlaylistPlayer());
+    CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&g_fontManager);
+    CServiceBroker::GetGUI()->GetWindowManager().AddMsgTarget(&CServiceBroker::GetGUI()->GetStereoscopicsManager());
+    CServiceBroker::GetGUI()->GetWindowManager().SetCallback(*this);
+    //@todo should be done by GUIComponents
+    CServiceBroker::GetGUI()->GetWindowManager().Initialize();
+  }
+  endPhase("windows");
+  {
+    KODI_TRACE_SCOPE("sounds");
+    CTextureCache::GetInstance().Initialize();
+    CServiceBroker::GetGUI()->GetAudioManager().Enable(true);
+    CServiceBroker::GetGUI()->GetAudioManager().Load();
+  }
+  endPhase("sounds");
 
   if (g_SkinInfo->HasSkinFile("DialogFullScreenInfo.xml"))
     CServiceBroker::GetGUI()->GetWindowManager().Add(new CGUIDialogFullScreenInfo);
 
-  CLog::Log(LOGINFO, "  skin loaded...");
+  std::string report;
+  for (const auto &phase : phases)
+    report += StringUtils::Format("%s%s %.2fms", report.empty() ? "" : ", ", phase.first, phase.second);
+  CLog::Log(LOGNOTICE, "  skin loaded in %.2fms (%s)", 1000.f * (CurrentHostCounter() - skinStart) / CurrentHostFrequency(), report.c_str());
 
   // leave the graphics lock
   lock.Leave();
@@ -1564,16 +1621,24 @@ void CApplication::Render()
   // reset our info cache - we do this at the end of Render so that it is
   // fresh for the next process(), or after a windowclose animation (where process()
   // isn't called)
-  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
-  infoMgr.ResetCache();
-  infoMgr.GetInfoProviders().GetGUIControlsInfoProvider().ResetContainerMovingCache();
-
-  if (hasRendered)
   {
-    infoMgr.GetInfoProviders().GetSystemInfoProvider().UpdateFPS();
+    CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_INFO);
+    CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+    infoMgr.PublishChange(INFO::INFO_SOURCE_FRAME);
+    infoMgr.GetInfoProviders().GetGUIControlsInfoProvider().ResetContainerMovingCache();
+
+    if (hasRendered)
+    {
+      infoMgr.GetInfoProviders().GetSystemInfoProvider().UpdateFPS();
+    }
   }
 
-  CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered, m_appPlayer.IsRenderingVideoLayer());
+  {
+    CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_SWAP);
+    CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered, m_appPlayer.IsRenderingVideoLayer());
+  }
+  CGUIFrameStats::GetInstance().EndFrame();
+  CGUITextureBudget::GetInstance().EndFrame();
 
   CTimeUtils::UpdateFrameTime(hasRendered);
 }
@@ -2410,7 +2475,10 @@ void CApplication::FrameMove(bool processEvents, bool processGUI)
     if (!m_bStop)
     {
       if (!m_skipGuiRender)
+      {
+        CServiceBroker::GetGUI()->GetLargeTextureManager().UploadTextures();
         CServiceBroker::GetGUI()->GetWindowManager().Process(CTimeUtils::GetFrameTime());
+      }
     }
     CServiceBroker::GetGUI()->GetWindowManager().FrameMove();
   }
@@ -3039,6 +3107,8 @@ void CApplication::OnPlayBackEnded()
 {
   CLog::LogF(LOGDEBUG ,"CApplication::OnPlayBackEnded");
 
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_PLAYER);
+
   CServiceBroker::GetPVRManager().OnPlaybackEnded(m_itemCurrentFile);
 
   CVariant data(CVariant::VariantTypeObject);
@@ -3053,6 +3123,8 @@ void CApplication::OnPlayBackStarted(const CFileItem &file)
 {
   CLog::LogF(LOGDEBUG,"CApplication::OnPlayBackStarted");
 
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_PLAYER);
+
   // check if VideoPlayer should set file item stream details from its current streams
   if (file.GetProperty("get_stream_details_from_player").asBoolean())
     m_appPlayer.SetUpdateStreamDetails();
@@ -3161,6 +3233,8 @@ void CApplication::OnPlayBackStopped()
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnPlayBackStopped");
 
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_PLAYER);
+
 #if defined(TARGET_DARWIN_IOS)
   CDarwinUtils::EnableOSScreenSaver(true);
 #endif
@@ -3253,6 +3327,8 @@ void CApplication::OnAVStarted(const CFileItem &file)
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnAVStarted");
 
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_PLAYER);
+
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVSTARTED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
 
@@ -3266,6 +3342,8 @@ void CApplication::OnAVChange()
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnAVChange");
 
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_PLAYER);
+
   CServiceBroker::GetGUI()->GetStereoscopicsManager().OnStreamChange();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVCHANGE, 0, 0);
@@ -8,6 +8,7 @@
 
 #include "BackgroundInfoLoader.h"
 #include "FileItem.h"
+#include "PlaceholderLoader.h"
 #include "threads/Thread.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
@@ -46,6 +47,7 @@ void CBackgroundInfoLoader::Run()
 
         try
         {
+          CPlaceholderLoader::CItemLock itemLock(m_placeholderLoader, pItem.get());
           if (LoadItemCached(pItem.get()) && m_pObserver)
             m_pObserver->OnItemLoaded(pItem.get());
         }
@@ -66,6 +68,7 @@ void CBackgroundInfoLoader::Run()
 
         try
         {
+          CPlaceholderLoader::CItemLock itemLock(m_placeholderLoader, pItem.get());
           if (LoadItemLookup(pItem.get()) && m_pObserver)
             m_pObserver->OnItemLoaded(pItem.get());
         }
@@ -99,6 +102,7 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
     m_vecItems.push_back(items[nItem]);
 
   m_pVecItems = &items;
+  m_placeholderLoader = items.GetPlaceholderLoader();
   m_bStop = false;
   m_bIsLoading = true;
 
@@ -125,6 +129,7 @@ void CBackgroundInfoLoader::StopThread()
   }
   m_vecItems.clear();
   m_pVecItems = NULL;
+  m_placeholderLoader.reset();
   m_bIsLoading = false;
 }
 
@@ -17,6 +17,7 @@
 
 class CFileItem; typedef std::shared_ptr<CFileItem> CFileItemPtr;
 class CFileItemList;
+class CPlaceholderLoader;
 class CThread;
 
 class IBackgroundLoaderObserver
@@ -50,6 +51,7 @@ protected:
 
   CFileItemList *m_pVecItems;
   std::vector<CFileItemPtr> m_vecItems; // FileItemList would delete the items and we only want to keep a reference.
+  std::shared_ptr<CPlaceholderLoader> m_placeholderLoader; // fills in the items while they're loaded
   CCriticalSection m_lock;
 
   volatile bool m_bIsLoading;
@@ -158,7 +158,7 @@ CFileItem::CFileItem(const CPVREpgInfoTagPtr& tag)
   Initialize();
 
   m_bIsFolder = false;
-  m_epgInfoTag = tag;
+  GetSharedTags().epgInfoTag = tag;
   m_strPath = tag->Path();
   SetLabel(GetEpgTagTitle(tag));
   m_dateTime = tag->StartAsLocalTime();
@@ -188,7 +188,7 @@ CFileItem::CFileItem(const CPVRChannelPtr& channel)
 
   m_strPath = channel->Path();
   m_bIsFolder = false;
-  m_pvrChannelInfoTag = channel;
+  GetSharedTags().pvrChannelInfoTag = channel;
   SetLabel(channel->ChannelName());
 
   if (!channel->IconPath().empty())
@@ -211,7 +211,7 @@ CFileItem::CFileItem(const CPVRRecordingPtr& record)
   Initialize();
 
   m_bIsFolder = false;
-  m_pvrRecordingInfoTag = record;
+  GetSharedTags().pvrRecordingInfoTag = record;
   m_strPath = record->m_strFileNameAndPath;
   SetLabel(record->m_strTitle);
   m_dateTime = record->RecordingTimeAsLocalTime();
@@ -237,7 +237,7 @@ CFileItem::CFileItem(const CPVRTimerInfoTagPtr& timer)
   Initialize();
 
   m_bIsFolder = timer->IsTimerRule();
-  m_pvrTimerInfoTag = timer;
+  GetSharedTags().pvrTimerInfoTag = timer;
   m_strPath = timer->Path();
   SetLabel(timer->Title());
   m_dateTime = timer->StartAsLocalTime();
@@ -350,16 +350,17 @@ CFileItem::CFileItem(const CMediaSource& share)
   FillInMimeType(false);
 }
 
-CFileItem::CFileItem(std::shared_ptr<const ADDON::IAddon> addonInfo) : m_addonInfo(std::move(addonInfo))
+CFileItem::CFileItem(std::shared_ptr<const ADDON::IAddon> addonInfo)
 {
   Initialize();
+  GetSharedTags().addonInfo = std::move(addonInfo);
 }
 
 CFileItem::CFileItem(const EventPtr& eventLogEntry)
 {
   Initialize();
 
-  m_eventLogEntry = eventLogEntry;
+  GetSharedTags().eventLogEntry = eventLogEntry;
   SetLabel(eventLogEntry->GetLabel());
   m_dateTime = eventLogEntry->GetDateTime();
   if (!eventLogEntry->GetIcon().empty())
@@ -447,12 +448,7 @@ CFileItem& CFileItem::operator=(const CFileItem& item)
     m_gameInfoTag = NULL;
   }
 
-  m_epgInfoTag = item.m_epgInfoTag;
-  m_pvrChannelInfoTag = item.m_pvrChannelInfoTag;
-  m_pvrRecordingInfoTag = item.m_pvrRecordingInfoTag;
-  m_pvrTimerInfoTag = item.m_pvrTimerInfoTag;
-  m_addonInfo = item.m_addonInfo;
-  m_eventLogEntry = item.m_eventLogEntry;
+  m_sharedTags.reset(item.m_sharedTags ? new SSharedTags(*item.m_sharedTags) : nullptr);
 
   m_lStartOffset = item.m_lStartOffset;
   m_lStartPartNumber = item.m_lStartPartNumber;
@@ -470,6 +466,7 @@ CFileItem& CFileItem::operator=(const CFileItem& item)
   m_extrainfo = item.m_extrainfo;
   m_specialSort = item.m_specialSort;
   m_bIsAlbum = item.m_bIsAlbum;
+  m_bIsPlaceholder = item.m_bIsPlaceholder;
   m_doContentLookup = item.m_doContentLookup;
   return *this;
 }
@@ -482,6 +479,7 @@ void CFileItem::Initialize()
   m_gameInfoTag = NULL;
   m_bLabelPreformatted = false;
   m_bIsAlbum = false;
+  m_bIsPlaceholder = false;
   m_dwSize = 0;
   m_bIsParentFolder = false;
   m_bIsShareOrDrive = false;
@@ -520,22 +518,31 @@ void CFileItem::Reset()
   m_musicInfoTag=NULL;
   delete m_videoInfoTag;
   m_videoInfoTag=NULL;
-  m_epgInfoTag.reset();
-  m_pvrChannelInfoTag.reset();
-  m_pvrRecordingInfoTag.reset();
-  m_pvrTimerInfoTag.reset();
+  m_sharedTags.reset();
   delete m_pictureInfoTag;
   m_pictureInfoTag=NULL;
   delete m_gameInfoTag;
   m_gameInfoTag = NULL;
   m_extrainfo.clear();
   ClearProperties();
-  m_eventLogEntry.reset();
 
   Initialize();
   SetInvalid();
 }
 
+CFileItem::SSharedTags& CFileItem::GetSharedTags()
+{
+  if (!m_sharedTags)
+    m_sharedTags.reset(new SSharedTags);
+  return *m_sharedTags;
+}
+
+void CFileItem::SetEPGInfoTag(const PVR::CPVREpgInfoTagPtr& tag)
+{
+  if (tag || m_sharedTags)
+    GetSharedTags().epgInfoTag = tag;
+}
+
 // do not archive dynamic path
 void CFileItem::Archive(CArchive& ar)
 {
@@ -744,8 +751,8 @@ void CFileItem::ToSortable(SortItem &sortable, Field field) const
   if (HasGameInfoTag())
     GetGameInfoTag()->ToSortable(sortable, field);
 
-  if (m_eventLogEntry)
-    m_eventLogEntry->ToSortable(sortable, field);
+  if (m_sharedTags && m_sharedTags->eventLogEntry)
+    m_sharedTags->eventLogEntry->ToSortable(sortable, field);
 }
 
 void CFileItem::ToSortable(SortItem &sortable, const Fields &fields) const
@@ -856,17 +863,17 @@ bool CFileItem::IsPVRRecording() const
 
 bool CFileItem::IsUsablePVRRecording() const
 {
-  return (m_pvrRecordingInfoTag && !m_pvrRecordingInfoTag->IsDeleted());
+  return (HasPVRRecordingInfoTag() && !m_sharedTags->pvrRecordingInfoTag->IsDeleted());
 }
 
 bool CFileItem::IsDeletedPVRRecording() const
 {
-  return (m_pvrRecordingInfoTag && m_pvrRecordingInfoTag->IsDeleted());
+  return (HasPVRRecordingInfoTag() && m_sharedTags->pvrRecordingInfoTag->IsDeleted());
 }
 
 bool CFileItem::IsInProgressPVRRecording() const
 {
-  return (m_pvrRecordingInfoTag && m_pvrRecordingInfoTag->IsInProgress());
+  return (HasPVRRecordingInfoTag() && m_sharedTags->pvrRecordingInfoTag->IsInProgress());
 }
 
 bool CFileItem::IsPVRTimer() const
@@ -1468,8 +1475,8 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
   {
     if( m_bIsFolder )
       m_mimetype = "x-directory/normal";
-    else if( m_pvrChannelInfoTag )
-      m_mimetype = m_pvrChannelInfoTag->InputFormat();
+    else if (HasPVRChannelInfoTag())
+      m_mimetype = m_sharedTags->pvrChannelInfoTag->InputFormat();
     else if( StringUtils::StartsWithNoCase(GetDynPath(), "shout://")
           || StringUtils::StartsWithNoCase(GetDynPath(), "http://")
           || StringUtils::StartsWithNoCase(GetDynPath(), "https://"))
@@ -1603,7 +1610,10 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
       m_videoInfoTag = new CVideoInfoTag;
     }
 
-    m_pvrRecordingInfoTag = item.m_pvrRecordingInfoTag;
+    if (item.HasPVRRecordingInfoTag())
+      GetSharedTags().pvrRecordingInfoTag = item.m_sharedTags->pvrRecordingInfoTag;
+    else if (m_sharedTags)
+      m_sharedTags->pvrRecordingInfoTag.reset();
 
     SetOverlayImage(ICON_OVERLAY_UNWATCHED, GetVideoInfoTag()->GetPlayCount() > 0);
     SetInvalid();
@@ -1989,6 +1999,8 @@ void CFileItemList::Clear()
   m_sortDetails.clear();
   m_replaceListing = false;
   m_content.clear();
+  m_allowPlaceholders = false;
+  m_placeholderLoader.reset();
 }
 
 void CFileItemList::ClearItems()
@@ -2095,6 +2107,8 @@ void CFileItemList::Assign(const CFileItemList& itemlist, bool append)
   m_content = itemlist.m_content;
   m_mapProperties = itemlist.m_mapProperties;
   m_cacheToDisc = itemlist.m_cacheToDisc;
+  m_allowPlaceholders = itemlist.m_allowPlaceholders;
+  m_placeholderLoader = itemlist.m_placeholderLoader;
 }
 
 bool CFileItemList::Copy(const CFileItemList& items, bool copyItems /* = true */)
@@ -2110,6 +2124,8 @@ bool CFileItemList::Copy(const CFileItemList& items, bool copyItems /* = true */
   m_sortDetails     = items.m_sortDetails;
   m_sortDescription = items.m_sortDescription;
   m_sortIgnoreFolders = items.m_sortIgnoreFolders;
+  m_allowPlaceholders = items.m_allowPlaceholders;
+  m_placeholderLoader = items.m_placeholderLoader;
 
   if (copyItems)
   {
@@ -2256,26 +2272,30 @@ void CFileItemList::Sort(SortDescription sortDescription)
   if (m_sortIgnoreFolders)
     sortDescription.sortAttributes = (SortAttribute)((int)sortDescription.sortAttributes | SortAttributeIgnoreFolders);
 
+  // extract the sort keys item by item, reusing a single SortItem
   const Fields fields = SortUtils::GetFieldsForSorting(sortDescription.sortBy);
-  SortItems sortItems((size_t)Size());
+  CSortColumns columns(sortDescription, true);
+  columns.Reserve(m_items.size());
+  SortItem sortItem;
   for (int index = 0; index < Size(); index++)
   {
-    sortItems[index] = std::shared_ptr<SortItem>(new SortItem);
-    m_items[index]->ToSortable(*sortItems[index], fields);
-    (*sortItems[index])[FieldId] = index;
+    sortItem.clear();
+    m_items[index]->ToSortable(sortItem, fields);
+    sortItem[FieldId] = index;
+    columns.Add(sortItem);
   }
 
   // do the sorting
-  SortUtils::Sort(sortDescription, sortItems);
+  const std::vector<size_t> order = columns.Sort();
 
   // apply the new order to the existing CFileItems
   VECFILEITEMS sortedFileItems;
-  sortedFileItems.reserve(Size());
-  for (SortItems::const_iterator it = sortItems.begin(); it != sortItems.end(); it++)
+  sortedFileItems.reserve(order.size());
+  for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
   {
-    CFileItemPtr item = m_items[(int)(*it)->at(FieldId).asInteger()];
+    CFileItemPtr item = m_items[*it];
     // Set the sort label in the CFileItem
-    item->SetSortLabel((*it)->at(FieldSort).asWideString());
+    item->SetSortLabel(columns.GetLabel(*it));
 
     sortedFileItems.push_back(item);
   }
@@ -2906,6 +2926,10 @@ bool CFileItemList::Save(int windowID)
   if (iSize <= 0)
     return false;
 
+  // placeholders can only be filled in by the loader of this list
+  if (m_placeholderLoader)
+    return false;
+
   CLog::Log(LOGDEBUG,"Saving fileitems [%s]", CURL::GetRedacted(GetPath()).c_str());
 
   CFile file;
@@ -3203,8 +3227,8 @@ std::string CFileItem::GetMovieName(bool bUseFolderNames /* = false */) const
   if (IsLabelPreformatted())
     return GetLabel();
 
-  if (m_pvrRecordingInfoTag)
-    return m_pvrRecordingInfoTag->m_strTitle;
+  if (HasPVRRecordingInfoTag())
+    return m_sharedTags->pvrRecordingInfoTag->m_strTitle;
   else if (CUtil::IsTVRecording(m_strPath))
   {
     std::string title = CPVRRecording::GetTitleFromURL(m_strPath);
@@ -3487,14 +3511,14 @@ void CFileItemList::ClearSortState()
 bool CFileItem::HasVideoInfoTag() const
 {
   // Note: CPVRRecording is derived from CVideoInfoTag
-  return m_pvrRecordingInfoTag.get() != nullptr || m_videoInfoTag != nullptr;
+  return HasPVRRecordingInfoTag() || m_videoInfoTag != nullptr;
 }
 
 CVideoInfoTag* CFileItem::GetVideoInfoTag()
 {
   // Note: CPVRRecording is derived from CVideoInfoTag
-  if (m_pvrRecordingInfoTag)
-    return m_pvrRecordingInfoTag.get();
+  if (HasPVRRecordingInfoTag())
+    return m_sharedTags->pvrRecordingInfoTag.get();
   else if (!m_videoInfoTag)
     m_videoInfoTag = new CVideoInfoTag;
 
@@ -3504,7 +3528,7 @@ CVideoInfoTag* CFileItem::GetVideoInfoTag()
 const CVideoInfoTag* CFileItem::GetVideoInfoTag() const
 {
   // Note: CPVRRecording is derived from CVideoInfoTag
-  return m_pvrRecordingInfoTag ? m_pvrRecordingInfoTag.get() : m_videoInfoTag;
+  return HasPVRRecordingInfoTag() ? m_sharedTags->pvrRecordingInfoTag.get() : m_videoInfoTag;
 }
 
 CPictureInfoTag* CFileItem::GetPictureInfoTag()
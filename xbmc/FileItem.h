@@ -54,6 +54,7 @@ class CURL;
 class CVariant;
 
 class CFileItemList;
+class CPlaceholderLoader;
 class CCueDocument;
 typedef std::shared_ptr<CCueDocument> CCueDocumentPtr;
 
@@ -273,47 +274,44 @@ public:
 
   inline bool HasEPGInfoTag() const
   {
-    return m_epgInfoTag.get() != NULL;
+    return m_sharedTags && m_sharedTags->epgInfoTag;
   }
 
   inline const PVR::CPVREpgInfoTagPtr GetEPGInfoTag() const
   {
-    return m_epgInfoTag;
+    return m_sharedTags ? m_sharedTags->epgInfoTag : nullptr;
   }
 
-  inline void SetEPGInfoTag(const PVR::CPVREpgInfoTagPtr& tag)
-  {
-    m_epgInfoTag = tag;
-  }
+  void SetEPGInfoTag(const PVR::CPVREpgInfoTagPtr& tag);
 
   inline bool HasPVRChannelInfoTag() const
   {
-    return m_pvrChannelInfoTag.get() != NULL;
+    return m_sharedTags && m_sharedTags->pvrChannelInfoTag;
   }
 
   inline const PVR::CPVRChannelPtr GetPVRChannelInfoTag() const
   {
-    return m_pvrChannelInfoTag;
+    return m_sharedTags ? m_sharedTags->pvrChannelInfoTag : nullptr;
   }
 
   inline bool HasPVRRecordingInfoTag() const
   {
-    return m_pvrRecordingInfoTag.get() != NULL;
+    return m_sharedTags && m_sharedTags->pvrRecordingInfoTag;
   }
 
   inline const PVR::CPVRRecordingPtr GetPVRRecordingInfoTag() const
   {
-    return m_pvrRecordingInfoTag;
+    return m_sharedTags ? m_sharedTags->pvrRecordingInfoTag : nullptr;
   }
 
   inline bool HasPVRTimerInfoTag() const
   {
-    return m_pvrTimerInfoTag != NULL;
+    return m_sharedTags && m_sharedTags->pvrTimerInfoTag;
   }
 
   inline const PVR::CPVRTimerInfoTagPtr GetPVRTimerInfoTag() const
   {
-    return m_pvrTimerInfoTag;
+    return m_sharedTags ? m_sharedTags->pvrTimerInfoTag : nullptr;
   }
 
   /*!
@@ -352,8 +350,8 @@ public:
     return m_pictureInfoTag;
   }
 
-  bool HasAddonInfo() const { return m_addonInfo != nullptr; }
-  const std::shared_ptr<const ADDON::IAddon> GetAddonInfo() const { return m_addonInfo; }
+  bool HasAddonInfo() const { return m_sharedTags && m_sharedTags->addonInfo; }
+  const std::shared_ptr<const ADDON::IAddon> GetAddonInfo() const { return m_sharedTags ? m_sharedTags->addonInfo : nullptr; }
 
   inline bool HasGameInfoTag() const
   {
@@ -486,6 +484,13 @@ public:
 
   bool IsSamePath(const CFileItem *item) const;
 
+  /*! \brief Whether this item only holds what's needed to sort, label and group it
+   The rest of its details are filled in by the CPlaceholderLoader of its list when it's shown.
+   \sa CFileItemList::SetPlaceholderLoader
+   */
+  bool IsPlaceholder() const { return m_bIsPlaceholder; }
+  void SetPlaceholder(bool placeholder) { m_bIsPlaceholder = placeholder; }
+
   bool IsAlbum() const;
 
   /*! \brief Sets details using the information from the CVideoInfoTag object
@@ -551,6 +556,25 @@ private:
    */
   void FillMusicInfoTag(const PVR::CPVRChannelPtr& channel, const PVR::CPVREpgInfoTagPtr& tag);
 
+  /*!
+   \brief The info tags of pvr, add-on and event log items. Most items, like the ones of
+   the libraries, have none of them, so they're only allocated when one is set.
+   */
+  struct SSharedTags
+  {
+    PVR::CPVREpgInfoTagPtr epgInfoTag;
+    PVR::CPVRChannelPtr pvrChannelInfoTag;
+    PVR::CPVRRecordingPtr pvrRecordingInfoTag;
+    PVR::CPVRTimerInfoTagPtr pvrTimerInfoTag;
+    std::shared_ptr<const ADDON::IAddon> addonInfo;
+    EventPtr eventLogEntry;
+  };
+
+  /*!
+   \brief Get the shared info tags of this item, allocating them if needed.
+   */
+  SSharedTags& GetSharedTags();
+
   std::string m_strPath;            ///< complete path to item
   std::string m_strDynPath;
 
@@ -558,20 +582,16 @@ private:
   bool m_bIsParentFolder;
   bool m_bCanQueue;
   bool m_bLabelPreformatted;
+  bool m_doContentLookup;
   std::string m_mimetype;
   std::string m_extrainfo;
-  bool m_doContentLookup;
   MUSIC_INFO::CMusicInfoTag* m_musicInfoTag;
   CVideoInfoTag* m_videoInfoTag;
-  PVR::CPVREpgInfoTagPtr m_epgInfoTag;
-  PVR::CPVRChannelPtr m_pvrChannelInfoTag;
-  PVR::CPVRRecordingPtr m_pvrRecordingInfoTag;
-  PVR::CPVRTimerInfoTagPtr m_pvrTimerInfoTag;
   CPictureInfoTag* m_pictureInfoTag;
-  std::shared_ptr<const ADDON::IAddon> m_addonInfo;
   KODI::GAME::CGameInfoTag* m_gameInfoTag;
-  EventPtr m_eventLogEntry;
+  std::unique_ptr<SSharedTags> m_sharedTags;
   bool m_bIsAlbum;
+  bool m_bIsPlaceholder;
 
   CCueDocumentPtr m_cueDocument;
 };
@@ -747,6 +767,20 @@ public:
   void SetContent(const std::string &content) { m_content = content; };
   const std::string &GetContent() const { return m_content; };
 
+  /*! \brief Allow the items of this list to be added as placeholders
+   Only lists that are shown in a container should allow this, as the placeholders are
+   filled in by the container as they're shown.
+   \sa CFileItem::IsPlaceholder, SetPlaceholderLoader
+   */
+  void SetAllowPlaceholders(bool allow) { m_allowPlaceholders = allow; }
+  bool AllowPlaceholders() const { return m_allowPlaceholders; }
+
+  /*! \brief Set the loader that fills in the placeholder items of this list
+   \sa CFileItem::IsPlaceholder, CPlaceholderLoader
+   */
+  void SetPlaceholderLoader(const std::shared_ptr<CPlaceholderLoader>& loader) { m_placeholderLoader = loader; }
+  const std::shared_ptr<CPlaceholderLoader>& GetPlaceholderLoader() const { return m_placeholderLoader; }
+
   void ClearSortState();
 
   VECFILEITEMS::const_iterator begin() { return m_items.cbegin(); }
@@ -781,6 +815,8 @@ private:
   CACHE_TYPE m_cacheToDisc = CACHE_IF_SLOW;
   bool m_replaceListing = false;
   std::string m_content;
+  bool m_allowPlaceholders = false;
+  std::shared_ptr<CPlaceholderLoader> m_placeholderLoader;
 
   std::vector<GUIViewSortDetails> m_sortDetails;
 
@@ -892,6 +892,22 @@ const infomap player_times[] =   {{ "seektime",         PLAYER_SEEKTIME },
 ///     @skinning_v17 **[New Infolabel]** \link Player_Process_audiobitspersample `Player.Process(audiobitspersample)`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.Process(videothreads)`</b>,
+///                  \anchor Player_Process_videothreads
+///                  _string_,
+///     @return The software decoder threading model and thread count of the currently playing item, e.g. "frame (12)".
+///     <p><hr>
+///     @skinning_v18 **[New Infolabel]** \link Player_Process_videothreads `Player.Process(videothreads)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(timetofirstframe)`</b>,
+///                  \anchor Player_Process_timetofirstframe
+///                  _string_,
+///     @return The time in milliseconds it took the currently playing item to start, from opening the file to the first frame.
+///     <p><hr>
+///     @skinning_v18 **[New Infolabel]** \link Player_Process_timetofirstframe `Player.Process(timetofirstframe)`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -909,7 +925,9 @@ const infomap player_process[] =
   { "audiodecoder", PLAYER_PROCESS_AUDIODECODER },
   { "audiochannels", PLAYER_PROCESS_AUDIOCHANNELS },
   { "audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE },
-  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE }
+  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE },
+  { "videothreads", PLAYER_PROCESS_VIDEOTHREADS },
+  { "timetofirstframe", PLAYER_PROCESS_TIMETOFIRSTFRAME }
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -9233,12 +9251,22 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
   std::pair<INFOBOOLTYPE::iterator, bool> res;
 
   if (condition.find_first_of("|+[]!") != condition.npos)
-    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_changes));
   else
-    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_changes));
 
   if (res.second)
-    res.first->get()->Initialize();
+  {
+    INFO::InfoPtr info = *res.first;
+    info->Initialize();
+
+    // conditions that don't depend on the window are shared by all windows
+    if (context != 0 && !(info->GetSources() & INFO::INFO_SOURCE_FRAME) && !info->ListItemDependent())
+    {
+      m_bools.erase(res.first);
+      return Register(expression, 0);
+    }
+  }
 
   return *(res.first);
 }
@@ -9805,8 +9833,37 @@ bool CGUIInfoManager::GetItemBool(const CGUIListItem *item, int contextWindow, i
 void CGUIInfoManager::ResetCache()
 {
   // mark our infobools as dirty
-  CSingleLock lock(m_critInfo);
-  ++m_refreshCounter;
+  PublishChange(INFO::INFO_SOURCE_ALL);
+}
+
+void CGUIInfoManager::PublishChange(unsigned int sources)
+{
+  m_changes.Set(sources);
+}
+
+unsigned int CGUIInfoManager::GetInfoSources(int condition) const
+{
+  int info = std::abs(condition);
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+    info = m_multiInfo[info - MULTI_INFO_START].m_info;
+
+  switch (info)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+      return INFO::INFO_SOURCE_NONE;
+    case SKIN_BOOL:
+    case SKIN_STRING:
+    case SKIN_STRING_IS_EQUAL:
+      return INFO::INFO_SOURCE_SKIN;
+    case PLAYER_HAS_MEDIA:
+    case PLAYER_HAS_AUDIO:
+    case PLAYER_HAS_VIDEO:
+    case PLAYER_HAS_GAME:
+      return INFO::INFO_SOURCE_PLAYER;
+    default:
+      return INFO::INFO_SOURCE_FRAME;
+  }
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
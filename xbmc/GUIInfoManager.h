@@ -60,8 +60,22 @@ public:
   void Initialize();
 
   void Clear();
+
+  /*! \brief Mark all info bools as dirty, e.g. when a window is initialized
+   */
   void ResetCache();
 
+  /*! \brief Publish a change of some info sources, marking the info bools depending on them as dirty
+   \param sources the INFO::InfoSource flags of the sources that changed
+   */
+  void PublishChange(unsigned int sources);
+
+  /*! \brief Get the info sources a condition depends on
+   \param condition the condition as returned by TranslateSingleString
+   \return the INFO::InfoSource flags
+   */
+  unsigned int GetInfoSources(int condition) const;
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -201,7 +215,7 @@ private:
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter = 0;
+  INFO::InfoChanges m_changes;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -8,21 +8,35 @@
 
 #include "threads/SystemClock.h"
 #include "GUILargeTextureManager.h"
+#include "guilib/GUIFrameStats.h"
 #include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/TimeUtils.h"
 #include "utils/JobManager.h"
 #include "windowing/GraphicContext.h"
 #include "utils/log.h"
+#include "ServiceBroker.h"
 #include "TextureCache.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
-CImageLoader::CImageLoader(const std::string &path, const bool useCache):
+namespace
+{
+// images are loaded at sizes rounded up to this, so that controls of about the same size share them
+const unsigned int LOAD_SIZE_STEP = 128;
+}
+
+CImageLoader::CImageLoader(const std::string &path, const bool useCache, unsigned int width, unsigned int height):
   m_path(path)
 {
   m_texture = NULL;
   m_use_cache = useCache;
+  m_width = width;
+  m_height = height;
 }
 
 CImageLoader::~CImageLoader()
@@ -46,9 +60,11 @@ bool CImageLoader::DoWork()
 
   if (!loadPath.empty())
   {
-    // direct route - load the image
+    // direct route - load the image, scaled down to the size it's shown at
     unsigned int start = XbmcThreads::SystemClockMillis();
-    m_texture = CBaseTexture::LoadFromFile(loadPath, CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(), CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
+    unsigned int width = m_width ? m_width : CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth();
+    unsigned int height = m_height ? m_height : CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight();
+    m_texture = CBaseTexture::LoadFromFile(loadPath, width, height, false, "", true);
 
     if (XbmcThreads::SystemClockMillis() - start > 100)
       CLog::Log(LOGDEBUG, "%s - took %u ms to load %s", __FUNCTION__, XbmcThreads::SystemClockMillis() - start, loadPath.c_str());
@@ -73,16 +89,21 @@ bool CImageLoader::DoWork()
   return (m_texture != NULL);
 }
 
-CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path):
+CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path, unsigned int width, unsigned int height):
   m_path(path)
 {
   m_refCount = 1;
+  m_width = width;
+  m_height = height;
   m_timeToDelete = 0;
+  m_distance = 0.0f;
+  m_distanceTime = CTimeUtils::GetFrameTime();
 }
 
 CGUILargeTextureManager::CLargeTexture::~CLargeTexture()
 {
   assert(m_refCount == 0);
+  CGUITextureBudget::GetInstance().Freed(CGUITextureBudget::CATEGORY_LARGE, GetSize());
   m_texture.Free();
 }
 
@@ -120,12 +141,59 @@ void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
 {
   assert(!m_texture.size());
   if (texture)
+  {
     m_texture.Set(texture, texture->GetWidth(), texture->GetHeight());
+    CGUITextureBudget::GetInstance().Allocated(CGUITextureBudget::CATEGORY_LARGE, GetSize());
+  }
+}
+
+void CGUILargeTextureManager::CLargeTexture::SetDistance(float distance)
+{
+  // the closest of the controls requesting the image in this frame counts
+  unsigned int now = CTimeUtils::GetFrameTime();
+  if (m_distanceTime != now || distance < m_distance)
+    m_distance = distance;
+  m_distanceTime = now;
+}
+
+float CGUILargeTextureManager::CLargeTexture::GetDistance() const
+{
+  if (CTimeUtils::GetFrameTime() - m_distanceTime > DISTANCE_TIMEOUT)
+    return std::numeric_limits<float>::max();
+  return m_distance;
+}
+
+unsigned int CGUILargeTextureManager::CLargeTexture::GetSize() const
+{
+  unsigned int size = 0;
+  for (const auto texture : m_texture.m_textures)
+    size += texture->GetPitch() * texture->GetRows();
+  return size;
+}
+
+unsigned int CGUILargeTextureManager::CLargeTexture::GetLastDrawFrame() const
+{
+  unsigned int lastDrawFrame = 0;
+  for (const auto texture : m_texture.m_textures)
+    lastDrawFrame = std::max(lastDrawFrame, texture->GetLastDrawFrame());
+  return lastDrawFrame;
+}
+
+void CGUILargeTextureManager::CLargeTexture::Upload()
+{
+  for (auto texture : m_texture.m_textures)
+    texture->LoadToGPU();
 }
 
-CGUILargeTextureManager::CGUILargeTextureManager() = default;
+CGUILargeTextureManager::CGUILargeTextureManager()
+{
+  CGUITextureBudget::GetInstance().RegisterOwner(CGUITextureBudget::CATEGORY_LARGE, this);
+}
 
-CGUILargeTextureManager::~CGUILargeTextureManager() = default;
+CGUILargeTextureManager::~CGUILargeTextureManager()
+{
+  CGUITextureBudget::GetInstance().UnregisterOwner(this);
+}
 
 void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
 {
@@ -142,15 +210,43 @@ void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
   }
 }
 
+void CGUILargeTextureManager::GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates)
+{
+  CSingleLock lock(m_listSection);
+  for (const auto image : m_allocated)
+  {
+    if (image->IsUnused())
+      candidates.push_back({ image, image->GetLastDrawFrame(), image->GetSize() });
+  }
+}
+
+bool CGUILargeTextureManager::Evict(const void *id)
+{
+  CSingleLock lock(m_listSection);
+  for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image == id && image->DeleteIfRequired(true))
+    {
+      m_allocated.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
 // if available, increment reference count, and return the image.
 // else, add to the queue list if appropriate.
-bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache)
+bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache,
+                                       unsigned int width, unsigned int height, float distance)
 {
+  GetLoadSize(width, height);
+
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, width, height))
     {
       if (firstRequest)
         image->AddRef();
@@ -158,63 +254,138 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
       return texture.size() > 0;
     }
   }
+  // loaded or being loaded, but not uploaded as yet
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->Matches(path, width, height))
+    {
+      if (firstRequest)
+        image->AddRef();
+      image->SetDistance(distance);
+      return true;
+    }
+  }
+  for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+  {
+    CLargeTexture *image = it->second;
+    if (image->Matches(path, width, height))
+    {
+      if (firstRequest)
+        image->AddRef();
+      image->SetDistance(distance);
+      return true;
+    }
+  }
 
   if (firstRequest)
-    QueueImage(path, useCache);
+    QueueImage(path, useCache, width, height, distance);
 
   return true;
 }
 
-void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately)
+void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately, unsigned int width, unsigned int height)
 {
+  GetLoadSize(width, height);
+
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, width, height))
     {
       if (image->DecrRef(immediately) && immediately)
         m_allocated.erase(it);
       return;
     }
   }
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->Matches(path, width, height))
+    {
+      // not uploaded as yet, so there's no point in keeping it around
+      if (image->DecrRef(true))
+        m_decoded.erase(it);
+      return;
+    }
+  }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     unsigned int id = it->first;
     CLargeTexture *image = it->second;
-    if (image->GetPath() == path && image->DecrRef(true))
+    if (image->Matches(path, width, height))
     {
-      // cancel this job
-      CJobManager::GetInstance().CancelJob(id);
-      m_queued.erase(it);
+      if (image->DecrRef(true))
+      {
+        // cancel this job
+        CJobManager::GetInstance().CancelJob(id);
+        m_queued.erase(it);
+      }
       return;
     }
   }
 }
 
-// queue the image, and start the background loader if necessary
-void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
+void CGUILargeTextureManager::UploadTextures()
 {
-  if (path.empty())
-    return;
+  const unsigned int budget = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureUploadBudget * 1024;
 
   CSingleLock lock(m_listSection);
-  for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+  if (m_decoded.empty())
+    return;
+
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_UPLOAD);
+
+  // those closest to the screen first
+  std::stable_sort(m_decoded.begin(), m_decoded.end(), [](const CLargeTexture *a, const CLargeTexture *b)
   {
-    CLargeTexture *image = it->second;
-    if (image->GetPath() == path)
-    {
-      image->AddRef();
-      return; // already queued
-    }
+    return a->GetDistance() < b->GetDistance();
+  });
+
+  unsigned int uploaded = 0;
+  listIterator it = m_decoded.begin();
+  while (it != m_decoded.end())
+  {
+    CLargeTexture *image = *it;
+    unsigned int size = image->GetSize();
+    if (budget && uploaded && uploaded + size > budget)
+      break;
+
+    image->Upload();
+    uploaded += size;
+    m_allocated.push_back(image);
+    it = m_decoded.erase(it);
   }
+}
 
-  // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
+// queue the image, and start the background loader
+void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache, unsigned int width, unsigned int height, float distance)
+{
+  if (path.empty())
+    return;
+
+  CSingleLock lock(m_listSection);
+
+  // queue the item, images outside of the screen wait for those that are shown
+  CLargeTexture *image = new CLargeTexture(path, width, height);
+  image->SetDistance(distance);
+  CJob::PRIORITY priority = distance > 0.0f ? CJob::PRIORITY_LOW : CJob::PRIORITY_NORMAL;
+  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache, width, height), this, priority);
   m_queued.push_back(std::make_pair(jobID, image));
 }
 
+void CGUILargeTextureManager::GetLoadSize(unsigned int &width, unsigned int &height)
+{
+  if (!width || !height)
+  {
+    width = height = 0;
+    return;
+  }
+  width = (width + LOAD_SIZE_STEP - 1) / LOAD_SIZE_STEP * LOAD_SIZE_STEP;
+  height = (height + LOAD_SIZE_STEP - 1) / LOAD_SIZE_STEP * LOAD_SIZE_STEP;
+}
+
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   // see if we still have this job id
@@ -228,7 +399,11 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
-      m_allocated.push_back(image);
+      // failed images have nothing to upload
+      if (image->GetTexture().size())
+        m_decoded.push_back(image);
+      else
+        m_allocated.push_back(image);
       return;
     }
   }
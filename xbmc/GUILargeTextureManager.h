@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "guilib/GUITextureBudget.h"
 #include "guilib/TextureManager.h"
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
@@ -26,7 +27,7 @@
 class CImageLoader : public CJob
 {
 public:
-  CImageLoader(const std::string &path, const bool useCache);
+  CImageLoader(const std::string &path, const bool useCache, unsigned int width = 0, unsigned int height = 0);
   ~CImageLoader() override;
 
   /*!
@@ -36,6 +37,8 @@ public:
 
   bool          m_use_cache; ///< Whether or not to use any caching with this image
   std::string    m_path; ///< path of image to load
+  unsigned int  m_width; ///< width the image is shown at, 0 for the screen width
+  unsigned int  m_height; ///< height the image is shown at, 0 for the screen height
   CBaseTexture *m_texture; ///< Texture object to load the image into \sa CBaseTexture.
 };
 
@@ -46,9 +49,13 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Images are decoded on worker threads, scaled down to the size they are shown at. The
+ decoded textures are uploaded to the GPU by UploadTextures() on the render thread, a
+ limited amount each frame, those closest to the screen first.
+
  \sa IJobCallback, CGUITexture
  */
-class CGUILargeTextureManager : public IJobCallback
+class CGUILargeTextureManager : public IJobCallback, public CGUITextureBudget::IOwner
 {
 public:
   CGUILargeTextureManager();
@@ -74,10 +81,15 @@ public:
    \param texture texture object to hold the resulting texture
    \param orientation orientation of resulting texture
    \param firstRequest true if this is the first time we are requesting this texture
+   \param width the width in pixels the image is shown at, 0 for the screen width.
+   \param height the height in pixels the image is shown at, 0 for the screen height.
+   \param distance how far in pixels the image is outside of the screen, images closer to
+                   the screen are uploaded first.
    \return true if the image exists, else false.
    \sa CGUITextureArray and CGUITexture
    */
-  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true);
+  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true,
+                unsigned int width = 0, unsigned int height = 0, float distance = 0.0f);
 
   /*!
    \brief Request a texture to be unloaded.
@@ -89,8 +101,18 @@ public:
    \param path path of the image to release.
    \param immediately if set true the image is immediately unloaded once its reference count reaches zero
                       rather than being unloaded after a delay.
+   \param width the width the image was requested at with GetImage().
+   \param height the height the image was requested at with GetImage().
    */
-  void ReleaseImage(const std::string &path, bool immediately = false);
+  void ReleaseImage(const std::string &path, bool immediately = false, unsigned int width = 0, unsigned int height = 0);
+
+  /*!
+   \brief Upload decoded images to the GPU, called on the render thread once per frame.
+
+   Images are uploaded until the upload budget of the frame is used up, see
+   CAdvancedSettings::m_guiTextureUploadBudget. At least one image is uploaded each frame.
+   */
+  void UploadTextures();
 
   /*!
    \brief Cleanup images that are no longer in use.
@@ -103,33 +125,55 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  // implementation of CGUITextureBudget::IOwner, images no longer in use may be evicted
+  void GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates) override;
+  bool Evict(const void *id) override;
+
 private:
   class CLargeTexture
   {
   public:
-    explicit CLargeTexture(const std::string &path);
+    CLargeTexture(const std::string &path, unsigned int width, unsigned int height);
     virtual ~CLargeTexture();
 
     void AddRef();
     bool DecrRef(bool deleteImmediately);
     bool DeleteIfRequired(bool deleteImmediately = false);
     void SetTexture(CBaseTexture* texture);
-
+    void SetDistance(float distance);
+    float GetDistance() const;
+    unsigned int GetSize() const;
+    unsigned int GetLastDrawFrame() const;
+    bool IsUnused() const { return m_refCount == 0; };
+    void Upload();
+
+    bool Matches(const std::string &path, unsigned int width, unsigned int height) const
+    {
+      return m_width == width && m_height == height && m_path == path;
+    }
     const std::string &GetPath() const { return m_path; };
     const CTextureArray &GetTexture() const { return m_texture; };
 
   private:
     static const unsigned int TIME_TO_DELETE = 2000;
+    //! images that were not requested for this long are uploaded last
+    static const unsigned int DISTANCE_TIMEOUT = 500;
 
     unsigned int m_refCount;
     std::string m_path;
+    unsigned int m_width;
+    unsigned int m_height;
     CTextureArray m_texture;
     unsigned int m_timeToDelete;
+    float m_distance;
+    unsigned int m_distanceTime;
   };
 
-  void QueueImage(const std::string &path, bool useCache = true);
+  void QueueImage(const std::string &path, bool useCache, unsigned int width, unsigned int height, float distance);
+  static void GetLoadSize(unsigned int &width, unsigned int &height);
 
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CLargeTexture *> m_decoded; ///< loaded images waiting to be uploaded
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PlaceholderLoader.h"
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <set>
+
+namespace
+{
+// number of items keeping their details, a few pages of the largest views
+const size_t MAX_FILLED_ITEMS = 500;
+
+template<typename F>
+void ForEachItem(const std::vector<CGUIListItemPtr>& items, int first, int last, F f)
+{
+  const int size = static_cast<int>(items.size());
+  if (first <= last)
+  {
+    for (int i = std::max(first, 0); i <= last && i < size; ++i)
+      f(items[i]);
+  }
+  else
+  { // wrapping
+    for (int i = std::max(first, 0); i < size; ++i)
+      f(items[i]);
+    for (int i = 0; i <= last && i < size; ++i)
+      f(items[i]);
+  }
+}
+}
+
+void CPlaceholderLoader::Load(const std::vector<CGUIListItemPtr>& items, int first, int last)
+{
+  std::set<const CFileItem*> locked;
+  {
+    CSingleLock lock(m_section);
+    if (m_loading)
+      return;
+
+    std::vector<std::pair<CFileItemPtr, CFileItemPtr>> loaded;
+    loaded.swap(m_loaded);
+    for (const auto& it : loaded)
+    {
+      CFileItem& item = *it.first;
+      if (!item.IsPlaceholder())
+        continue;
+
+      // items read by another thread are filled in on a later call
+      if (m_lockedItems.find(&item) != m_lockedItems.end())
+      {
+        m_loaded.push_back(it);
+        locked.insert(&item);
+        continue;
+      }
+
+      // placeholders that couldn't be loaded aren't tried again
+      item.SetPlaceholder(false);
+      if (it.second)
+      {
+        FillItem(item, *it.second);
+        item.SetInvalid();
+        m_filledItems.push_back(it.first);
+      }
+    }
+
+    UnloadItems(items, first, last);
+  }
+
+  std::vector<CFileItemPtr> placeholders;
+  ForEachItem(items, first, last, [&placeholders, &locked](const CGUIListItemPtr& item)
+  {
+    if (item->IsFileItem())
+    {
+      CFileItemPtr fileItem = std::static_pointer_cast<CFileItem>(item);
+      if (fileItem->IsPlaceholder() && locked.find(fileItem.get()) == locked.end())
+        placeholders.push_back(fileItem);
+    }
+  });
+  if (placeholders.empty())
+    return;
+
+  {
+    CSingleLock lock(m_section);
+    m_loading = true;
+  }
+
+  std::shared_ptr<CPlaceholderLoader> loader = shared_from_this();
+  const unsigned int jobId = CJobManager::GetInstance().Submit([loader, placeholders]()
+  {
+    std::vector<CFileItemPtr> loaded;
+    if (!loader->LoadItems(placeholders, loaded))
+      loaded.clear();
+    loaded.resize(placeholders.size());
+
+    CSingleLock lock(loader->m_section);
+    for (size_t i = 0; i < placeholders.size(); ++i)
+      loader->m_loaded.emplace_back(placeholders[i], loaded[i]);
+    loader->m_loading = false;
+  }, CJob::PRIORITY_HIGH);
+
+  // tried again on the next call
+  if (!jobId)
+  {
+    CSingleLock lock(m_section);
+    m_loading = false;
+  }
+}
+
+CPlaceholderLoader::CItemLock::CItemLock(const std::shared_ptr<CPlaceholderLoader>& loader, const CFileItem* item)
+  : m_loader(loader),
+    m_item(item)
+{
+  if (m_loader)
+  {
+    CSingleLock lock(m_loader->m_section);
+    m_loader->m_lockedItems.insert(m_item);
+  }
+}
+
+CPlaceholderLoader::CItemLock::~CItemLock()
+{
+  if (m_loader)
+  {
+    CSingleLock lock(m_loader->m_section);
+    m_loader->m_lockedItems.erase(m_loader->m_lockedItems.find(m_item));
+  }
+}
+
+void CPlaceholderLoader::UnloadItems(const std::vector<CGUIListItemPtr>& items, int first, int last)
+{
+  if (m_filledItems.size() <= MAX_FILLED_ITEMS)
+    return;
+
+  std::set<const CGUIListItem*> shown;
+  ForEachItem(items, first, last, [&shown](const CGUIListItemPtr& item)
+  {
+    shown.insert(item.get());
+  });
+
+  for (size_t count = m_filledItems.size() - MAX_FILLED_ITEMS; count > 0; --count)
+  {
+    CFileItemPtr item = m_filledItems.front().lock();
+    m_filledItems.pop_front();
+    if (!item || item->IsPlaceholder())
+      continue;
+
+    if (shown.find(item.get()) != shown.end() ||
+        m_lockedItems.find(item.get()) != m_lockedItems.end())
+    {
+      m_filledItems.push_back(item);
+      continue;
+    }
+
+    UnloadItem(*item);
+    item->SetPlaceholder(true);
+    item->SetInvalid();
+  }
+}
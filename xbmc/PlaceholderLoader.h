@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+class CFileItem; typedef std::shared_ptr<CFileItem> CFileItemPtr;
+class CGUIListItem; typedef std::shared_ptr<CGUIListItem> CGUIListItemPtr;
+
+/*!
+ \brief Fills in the placeholder items of a list while they're shown.
+
+ Large lists may be filled with placeholders that only hold what's needed to sort,
+ label and group them (see CFileItem::IsPlaceholder). A container showing such a list
+ calls Load() with the items around the visible ones, which loads their details in the
+ background and fills them in on a later call. Only the most recently filled in items
+ keep their details, the others become placeholders again.
+
+ Other threads reading the details of the items, like a CBackgroundInfoLoader, hold
+ a CItemLock on the item they read, which keeps it from being filled in or unloaded.
+ */
+class CPlaceholderLoader : public std::enable_shared_from_this<CPlaceholderLoader>
+{
+public:
+  CPlaceholderLoader() = default;
+  virtual ~CPlaceholderLoader() = default;
+
+  /*!
+   \brief Fill in the items that finished loading and start loading the placeholders
+   in the given range. Must be called from the thread owning the items, usually the GUI thread.
+   \param items the items of the list.
+   \param first the first item to load.
+   \param last the last item to load. May be before first for wrapping lists.
+   */
+  void Load(const std::vector<CGUIListItemPtr>& items, int first, int last);
+
+  /*!
+   \brief Keeps the details of an item from being filled in or dropped while it exists.
+   */
+  class CItemLock
+  {
+  public:
+    /*!
+     \param loader the loader of the list of the item, may be empty.
+     \param item the item to lock.
+     */
+    CItemLock(const std::shared_ptr<CPlaceholderLoader>& loader, const CFileItem* item);
+    ~CItemLock();
+
+  private:
+    CItemLock(const CItemLock&) = delete;
+    CItemLock& operator=(const CItemLock&) = delete;
+
+    std::shared_ptr<CPlaceholderLoader> m_loader;
+    const CFileItem* m_item;
+  };
+
+protected:
+  /*!
+   \brief Load the details of the given placeholders. Called from a job.
+   \param placeholders the items to load. They must not be changed.
+   \param loaded [out] the loaded items, in the same order as the placeholders.
+   Empty for placeholders that couldn't be loaded.
+   \return true if the items were loaded, false otherwise.
+   */
+  virtual bool LoadItems(const std::vector<CFileItemPtr>& placeholders, std::vector<CFileItemPtr>& loaded) = 0;
+
+  /*!
+   \brief Fill in a placeholder with the loaded details.
+   \param item the placeholder.
+   \param loaded the item loaded for it by LoadItems().
+   */
+  virtual void FillItem(CFileItem& item, const CFileItem& loaded) = 0;
+
+  /*!
+   \brief Drop the details of an item that were filled in by FillItem().
+   \param item the item to turn into a placeholder again.
+   */
+  virtual void UnloadItem(CFileItem& item) = 0;
+
+private:
+  void UnloadItems(const std::vector<CGUIListItemPtr>& items, int first, int last);
+
+  CCriticalSection m_section;
+  bool m_loading = false;
+  std::vector<std::pair<CFileItemPtr, CFileItemPtr>> m_loaded; //!< placeholders with their loaded items
+  std::deque<std::weak_ptr<CFileItem>> m_filledItems;          //!< filled in items, oldest first
+  std::multiset<const CFileItem*> m_lockedItems;               //!< items read by other threads
+};
@@ -200,6 +200,16 @@ CDatabaseManager& CServiceBroker::GetDatabaseManager()
   return g_application.m_ServiceManager->GetDatabaseManager();
 }
 
+XFILE::CDirectoryManifest& CServiceBroker::GetMusicScanManifest()
+{
+  return g_application.m_ServiceManager->GetMusicScanManifest();
+}
+
+XFILE::CDirectoryManifest& CServiceBroker::GetVideoScanManifest()
+{
+  return g_application.m_ServiceManager->GetVideoScanManifest();
+}
+
 CEventLog& CServiceBroker::GetEventLog()
 {
   return m_pSettingsComponent->GetProfileManager()->GetEventLog();
@@ -24,6 +24,11 @@ namespace ANNOUNCEMENT
   class CAnnouncementManager;
 }
 
+namespace XFILE
+{
+  class CDirectoryManifest;
+}
+
 namespace PVR
 {
   class CPVRManager;
@@ -105,6 +110,8 @@ public:
   static CWeatherManager& GetWeatherManager();
   static CPlayerCoreFactory &GetPlayerCoreFactory();
   static CDatabaseManager &GetDatabaseManager();
+  static XFILE::CDirectoryManifest &GetMusicScanManifest();
+  static XFILE::CDirectoryManifest &GetVideoScanManifest();
   static CEventLog &GetEventLog();
 
   static CGUIComponent* GetGUI();
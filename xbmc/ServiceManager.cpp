@@ -16,6 +16,7 @@
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "cores/RetroPlayer/guibridge/GUIGameRenderManager.h"
 #include "favourites/FavouritesService.h"
+#include "filesystem/DirectoryManifest.h"
 #include "games/controllers/ControllerManager.h"
 #include "games/GameServices.h"
 #include "peripherals/Peripherals.h"
@@ -28,6 +29,7 @@
 #include "pvr/PVRManager.h"
 #include "network/Network.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/TraceRecorder.h"
 #include "powermanagement/PowerManager.h"
 #include "weather/WeatherManager.h"
 #include "DatabaseManager.h"
@@ -87,6 +89,8 @@ void CServiceManager::DeinitTesting()
 
 bool CServiceManager::InitStageOne()
 {
+  KODI_TRACE_SCOPE("CServiceManager::InitStageOne");
+
 #ifdef HAS_PYTHON
   m_XBPython.reset(new XBPython());
   CScriptInvocationManager::GetInstance().RegisterLanguageInvocationHandler(m_XBPython.get(), ".py");
@@ -102,6 +106,8 @@ bool CServiceManager::InitStageOne()
 
 bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::string& profilesUserDataFolder)
 {
+  KODI_TRACE_SCOPE("CServiceManager::InitStageTwo");
+
   // Initialize the addon database (must be before the addon manager is init'd)
   m_databaseManager.reset(new CDatabaseManager);
 
@@ -158,6 +164,9 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
 
   m_weatherManager.reset(new CWeatherManager());
 
+  m_musicScanManifest.reset(new XFILE::CDirectoryManifest("special://database/MusicScanManifest.txt"));
+  m_videoScanManifest.reset(new XFILE::CDirectoryManifest("special://database/VideoScanManifest.txt"));
+
   init_level = 2;
   return true;
 }
@@ -165,6 +174,8 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
 // stage 3 is called after successful initialization of WindowManager
 bool CServiceManager::InitStageThree(const std::shared_ptr<CProfileManager>& profileManager)
 {
+  KODI_TRACE_SCOPE("CServiceManager::InitStageThree");
+
   // Peripherals depends on strings being loaded before stage 3
   m_peripherals->Initialise();
 
@@ -197,6 +208,8 @@ void CServiceManager::DeinitStageTwo()
 {
   init_level = 1;
 
+  m_videoScanManifest.reset();
+  m_musicScanManifest.reset();
   m_weatherManager.reset();
   m_powerManager.reset();
   m_fileExtensionProvider.reset();
@@ -367,3 +380,13 @@ CDatabaseManager &CServiceManager::GetDatabaseManager()
 {
   return *m_databaseManager;
 }
+
+XFILE::CDirectoryManifest &CServiceManager::GetMusicScanManifest()
+{
+  return *m_musicScanManifest;
+}
+
+XFILE::CDirectoryManifest &CServiceManager::GetVideoScanManifest()
+{
+  return *m_videoScanManifest;
+}
@@ -23,6 +23,11 @@ namespace ADDON
   class CRepositoryUpdater;
 }
 
+namespace XFILE
+{
+  class CDirectoryManifest;
+}
+
 namespace PVR
 {
   class CPVRManager;
@@ -121,6 +126,13 @@ public:
 
   CDatabaseManager &GetDatabaseManager();
 
+  /**\brief Get the directory manifests of the music and the video library scans.
+   * They outlive single scans, the change journals watching the scanned directories
+   * run until the service manager is deinitialized.
+   */
+  XFILE::CDirectoryManifest &GetMusicScanManifest();
+  XFILE::CDirectoryManifest &GetVideoScanManifest();
+
 protected:
   struct delete_dataCacheCore
   {
@@ -163,4 +175,6 @@ protected:
   std::unique_ptr<CWeatherManager> m_weatherManager;
   std::unique_ptr<CPlayerCoreFactory> m_playerCoreFactory;
   std::unique_ptr<CDatabaseManager> m_databaseManager;
+  std::unique_ptr<XFILE::CDirectoryManifest> m_musicScanManifest;
+  std::unique_ptr<XFILE::CDirectoryManifest> m_videoScanManifest;
 };
@@ -11,6 +11,7 @@
 #include "PlayListPlayer.h"
 #include "XBApplicationEx.h"
 #include "utils/log.h"
+#include "utils/TraceRecorder.h"
 #include "threads/SystemClock.h"
 #include "commons/Exception.h"
 #ifdef TARGET_POSIX
@@ -45,6 +46,7 @@ int CXBApplicationEx::Run(const CAppParamParser &params)
   unsigned int lastFrameTime = 0;
   unsigned int frameTime = 0;
   const unsigned int noRenderFrameTime = 15;  // Simulates ~66fps
+  bool startupTraced = false;
 
   if (params.GetPlaylist().Size() > 0)
   {
@@ -60,26 +62,46 @@ int CXBApplicationEx::Run(const CAppParamParser &params)
     // Animate and render a frame
     //-----------------------------------------
 
-    lastFrameTime = XbmcThreads::SystemClockMillis();
-    Process();
-
-    if (!m_bStop)
     {
-      FrameMove(true, m_renderGUI);
-    }
+      KODI_TRACE_SCOPE("Frame");
 
-    if (m_renderGUI && !m_bStop)
-    {
-      Render();
+      lastFrameTime = XbmcThreads::SystemClockMillis();
+      {
+        KODI_TRACE_SCOPE("Process");
+        Process();
+      }
+
+      if (!m_bStop)
+      {
+        KODI_TRACE_SCOPE("FrameMove");
+        FrameMove(true, m_renderGUI);
+      }
+
+      if (m_renderGUI && !m_bStop)
+      {
+        KODI_TRACE_SCOPE("Render");
+        Render();
+      }
+      else if (!m_renderGUI)
+      {
+        frameTime = XbmcThreads::SystemClockMillis() - lastFrameTime;
+        if(frameTime < noRenderFrameTime)
+          Sleep(noRenderFrameTime - frameTime);
+      }
     }
-    else if (!m_renderGUI)
+
+    // everything up to the first frame, once its scope is closed
+    if (!startupTraced && CTraceRecorder::IsEnabled())
     {
-      frameTime = XbmcThreads::SystemClockMillis() - lastFrameTime;
-      if(frameTime < noRenderFrameTime)
-        Sleep(noRenderFrameTime - frameTime);
+      CTraceRecorder::Save("special://temp/kodi-startup-trace.json");
+      startupTraced = true;
     }
-
   }
+
+  // the latest frames, up to the shutdown
+  if (CTraceRecorder::IsEnabled())
+    CTraceRecorder::Save("special://temp/kodi-trace.json");
+
   Destroy();
 
   CLog::Log(LOGNOTICE, "XBApplicationEx: application stopped!" );
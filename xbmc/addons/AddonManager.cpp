@@ -17,6 +17,7 @@
 #include "filesystem/SpecialProtocol.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/XMLUtils.h"
 
@@ -312,6 +313,8 @@ void CAddonMgr::UnregisterAddonMgrCallback(TYPE type)
 
 bool CAddonMgr::Init()
 {
+  KODI_TRACE_SCOPE("CAddonMgr::Init");
+
   CSingleLock lock(m_critSection);
 
   cp_set_fatal_error_handler(cp_fatalErrorHandler);
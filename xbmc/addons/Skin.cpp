@@ -31,6 +31,8 @@
 #include "utils/XMLUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+
 #define XML_SETTINGS      "settings"
 #define XML_SETTING       "setting"
 #define XML_ATTR_TYPE     "type"
@@ -310,6 +312,13 @@ void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool
   m_includes.Resolve(node, xmlIncludeConditions);
 }
 
+void CSkinInfo::LoadIncludeFile(const std::string &file)
+{
+  const std::vector<std::string> &files = m_includes.GetFiles();
+  if (std::find(files.begin(), files.end(), file) == files.end())
+    m_includes.Load(file);
+}
+
 int CSkinInfo::GetStartWindow() const
 {
   int windowID = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_LOOKANDFEEL_STARTUPWINDOW);
@@ -151,6 +151,21 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Get the include files loaded so far
+   \return the paths of the include files
+   */
+  const std::vector<std::string>& GetIncludeFiles() const { return m_includes.GetFiles(); }
+
+  /*! \brief Get the modification times of the include files when they were read
+   \return the times, in the order of GetIncludeFiles()
+   */
+  const std::vector<int64_t>& GetIncludeFileTimes() const { return m_includes.GetFileTimes(); }
+
+  /*! \brief Load the includes of the given file, if it's not loaded yet
+   \param file the path of the include file
+   */
+  void LoadIncludeFile(const std::string &file);
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
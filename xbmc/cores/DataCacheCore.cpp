@@ -33,6 +33,7 @@ void CDataCacheCore::Reset()
   m_stateInfo.m_stateSeeking = false;
   m_stateInfo.m_renderGuiLayer = false;
   m_stateInfo.m_renderVideoLayer = false;
+  m_stateInfo.m_timeToFirstFrame = 0;
   m_playerStateChanged = false;
 }
 
@@ -80,6 +81,28 @@ bool CDataCacheCore::IsVideoHwDecoder()
   return m_playerVideoInfo.isHwDecoder;
 }
 
+void CDataCacheCore::SetVideoDecoderThreading(std::string type, int threads)
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  m_playerVideoInfo.decoderThreadType = type;
+  m_playerVideoInfo.decoderThreads = threads;
+}
+
+std::string CDataCacheCore::GetVideoDecoderThreadType()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreadType;
+}
+
+int CDataCacheCore::GetVideoDecoderThreads()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreads;
+}
+
 
 void CDataCacheCore::SetVideoDeintMethod(std::string method)
 {
@@ -336,6 +359,20 @@ bool CDataCacheCore::GetVideoRender()
   return m_stateInfo.m_renderVideoLayer;
 }
 
+void CDataCacheCore::SetTimeToFirstFrame(int ms)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_stateInfo.m_timeToFirstFrame = ms;
+}
+
+int CDataCacheCore::GetTimeToFirstFrame()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_stateInfo.m_timeToFirstFrame;
+}
+
 void CDataCacheCore::SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max)
 {
   CSingleLock lock(m_stateSection);
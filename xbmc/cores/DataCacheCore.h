@@ -27,6 +27,9 @@ public:
   void SetVideoDecoderName(std::string name, bool isHw);
   std::string GetVideoDecoderName();
   bool IsVideoHwDecoder();
+  void SetVideoDecoderThreading(std::string type, int threads);
+  std::string GetVideoDecoderThreadType();
+  int GetVideoDecoderThreads();
   void SetVideoDeintMethod(std::string method);
   std::string GetVideoDeintMethod();
   void SetVideoPixelFormat(std::string pixFormat);
@@ -68,6 +71,15 @@ public:
   bool GetGuiRender();
   void SetVideoRender(bool video);
   bool GetVideoRender();
+
+  /*!
+   * \brief Time in ms from opening the file to audio and video being in sync
+   *
+   * Zero while playback is still starting up.
+   */
+  void SetTimeToFirstFrame(int ms);
+  int GetTimeToFirstFrame();
+
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   void GetPlayTimes(time_t &start, int64_t &current, int64_t &min, int64_t &max);
 
@@ -120,6 +132,8 @@ protected:
   {
     std::string decoderName;
     bool isHwDecoder;
+    std::string decoderThreadType;
+    int decoderThreads;
     std::string deintMethod;
     std::string pixFormat;
     std::string stereoMode;
@@ -154,6 +168,7 @@ protected:
     float m_tempo;
     float m_speed;
     bool m_frameAdvance;
+    int m_timeToFirstFrame;
   } m_stateInfo;
 
   struct STimeInfo
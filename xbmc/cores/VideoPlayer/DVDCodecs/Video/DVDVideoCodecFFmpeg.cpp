@@ -8,12 +8,12 @@
 
 #include "system.h"
 #include "DVDVideoCodecFFmpeg.h"
+#include "DVDVideoCodecThreading.h"
 #include "DVDStreamInfo.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "DVDCodecs/DVDCodecs.h"
 #include "DVDCodecs/DVDFactoryCodec.h"
 #include "ServiceBroker.h"
-#include "utils/CPUInfo.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -364,16 +364,36 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = g_cpuInfo.getCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
-      m_pCodecContext->thread_safe_callbacks = 1;
+      VideoThreadingPolicy policy = CVideoCodecThreading::Get(pCodec->name, hints.height,
+                                                              m_processInfo.IsRealtimeInput());
+      m_pCodecContext->thread_count = policy.threads;
+      switch (policy.type)
+      {
+        case VideoThreadType::NONE:
+          m_pCodecContext->thread_count = 1;
+          break;
+        case VideoThreadType::SLICE:
+          m_pCodecContext->thread_type = FF_THREAD_SLICE;
+          break;
+        case VideoThreadType::FRAME:
+          m_pCodecContext->thread_type = FF_THREAD_FRAME;
+          m_pCodecContext->thread_safe_callbacks = 1;
+          break;
+        case VideoThreadType::AUTO:
+          m_pCodecContext->thread_safe_callbacks = 1;
+          break;
+      }
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads", num_threads);
+      m_processInfo.SetVideoDecoderThreading(CVideoCodecThreading::TypeToString(policy.type), policy.threads);
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open %s threaded with %d threads",
+                CVideoCodecThreading::TypeToString(policy.type).c_str(), policy.threads);
     }
   }
   else
+  {
     m_decoderState = STATE_SW_SINGLE;
+    m_processInfo.SetVideoDecoderThreading(CVideoCodecThreading::TypeToString(VideoThreadType::NONE), 1);
+  }
 
   // if we don't do this, then some codecs seem to fail.
   m_pCodecContext->coded_height = hints.height;
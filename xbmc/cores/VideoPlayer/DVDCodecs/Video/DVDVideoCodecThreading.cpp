@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDVideoCodecThreading.h"
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/CPUInfo.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+
+namespace
+{
+
+bool MatchesRule(const VideoDecoderThreadingRule &rule, const std::string &codecName,
+                 int height, bool realtime)
+{
+  if (!rule.codec.empty() && !StringUtils::EqualsNoCase(rule.codec, codecName))
+    return false;
+  if (rule.minHeight > 0 && height < rule.minHeight)
+    return false;
+  if (rule.maxHeight > 0 && (height <= 0 || height > rule.maxHeight))
+    return false;
+  if (rule.source == VideoDecoderThreadingRule::SOURCE_LIVE && !realtime)
+    return false;
+  if (rule.source == VideoDecoderThreadingRule::SOURCE_FILE && realtime)
+    return false;
+  return true;
+}
+
+}
+
+VideoThreadingPolicy CVideoCodecThreading::Resolve(const std::string &codecName, int height, bool realtime,
+                                                   int cpuCount,
+                                                   const std::vector<VideoDecoderThreadingRule> &rules,
+                                                   int maxThreads)
+{
+  VideoThreadingPolicy policy;
+  policy.type = VideoThreadType::AUTO;
+  policy.threads = std::max(1, cpuCount) * 3 / 2;
+
+  for (const auto &rule : rules)
+  {
+    if (!MatchesRule(rule, codecName, height, realtime))
+      continue;
+
+    policy.type = TypeFromString(rule.type);
+    if (rule.threads > 0)
+      policy.threads = rule.threads;
+    if (rule.maxThreads > 0)
+      policy.threads = std::min(policy.threads, rule.maxThreads);
+    break;
+  }
+
+  if (maxThreads > 0)
+    policy.threads = std::min(policy.threads, maxThreads);
+  policy.threads = std::max(1, policy.threads);
+
+  if (policy.type == VideoThreadType::NONE)
+    policy.threads = 1;
+  else if (policy.threads == 1)
+    policy.type = VideoThreadType::NONE;
+
+  return policy;
+}
+
+VideoThreadingPolicy CVideoCodecThreading::Get(const std::string &codecName, int height, bool realtime)
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  return Resolve(codecName, height, realtime, g_cpuInfo.getCPUCount(),
+                 advancedSettings->m_videoDecoderThreadingRules,
+                 advancedSettings->m_videoDecoderMaxThreads);
+}
+
+std::string CVideoCodecThreading::TypeToString(VideoThreadType type)
+{
+  switch (type)
+  {
+    case VideoThreadType::NONE:
+      return "none";
+    case VideoThreadType::SLICE:
+      return "slice";
+    case VideoThreadType::FRAME:
+      return "frame";
+    case VideoThreadType::AUTO:
+    default:
+      return "auto";
+  }
+}
+
+VideoThreadType CVideoCodecThreading::TypeFromString(const std::string &type)
+{
+  if (StringUtils::EqualsNoCase(type, "none"))
+    return VideoThreadType::NONE;
+  else if (StringUtils::EqualsNoCase(type, "slice"))
+    return VideoThreadType::SLICE;
+  else if (StringUtils::EqualsNoCase(type, "frame"))
+    return VideoThreadType::FRAME;
+
+  return VideoThreadType::AUTO;
+}
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct VideoDecoderThreadingRule;
+
+enum class VideoThreadType
+{
+  NONE,   //!< single threaded decoding
+  SLICE,  //!< slice threading, no added latency
+  FRAME,  //!< frame threading, adds one frame of latency per thread
+  AUTO    //!< let ffmpeg pick, frame threading if the decoder supports it
+};
+
+struct VideoThreadingPolicy
+{
+  VideoThreadType type = VideoThreadType::AUTO;
+  int threads = 1;
+};
+
+/*!
+ * \brief Decides how CDVDVideoCodecFFmpeg threads software decoding.
+ *
+ * Rules from advancedsettings.xml (<video><decoderthreading>) are matched in
+ * order against decoder name, picture height and source type; the first match
+ * wins. Without a matching rule ffmpeg picks the threading model (AUTO) with
+ * one and a half threads per cpu, capped by the configured maximum.
+ */
+class CVideoCodecThreading
+{
+public:
+  /*!
+   * \brief Resolve the threading policy for a stream
+   * \param codecName ffmpeg decoder name, e.g. "hevc"
+   * \param height coded height of the stream, 0 if unknown
+   * \param realtime true for live sources (PVR, live streams)
+   * \param cpuCount number of available cpu cores
+   * \param rules user rules, evaluated in order
+   * \param maxThreads global thread cap, 0 for no cap
+   */
+  static VideoThreadingPolicy Resolve(const std::string &codecName, int height, bool realtime,
+                                      int cpuCount,
+                                      const std::vector<VideoDecoderThreadingRule> &rules,
+                                      int maxThreads);
+
+  /*!
+   * \brief Resolve the policy using advanced settings and the host cpu count
+   */
+  static VideoThreadingPolicy Get(const std::string &codecName, int height, bool realtime);
+
+  static std::string TypeToString(VideoThreadType type);
+  static VideoThreadType TypeFromString(const std::string &type);
+};
@@ -17,6 +17,7 @@ struct DemuxPacket;
 struct DemuxCryptoSession;
 
 class CDVDInputStream;
+class CDemuxSeekIndex;
 
 namespace ADDON {
   class IAddonProvider;
@@ -242,6 +243,12 @@ public:
    */
   virtual bool SeekTime(double time, bool backwards = false, double* startpts = NULL) = 0;
 
+  /*
+   * Keyframe index built while reading, used for seeking in files without a
+   * usable container index. nullptr if the demuxer doesn't maintain one
+   */
+  virtual CDemuxSeekIndex* GetSeekIndex() { return nullptr; }
+
   /*
    * Seek to a specified chapter.
    * startpts can be updated to the point where display should start
@@ -8,6 +8,8 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include <algorithm>
+#include <list>
 #include <sstream>
 #include <utility>
 
@@ -30,6 +32,8 @@
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/TimeUtils.h"
+#include "video/VideoInfoTag.h"
 
 #ifdef TARGET_POSIX
 #include "platform/linux/XTimeUtils.h"
@@ -163,6 +167,75 @@ static int64_t dvd_file_seek(void *h, int64_t pos, int whence)
     return pInputStream->Seek(pos, whence & ~AVSEEK_FORCE);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+// fast start probing
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ProbeHint
+{
+  int videoStreams = 0;
+  int audioStreams = 0;
+  int64_t probeBytes = 0; //!< bytes avformat_find_stream_info needed last time, 0 if unknown
+};
+
+// results of previous opens, most recent first
+static std::list<std::pair<std::string, ProbeHint>> probeHints;
+static CCriticalSection probeHintSection;
+static const size_t MAX_PROBE_HINTS = 20;
+
+static bool GetProbeHint(const std::string &file, const CFileItem &item, ProbeHint &hint)
+{
+  {
+    CSingleLock lock(probeHintSection);
+    for (const auto &entry : probeHints)
+    {
+      if (entry.first == file)
+      {
+        hint = entry.second;
+        return true;
+      }
+    }
+  }
+
+  // fall back to what the library knows about the file
+  if (item.HasVideoInfoTag() && item.GetVideoInfoTag()->HasStreamDetails())
+  {
+    const CStreamDetails &details = item.GetVideoInfoTag()->m_streamDetails;
+    hint.videoStreams = details.GetVideoStreamCount();
+    hint.audioStreams = details.GetAudioStreamCount();
+    hint.probeBytes = 0;
+    return hint.videoStreams + hint.audioStreams > 0;
+  }
+
+  return false;
+}
+
+static void SetProbeHint(const std::string &file, const ProbeHint &hint)
+{
+  CSingleLock lock(probeHintSection);
+
+  probeHints.remove_if([&file](const std::pair<std::string, ProbeHint> &entry) { return entry.first == file; });
+  probeHints.emplace_front(file, hint);
+  if (probeHints.size() > MAX_PROBE_HINTS)
+    probeHints.pop_back();
+}
+
+static void CountProbedStreams(const AVFormatContext *context, int &video, int &audio)
+{
+  video = 0;
+  audio = 0;
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVCodecParameters *par = context->streams[i]->codecpar;
+    if (par->codec_id == AV_CODEC_ID_NONE)
+      continue;
+    if (par->codec_type == AVMEDIA_TYPE_VIDEO && par->width > 0 && par->height > 0)
+      video++;
+    else if (par->codec_type == AVMEDIA_TYPE_AUDIO && par->sample_rate > 0 && par->channels > 0)
+      audio++;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -487,8 +560,58 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
     if(m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
+    // with a hint from a previous open only probe as much as was needed then,
+    // and fall back to full probing if that didn't find the known streams
+    ProbeHint hint;
+    int64_t probeSize = 0;
+    int64_t analyzeDuration = 0;
+    int64_t probeStart = m_pFormatContext->pb ? avio_tell(m_pFormatContext->pb) : 0;
+    bool fastStart = !fileinfo &&
+                     !m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) &&
+                     CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoFastStart &&
+                     GetProbeHint(strFile, m_pInput->GetFileItem(), hint);
+    if (fastStart)
+    {
+      av_opt_get_int(m_pFormatContext, "probesize", 0, &probeSize);
+      av_opt_get_int(m_pFormatContext, "analyzeduration", 0, &analyzeDuration);
+
+      int64_t fastProbeSize = hint.probeBytes > 0 ? hint.probeBytes + hint.probeBytes / 2 : 1024 * 1024;
+      fastProbeSize = std::max(fastProbeSize, static_cast<int64_t>(32 * 1024));
+      if (probeSize > 0)
+        fastProbeSize = std::min(fastProbeSize, probeSize);
+      av_opt_set_int(m_pFormatContext, "probesize", fastProbeSize, 0);
+      if (analyzeDuration == 0 || analyzeDuration > AV_TIME_BASE)
+        av_opt_set_int(m_pFormatContext, "analyzeduration", AV_TIME_BASE, 0);
+
+      CLog::Log(LOGDEBUG, "%s - fast start, expecting %d video and %d audio streams within %d bytes",
+                __FUNCTION__, hint.videoStreams, hint.audioStreams, static_cast<int>(fastProbeSize));
+    }
+
     CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
+    int64_t probeTime = CurrentHostCounter();
     int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+
+    int videoStreams, audioStreams;
+    CountProbedStreams(m_pFormatContext, videoStreams, audioStreams);
+    if (fastStart && (iErr < 0 || videoStreams < hint.videoStreams || audioStreams < hint.audioStreams))
+    {
+      CLog::Log(LOGDEBUG, "%s - fast start found %d video and %d audio streams, probing further",
+                __FUNCTION__, videoStreams, audioStreams);
+      av_opt_set_int(m_pFormatContext, "probesize", probeSize, 0);
+      av_opt_set_int(m_pFormatContext, "analyzeduration", analyzeDuration, 0);
+      iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+      CountProbedStreams(m_pFormatContext, videoStreams, audioStreams);
+    }
+    probeTime = (CurrentHostCounter() - probeTime) * 1000 / CurrentHostFrequency();
+
+    if (iErr >= 0 && !m_pInput->IsRealtime() && videoStreams + audioStreams > 0)
+    {
+      hint.videoStreams = videoStreams;
+      hint.audioStreams = audioStreams;
+      hint.probeBytes = m_pFormatContext->pb ? avio_tell(m_pFormatContext->pb) - probeStart : 0;
+      SetProbeHint(strFile, hint);
+    }
+
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING,"could not find codec parameters for %s", CURL::GetRedacted(strFile).c_str());
@@ -506,7 +629,7 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
         return false;
       }
     }
-    CLog::Log(LOGDEBUG, "%s - av_find_stream_info finished", __FUNCTION__);
+    CLog::Log(LOGDEBUG, "%s - av_find_stream_info finished after %d ms", __FUNCTION__, static_cast<int>(probeTime));
 
     // print some extra information
     av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(strFile).c_str(), 0);
@@ -1066,6 +1189,8 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
         if (pPacket->dts != DVD_NOPTS_VALUE && (pPacket->dts > m_currentPts || m_currentPts == DVD_NOPTS_VALUE))
           m_currentPts = pPacket->dts;
 
+        AddToSeekIndex(m_pkt.pkt, *pPacket);
+
         // store internal id until we know the continuous id presented to player
         // the stream might not have been created yet
         pPacket->iStreamId = m_pkt.pkt.stream_index;
@@ -1164,6 +1289,14 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double *startpts)
     return false;
   }
 
+  if (SeekIndexed(time, backwards))
+  {
+    if (startpts)
+      *startpts = DVD_MSEC_TO_TIME(time);
+
+    return !hitEnd;
+  }
+
   int64_t seek_pts = (int64_t)time * (AV_TIME_BASE / 1000);
   bool ismp3 = m_pFormatContext->iformat && (strcmp(m_pFormatContext->iformat->name, "mp3") == 0);
 
@@ -1268,6 +1401,44 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
   return (ret >= 0);
 }
 
+void CDVDDemuxFFmpeg::AddToSeekIndex(const AVPacket &pkt, const DemuxPacket &packet)
+{
+  if (!(pkt.flags & AV_PKT_FLAG_KEY) || pkt.pos < 0 || m_pInput->IsRealtime())
+    return;
+
+  int stream = m_seekStream >= 0 ? m_seekStream : av_find_default_stream_index(m_pFormatContext);
+  if (pkt.stream_index != stream)
+    return;
+
+  double ts = packet.dts != DVD_NOPTS_VALUE ? packet.dts : packet.pts;
+  if (ts != DVD_NOPTS_VALUE)
+    m_seekIndex.Add(static_cast<int64_t>(DVD_TIME_TO_MSEC(ts)), pkt.pos);
+}
+
+bool CDVDDemuxFFmpeg::SeekIndexed(double time, bool backwards)
+{
+  if (!m_pFormatContext->iformat || (m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK) ||
+      m_pInput->IsRealtime())
+    return false;
+
+  // the container index is authoritative if there is one
+  int stream = m_seekStream >= 0 ? m_seekStream : av_find_default_stream_index(m_pFormatContext);
+  if (stream < 0 || m_pFormatContext->streams[stream]->nb_index_entries > 1)
+    return false;
+
+  CDemuxSeekIndex::Entry entry;
+  if (!m_seekIndex.Find(static_cast<int64_t>(time), backwards, entry))
+    return false;
+
+  if (!SeekByte(entry.pos))
+    return false;
+
+  m_seekToKeyFrame = true;
+  CLog::Log(LOGDEBUG, "%s - seek to time %d using cached keyframe at %lld (%lld ms)", __FUNCTION__,
+            static_cast<int>(time), static_cast<long long>(entry.pos), static_cast<long long>(entry.time));
+  return true;
+}
+
 void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 {
   m_currentPts = DVD_NOPTS_VALUE;
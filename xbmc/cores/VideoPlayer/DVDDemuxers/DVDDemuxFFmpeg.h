@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DemuxSeekIndex.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -95,6 +96,7 @@ public:
 
   bool SeekTime(double time, bool backwards = false, double* startpts = NULL) override;
   bool SeekByte(int64_t pos);
+  CDemuxSeekIndex* GetSeekIndex() override { return &m_seekIndex; }
   int GetStreamLength() override;
   CDemuxStream* GetStream(int iStreamId) const override;
   std::vector<CDemuxStream*> GetStreams() const override;
@@ -131,6 +133,8 @@ protected:
   AVDictionary *GetFFMpegOptionsFromInput();
   double ConvertTimestamp(int64_t pts, int den, int num);
   void UpdateCurrentPTS();
+  void AddToSeekIndex(const AVPacket &pkt, const DemuxPacket &packet);
+  bool SeekIndexed(double time, bool backwards);
   bool IsProgramChange();
   unsigned int HLSSelectProgram();
 
@@ -173,6 +177,7 @@ protected:
   int m_displayTime = 0;
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
+  CDemuxSeekIndex m_seekIndex;
   double m_startTime = 0;
 };
 
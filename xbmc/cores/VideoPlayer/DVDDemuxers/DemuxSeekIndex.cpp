@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxSeekIndex.h"
+#include "utils/Base64.h"
+
+#include <algorithm>
+
+namespace
+{
+
+const unsigned char SEEKINDEX_VERSION = 1;
+
+void WriteVarint(std::string &out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const std::string &in, size_t &offset, uint64_t &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64 && offset < in.size(); shift += 7)
+  {
+    unsigned char byte = static_cast<unsigned char>(in[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+uint64_t ZigZagEncode(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool CompareTime(const CDemuxSeekIndex::Entry &entry, int64_t time)
+{
+  return entry.time < time;
+}
+
+}
+
+void CDemuxSeekIndex::Add(int64_t time, int64_t pos)
+{
+  if (time < 0 || pos < 0 || m_entries.size() >= MAX_ENTRIES)
+    return;
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, CompareTime);
+
+  if (it != m_entries.end() && it->time - time < MIN_INTERVAL_MS)
+    return;
+  if (it != m_entries.begin() && time - (it - 1)->time < MIN_INTERVAL_MS)
+    return;
+
+  m_entries.insert(it, Entry{time, pos});
+  m_modified = true;
+}
+
+bool CDemuxSeekIndex::Find(int64_t time, bool backwards, Entry &entry) const
+{
+  if (m_entries.empty())
+    return false;
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, CompareTime);
+
+  if (backwards)
+  {
+    if (it == m_entries.end() || it->time > time)
+    {
+      if (it == m_entries.begin())
+        return false;
+      --it;
+    }
+    if (time - it->time > MAX_DISTANCE_MS)
+      return false;
+  }
+  else
+  {
+    if (it == m_entries.end() || it->time - time > MAX_DISTANCE_MS)
+      return false;
+  }
+
+  entry = *it;
+  return true;
+}
+
+void CDemuxSeekIndex::Clear()
+{
+  m_entries.clear();
+  m_modified = false;
+}
+
+std::string CDemuxSeekIndex::Serialize() const
+{
+  std::string data;
+  data.reserve(m_entries.size() * 5 + 8);
+  data.push_back(static_cast<char>(SEEKINDEX_VERSION));
+  WriteVarint(data, m_entries.size());
+
+  int64_t lastTime = 0;
+  int64_t lastPos = 0;
+  for (const auto &entry : m_entries)
+  {
+    // times are sorted, positions usually are but don't have to be
+    WriteVarint(data, static_cast<uint64_t>(entry.time - lastTime));
+    WriteVarint(data, ZigZagEncode(entry.pos - lastPos));
+    lastTime = entry.time;
+    lastPos = entry.pos;
+  }
+
+  return Base64::Encode(data);
+}
+
+bool CDemuxSeekIndex::Deserialize(const std::string &data)
+{
+  Clear();
+
+  std::string raw = Base64::Decode(data);
+  if (raw.empty() || static_cast<unsigned char>(raw[0]) != SEEKINDEX_VERSION)
+    return false;
+
+  size_t offset = 1;
+  uint64_t count;
+  if (!ReadVarint(raw, offset, count) || count > MAX_ENTRIES)
+    return false;
+
+  std::vector<Entry> entries;
+  entries.reserve(static_cast<size_t>(count));
+
+  int64_t time = 0;
+  int64_t pos = 0;
+  for (uint64_t i = 0; i < count; i++)
+  {
+    uint64_t timeDelta, posDelta;
+    if (!ReadVarint(raw, offset, timeDelta) || !ReadVarint(raw, offset, posDelta))
+      return false;
+
+    time += static_cast<int64_t>(timeDelta);
+    pos += ZigZagDecode(posDelta);
+    entries.push_back(Entry{time, pos});
+  }
+
+  m_entries.swap(entries);
+  return true;
+}
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*!
+ * \brief Keyframe time to byte offset index of a single file.
+ *
+ * Filled while a demuxer reads the file and persisted in the video database,
+ * so seeks after re-opening files with poor or missing container indexes
+ * (transport streams, some avi and mkv) become a single byte seek instead of
+ * a scan over the network.
+ */
+class CDemuxSeekIndex
+{
+public:
+  struct Entry
+  {
+    int64_t time; //!< keyframe time in ms from stream start
+    int64_t pos;  //!< byte offset of the keyframe packet
+  };
+
+  //! keyframes closer together than this are not stored
+  static const int64_t MIN_INTERVAL_MS = 2000;
+  //! lookups fail if the closest entry is further away from the target than this
+  static const int64_t MAX_DISTANCE_MS = 5000;
+  //! keeps the serialized index below the 64k limit of a MySQL text column
+  static const size_t MAX_ENTRIES = 6000;
+
+  /*!
+   * \brief Add a keyframe, ignored if it is too close to an existing entry
+   */
+  void Add(int64_t time, int64_t pos);
+
+  /*!
+   * \brief Find the keyframe to start playback from for the given time
+   * \param time target time in ms
+   * \param backwards true to find the closest keyframe at or before the target,
+   *                  false for the closest one at or after it
+   * \param entry [out] the keyframe found
+   * \return true if a keyframe within MAX_DISTANCE_MS of the target exists
+   */
+  bool Find(int64_t time, bool backwards, Entry &entry) const;
+
+  void Clear();
+  size_t Size() const { return m_entries.size(); }
+  bool IsModified() const { return m_modified; }
+  void SetModified(bool modified) { m_modified = modified; }
+
+  /*!
+   * \brief Delta and varint encode the index, base64 wrapped for storage in text columns
+   */
+  std::string Serialize() const;
+  bool Deserialize(const std::string &data);
+
+private:
+  std::vector<Entry> m_entries;
+  bool m_modified = false;
+};
@@ -187,6 +187,7 @@ public:
   virtual IChapter* GetIChapter() { return nullptr; }
 
   const CVariant &GetProperty(const std::string key){ return m_item.GetProperty(key); }
+  const CFileItem& GetFileItem() const { return m_item; }
 
 protected:
   DVDStreamType m_streamType;
@@ -17,8 +17,19 @@
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
+#include "threads/Event.h"
 #include "threads/SingleLock.h"
+#include "threads/Thread.h"
 #include "windowing/GraphicContext.h"
+#include "cores/VideoPlayer/VideoRenderers/OverlayRendererUtil.h"
+
+#include <atomic>
+#include <cstring>
+
+// packed frames kept for reuse, per track
+static const size_t MAX_CACHED_FRAMES = 16;
+// number of upcoming event changes rendered ahead of presentation
+static const int PRERENDER_FRAMES = 4;
 
 static void libass_log(int level, const char *fmt, va_list args, void *data)
 {
@@ -28,6 +39,89 @@ static void libass_log(int level, const char *fmt, va_list args, void *data)
   CLog::Log(LOGDEBUG, "CDVDSubtitlesLibass: [ass] %s", log.c_str());
 }
 
+// events whose rendering depends on the time within the event can't be
+// shared between frames
+static bool IsAnimated(const ASS_Event& event)
+{
+  if (event.Effect && event.Effect[0])
+    return true;
+  if (!event.Text)
+    return false;
+
+  static const char* tags[] = { "\\t(", "\\move", "\\fad", "\\k", "\\K" };
+  for (const char* tag : tags)
+  {
+    if (strstr(event.Text, tag))
+      return true;
+  }
+  return false;
+}
+
+class CDVDSubtitlesLibassPrerender : public CThread
+{
+public:
+  explicit CDVDSubtitlesLibassPrerender(CDVDSubtitlesLibass& libass)
+    : CThread("LibassPrerender")
+    , m_libass(libass)
+  {
+  }
+
+  void Request(const CDVDSubtitlesLibass::SRenderParams& params, double pts)
+  {
+    CSingleLock lock(m_section);
+    m_params = params;
+    m_pts = pts;
+    m_pending = true;
+    m_event.Set();
+  }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      AbortableWait(m_event);
+
+      CDVDSubtitlesLibass::SRenderParams params;
+      double pts;
+      {
+        CSingleLock lock(m_section);
+        if (!m_pending)
+          continue;
+        params = m_params;
+        pts = m_pts;
+        m_pending = false;
+      }
+
+      for (int i = 0; i < PRERENDER_FRAMES && !m_bStop && !m_pending; i++)
+      {
+        pts = m_libass.Prerender(params, pts);
+        if (pts == DVD_NOPTS_VALUE)
+          break;
+      }
+    }
+  }
+
+  CDVDSubtitlesLibass& m_libass;
+  CCriticalSection m_section;
+  CEvent m_event;
+  CDVDSubtitlesLibass::SRenderParams m_params;
+  double m_pts = DVD_NOPTS_VALUE;
+  std::atomic<bool> m_pending{false};
+};
+
+bool CDVDSubtitlesLibass::SRenderParams::operator==(const SRenderParams& right) const
+{
+  return frameWidth == right.frameWidth &&
+         frameHeight == right.frameHeight &&
+         videoWidth == right.videoWidth &&
+         videoHeight == right.videoHeight &&
+         sourceWidth == right.sourceWidth &&
+         sourceHeight == right.sourceHeight &&
+         useMargin == right.useMargin &&
+         position == right.position;
+}
+
 CDVDSubtitlesLibass::CDVDSubtitlesLibass()
 {
   //Setting the font directory to the temp dir(where mkv fonts are extracted to)
@@ -54,6 +148,13 @@ CDVDSubtitlesLibass::CDVDSubtitlesLibass()
   if(!m_renderer)
     return;
 
+  SetupRenderer(m_renderer);
+}
+
+void CDVDSubtitlesLibass::SetupRenderer(ASS_Renderer* renderer)
+{
+  std::string strPath;
+
   //Setting default font to the Arial in \media\fonts (used if FontConfig fails)
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
   strPath = URIUtils::AddFileToFolder("special://home/media/Fonts/", settings->GetString(CSettings::SETTING_SUBTITLES_FONT));
@@ -61,20 +162,28 @@ CDVDSubtitlesLibass::CDVDSubtitlesLibass()
     strPath = URIUtils::AddFileToFolder("special://xbmc/media/Fonts/", settings->GetString(CSettings::SETTING_SUBTITLES_FONT));
   int fc = !settings->GetBool(CSettings::SETTING_SUBTITLES_OVERRIDEASSFONTS);
 
-  ass_set_margins(m_renderer, 0, 0, 0, 0);
-  ass_set_use_margins(m_renderer, 0);
-  ass_set_font_scale(m_renderer, 1);
+  ass_set_margins(renderer, 0, 0, 0, 0);
+  ass_set_use_margins(renderer, 0);
+  ass_set_font_scale(renderer, 1);
 
   // libass uses fontconfig (system lib) which is not wrapped
   //  so translate the path before calling into libass
-  ass_set_fonts(m_renderer, CSpecialProtocol::TranslatePath(strPath).c_str(), "Arial", fc, NULL, 1);
+  ass_set_fonts(renderer, CSpecialProtocol::TranslatePath(strPath).c_str(), "Arial", fc, NULL, 1);
 }
 
 
 CDVDSubtitlesLibass::~CDVDSubtitlesLibass()
 {
+  if (m_prerender)
+    m_prerender->StopThread();
+  m_prerender.reset();
+
   if(m_track)
     ass_free_track(m_track);
+  if (m_prerenderTrack)
+    ass_free_track(m_prerenderTrack);
+  if (m_prerenderer)
+    ass_renderer_done(m_prerenderer);
   ass_renderer_done(m_renderer);
   ass_library_done(m_library);
 }
@@ -82,72 +191,285 @@ CDVDSubtitlesLibass::~CDVDSubtitlesLibass()
 /*Decode Header of SSA, needed to properly decode demux packets*/
 bool CDVDSubtitlesLibass::DecodeHeader(char* data, int size)
 {
-  CSingleLock lock(m_section);
-  if(!m_library || !data)
-    return false;
+  {
+    CSingleLock lock(m_section);
+    if(!m_library || !data)
+      return false;
+
+    if(!m_track)
+    {
+      CLog::Log(LOGINFO, "CDVDSubtitlesLibass: Creating new ASS track");
+      m_track = ass_new_track(m_library) ;
+    }
+
+    ass_process_codec_private(m_track, data, size);
+  }
 
-  if(!m_track)
   {
-    CLog::Log(LOGINFO, "CDVDSubtitlesLibass: Creating new ASS track");
-    m_track = ass_new_track(m_library) ;
+    CSingleLock lock(m_prerenderSection);
+    if (!m_prerenderTrack)
+      m_prerenderTrack = ass_new_track(m_library);
+    if (m_prerenderTrack)
+      ass_process_codec_private(m_prerenderTrack, data, size);
   }
 
-  ass_process_codec_private(m_track, data, size);
+  ClearCache();
   return true;
 }
 
 bool CDVDSubtitlesLibass::DecodeDemuxPkt(const char* data, int size, double start, double duration)
 {
-  CSingleLock lock(m_section);
-  if(!m_track)
   {
-    CLog::Log(LOGERROR, "CDVDSubtitlesLibass: No SSA header found.");
-    return false;
+    CSingleLock lock(m_section);
+    if(!m_track)
+    {
+      CLog::Log(LOGERROR, "CDVDSubtitlesLibass: No SSA header found.");
+      return false;
+    }
+
+    //! @bug libass isn't const correct
+    ass_process_chunk(m_track, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start), DVD_TIME_TO_MSEC(duration));
   }
 
-  //! @bug libass isn't const correct
-  ass_process_chunk(m_track, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start), DVD_TIME_TO_MSEC(duration));
+  CSingleLock lock(m_prerenderSection);
+  if (m_prerenderTrack)
+    ass_process_chunk(m_prerenderTrack, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start), DVD_TIME_TO_MSEC(duration));
   return true;
 }
 
 bool CDVDSubtitlesLibass::CreateTrack(char* buf, size_t size)
 {
-  CSingleLock lock(m_section);
-  if(!m_library)
+  // libass parses the buffer in place
+  std::vector<char> prerenderBuf(buf, buf + size);
+
   {
-    CLog::Log(LOGERROR, "CDVDSubtitlesLibass: %s - No ASS library struct", __FUNCTION__);
-    return false;
-  }
+    CSingleLock lock(m_section);
+    if(!m_library)
+    {
+      CLog::Log(LOGERROR, "CDVDSubtitlesLibass: %s - No ASS library struct", __FUNCTION__);
+      return false;
+    }
 
-  CLog::Log(LOGINFO, "SSA Parser: Creating m_track from SSA buffer");
+    CLog::Log(LOGINFO, "SSA Parser: Creating m_track from SSA buffer");
 
-  m_track = ass_read_memory(m_library, buf, size, 0);
-  if(m_track == NULL)
-    return false;
+    m_track = ass_read_memory(m_library, buf, size, 0);
+    if(m_track == NULL)
+      return false;
+  }
+
+  {
+    CSingleLock lock(m_prerenderSection);
+    if (m_prerenderTrack)
+      ass_free_track(m_prerenderTrack);
+    m_prerenderTrack = ass_read_memory(m_library, prerenderBuf.data(), prerenderBuf.size(), 0);
+  }
 
+  ClearCache();
   return true;
 }
 
 ASS_Image* CDVDSubtitlesLibass::RenderImage(int frameWidth, int frameHeight, int videoWidth, int videoHeight, int sourceWidth, int sourceHeight,
                                             double pts, int useMargin, double position, int *changes)
 {
+  SRenderParams params = { frameWidth, frameHeight, videoWidth, videoHeight, sourceWidth, sourceHeight, useMargin, position };
+
   CSingleLock lock(m_section);
-  if(!m_renderer || !m_track)
+  return Render(m_renderer, m_track, params, pts, changes);
+}
+
+ASS_Image* CDVDSubtitlesLibass::Render(ASS_Renderer* renderer, ASS_Track* track, const SRenderParams& params, double pts, int* changes)
+{
+  if(!renderer || !track)
   {
     CLog::Log(LOGERROR, "CDVDSubtitlesLibass: %s - Missing ASS structs(m_track or m_renderer)", __FUNCTION__);
     return NULL;
   }
 
-  double sar = (double)sourceWidth / sourceHeight;
-  double dar = (double)videoWidth / videoHeight;
-  ass_set_frame_size(m_renderer, frameWidth, frameHeight);
-  int topmargin = (frameHeight - videoHeight) / 2;
-  int leftmargin = (frameWidth - videoWidth) / 2;
-  ass_set_margins(m_renderer, topmargin, topmargin, leftmargin, leftmargin);
-  ass_set_use_margins(m_renderer, useMargin);
-  ass_set_line_position(m_renderer, position);
-  ass_set_aspect_ratio(m_renderer, dar, sar);
-  return ass_render_frame(m_renderer, m_track, DVD_TIME_TO_MSEC(pts), changes);
+  double sar = (double)params.sourceWidth / params.sourceHeight;
+  double dar = (double)params.videoWidth / params.videoHeight;
+  ass_set_frame_size(renderer, params.frameWidth, params.frameHeight);
+  int topmargin = (params.frameHeight - params.videoHeight) / 2;
+  int leftmargin = (params.frameWidth - params.videoWidth) / 2;
+  ass_set_margins(renderer, topmargin, topmargin, leftmargin, leftmargin);
+  ass_set_use_margins(renderer, params.useMargin);
+  ass_set_line_position(renderer, params.position);
+  ass_set_aspect_ratio(renderer, dar, sar);
+  return ass_render_frame(renderer, track, DVD_TIME_TO_MSEC(pts), changes);
+}
+
+std::shared_ptr<OVERLAY::SQuads> CDVDSubtitlesLibass::RenderQuads(const SRenderParams& params, double pts, bool& changed)
+{
+  std::vector<int> events;
+  double next;
+  bool cacheable = GetEventSet(pts, events, next);
+  bool rendered = false;
+
+  std::shared_ptr<OVERLAY::SQuads> quads;
+  if (events.empty())
+  {
+    // nothing to show, don't bother libass
+  }
+  else if (cacheable && FindCached(params, events, quads))
+  {
+  }
+  else
+  {
+    CSingleLock lock(m_section);
+    int changes = 0;
+    ASS_Image* images = Render(m_renderer, m_track, params, pts, &changes);
+    // changes is relative to the previous frame libass rendered, which is
+    // only the frame shown last if that wasn't taken from the cache
+    if (changes == 0 && m_lastRendered && m_lastQuads)
+      quads = m_lastQuads;
+    else
+      quads = Pack(images, params.frameWidth);
+    rendered = true;
+  }
+
+  if (rendered && cacheable && quads)
+    AddCached(params, events, quads);
+
+  if (next != DVD_NOPTS_VALUE && m_renderer)
+  {
+    if (!m_prerender)
+    {
+      m_prerender.reset(new CDVDSubtitlesLibassPrerender(*this));
+      m_prerender->Create();
+    }
+    m_prerender->Request(params, pts);
+  }
+
+  changed = quads != m_lastQuads;
+  m_lastQuads = quads;
+  m_lastRendered = rendered;
+  return quads;
+}
+
+bool CDVDSubtitlesLibass::GetEventSet(double pts, std::vector<int>& events, double& next)
+{
+  CSingleLock lock(m_section);
+  return GetEventSet(m_track, pts, events, next);
+}
+
+bool CDVDSubtitlesLibass::GetEventSet(const ASS_Track* track, double pts, std::vector<int>& events, double& next)
+{
+  events.clear();
+  next = DVD_NOPTS_VALUE;
+  if (!track)
+    return false;
+
+  long long now = DVD_TIME_TO_MSEC(pts);
+  long long nextChange = -1;
+  bool cacheable = true;
+  for (int i = 0; i < track->n_events; i++)
+  {
+    const ASS_Event& event = track->events[i];
+    long long start = event.Start;
+    long long end = event.Start + event.Duration;
+
+    if (start > now)
+    {
+      if (nextChange < 0 || start < nextChange)
+        nextChange = start;
+    }
+    else if (end > now)
+    {
+      if (nextChange < 0 || end < nextChange)
+        nextChange = end;
+      if (IsAnimated(event))
+        cacheable = false;
+      events.push_back(i);
+    }
+  }
+
+  if (nextChange >= 0)
+    next = DVD_MSEC_TO_TIME(static_cast<double>(nextChange));
+  return cacheable;
+}
+
+std::shared_ptr<OVERLAY::SQuads> CDVDSubtitlesLibass::Pack(ASS_Image* images, int width)
+{
+  std::shared_ptr<OVERLAY::SQuads> quads = std::make_shared<OVERLAY::SQuads>();
+  if (!OVERLAY::convert_quad(images, *quads, width))
+    return nullptr;
+  return quads;
+}
+
+bool CDVDSubtitlesLibass::FindCached(const SRenderParams& params, const std::vector<int>& events,
+                                     std::shared_ptr<OVERLAY::SQuads>& quads)
+{
+  CSingleLock lock(m_cacheSection);
+
+  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+  {
+    if (it->params == params && it->events == events)
+    {
+      quads = it->quads;
+      m_cache.splice(m_cache.begin(), m_cache, it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void CDVDSubtitlesLibass::AddCached(const SRenderParams& params, const std::vector<int>& events,
+                                    const std::shared_ptr<OVERLAY::SQuads>& quads)
+{
+  CSingleLock lock(m_cacheSection);
+
+  for (const auto& entry : m_cache)
+  {
+    if (entry.params == params && entry.events == events)
+      return;
+  }
+
+  m_cache.push_front(SCacheEntry{ params, events, quads });
+  if (m_cache.size() > MAX_CACHED_FRAMES)
+    m_cache.pop_back();
+}
+
+void CDVDSubtitlesLibass::ClearCache()
+{
+  CSingleLock lock(m_cacheSection);
+  m_cache.clear();
+}
+
+double CDVDSubtitlesLibass::Prerender(const SRenderParams& params, double pts)
+{
+  std::vector<int> events;
+  double next;
+  std::shared_ptr<OVERLAY::SQuads> quads;
+  {
+    // only the render thread's own lock is left free, the result is
+    // published through the cache
+    CSingleLock lock(m_prerenderSection);
+    GetEventSet(m_prerenderTrack, pts, events, next);
+    if (next == DVD_NOPTS_VALUE)
+      return DVD_NOPTS_VALUE;
+
+    double after;
+    if (!GetEventSet(m_prerenderTrack, next, events, after) || events.empty())
+      return next;
+
+    if (FindCached(params, events, quads))
+      return next;
+
+    if (!m_prerenderer)
+    {
+      // own renderer, so the images of the presented frame stay valid
+      m_prerenderer = ass_renderer_init(m_library);
+      if (!m_prerenderer)
+        return DVD_NOPTS_VALUE;
+      SetupRenderer(m_prerenderer);
+    }
+
+    ASS_Image* images = Render(m_prerenderer, m_prerenderTrack, params, next, nullptr);
+    quads = Pack(images, params.frameWidth);
+  }
+
+  if (quads)
+    AddCached(params, events, quads);
+  return next;
 }
 
 ASS_Event* CDVDSubtitlesLibass::GetEvents()
@@ -11,18 +11,54 @@
 #include "DVDResource.h"
 #include "threads/CriticalSection.h"
 
+#include <list>
+#include <memory>
+#include <vector>
+
 #include <ass/ass.h>
 
+namespace OVERLAY
+{
+  struct SQuads;
+}
+
+class CDVDSubtitlesLibassPrerender;
+
  /** Wrapper for Libass **/
 
 class CDVDSubtitlesLibass : public IDVDResourceCounted<CDVDSubtitlesLibass>
 {
 public:
+  struct SRenderParams
+  {
+    int frameWidth;
+    int frameHeight;
+    int videoWidth;
+    int videoHeight;
+    int sourceWidth;
+    int sourceHeight;
+    int useMargin;
+    double position;
+
+    bool operator==(const SRenderParams& right) const;
+  };
+
   CDVDSubtitlesLibass();
   ~CDVDSubtitlesLibass() override;
 
   ASS_Image* RenderImage(int frameWidth, int frameHeight, int videoWidth, int videoHeight, int sourceWidth, int sourceHeight,
                          double pts, int useMargin = 0, double position = 0.0, int* changes = NULL);
+
+  /*!
+   * \brief Render the subtitles at pts and pack them into a glyph texture
+   *
+   * Frames showing the same set of static events share one result, which is
+   * usually rendered ahead of time on a worker thread.
+   * \param changed [out] false if the result is the one returned by the previous call
+   * \return the packed glyphs, nullptr if nothing is displayed
+   */
+  std::shared_ptr<OVERLAY::SQuads> RenderQuads(const SRenderParams& params, double pts, bool& changed);
+
   ASS_Event* GetEvents();
 
   int GetNrOfEvents();
@@ -32,9 +68,39 @@ public:
   bool CreateTrack(char* buf, size_t size);
 
 private:
+  friend class CDVDSubtitlesLibassPrerender;
+
+  struct SCacheEntry
+  {
+    SRenderParams params;
+    std::vector<int> events;
+    std::shared_ptr<OVERLAY::SQuads> quads;
+  };
+
+  void SetupRenderer(ASS_Renderer* renderer);
+  ASS_Image* Render(ASS_Renderer* renderer, ASS_Track* track, const SRenderParams& params, double pts, int* changes);
+  bool GetEventSet(double pts, std::vector<int>& events, double& next);
+  static bool GetEventSet(const ASS_Track* track, double pts, std::vector<int>& events, double& next);
+  std::shared_ptr<OVERLAY::SQuads> Pack(ASS_Image* images, int width);
+  bool FindCached(const SRenderParams& params, const std::vector<int>& events, std::shared_ptr<OVERLAY::SQuads>& quads);
+  void AddCached(const SRenderParams& params, const std::vector<int>& events, const std::shared_ptr<OVERLAY::SQuads>& quads);
+  void ClearCache();
+  double Prerender(const SRenderParams& params, double pts);
+
   ASS_Library* m_library = nullptr;
   ASS_Track* m_track = nullptr;
   ASS_Renderer* m_renderer = nullptr;
   CCriticalSection m_section;
-};
 
+  // the prerender thread renders a copy of the track fed the same data, so
+  // it never holds m_section while libass renders
+  ASS_Track* m_prerenderTrack = nullptr;
+  ASS_Renderer* m_prerenderer = nullptr;
+  CCriticalSection m_prerenderSection;
+
+  CCriticalSection m_cacheSection;
+  std::list<SCacheEntry> m_cache; //!< most recently used first
+  std::shared_ptr<OVERLAY::SQuads> m_lastQuads;
+  bool m_lastRendered = false;
+  std::unique_ptr<CDVDSubtitlesLibassPrerender> m_prerender;
+};
@@ -63,6 +63,8 @@ void CProcessInfo::ResetVideoCodecInfo()
 
   m_videoIsHWDecoder = false;
   m_videoDecoderName = "unknown";
+  m_videoDecoderThreadType = "none";
+  m_videoDecoderThreads = 1;
   m_videoDeintMethod = "unknown";
   m_videoPixelFormat = "unknown";
   m_videoStereoMode.clear();
@@ -79,6 +81,7 @@ void CProcessInfo::ResetVideoCodecInfo()
   if (m_dataCache)
   {
     m_dataCache->SetVideoDecoderName(m_videoDecoderName, m_videoIsHWDecoder);
+    m_dataCache->SetVideoDecoderThreading(m_videoDecoderThreadType, m_videoDecoderThreads);
     m_dataCache->SetVideoDeintMethod(m_videoDeintMethod);
     m_dataCache->SetVideoPixelFormat(m_videoPixelFormat);
     m_dataCache->SetVideoDimensions(m_videoWidth, m_videoHeight);
@@ -114,6 +117,31 @@ bool CProcessInfo::IsVideoHwDecoder()
   return m_videoIsHWDecoder;
 }
 
+void CProcessInfo::SetVideoDecoderThreading(const std::string &type, int threads)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoDecoderThreadType = type;
+  m_videoDecoderThreads = threads;
+
+  if (m_dataCache)
+    m_dataCache->SetVideoDecoderThreading(m_videoDecoderThreadType, m_videoDecoderThreads);
+}
+
+std::string CProcessInfo::GetVideoDecoderThreadType()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoDecoderThreadType;
+}
+
+int CProcessInfo::GetVideoDecoderThreads()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoDecoderThreads;
+}
+
 void CProcessInfo::SetVideoDeintMethod(const std::string &method)
 {
   CSingleLock lock(m_videoCodecSection);
@@ -493,6 +521,20 @@ bool CProcessInfo::IsRealtimeStream()
   return m_realTimeStream;
 }
 
+void CProcessInfo::SetInputRealtime(bool state)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_realTimeInput = state;
+}
+
+bool CProcessInfo::IsRealtimeInput()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_realTimeInput;
+}
+
 void CProcessInfo::SetSpeed(float speed)
 {
   CSingleLock lock(m_stateSection);
@@ -538,6 +580,23 @@ bool CProcessInfo::IsFrameAdvance()
   return m_frameAdvance;
 }
 
+void CProcessInfo::SetTimeToFirstFrame(int ms)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_timeToFirstFrame = ms;
+
+  if (m_dataCache)
+    m_dataCache->SetTimeToFirstFrame(ms);
+}
+
+int CProcessInfo::GetTimeToFirstFrame()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_timeToFirstFrame;
+}
+
 void CProcessInfo::SetTempo(float tempo)
 {
   CSingleLock lock(m_stateSection);
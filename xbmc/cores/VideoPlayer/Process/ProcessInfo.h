@@ -35,6 +35,9 @@ public:
   void SetVideoDecoderName(const std::string &name, bool isHw);
   std::string GetVideoDecoderName();
   bool IsVideoHwDecoder();
+  void SetVideoDecoderThreading(const std::string &type, int threads);
+  std::string GetVideoDecoderThreadType();
+  int GetVideoDecoderThreads();
   void SetVideoDeintMethod(const std::string &method);
   std::string GetVideoDeintMethod();
   void SetVideoPixelFormat(const std::string &pixFormat);
@@ -84,6 +87,10 @@ public:
   bool IsSeeking();
   void SetStateRealtime(bool state);
   bool IsRealtimeStream();
+  // whether the input is a live source, known as soon as it's opened. The realtime state above
+  // only follows once the player runs, after the audio output was set up for the stream
+  void SetInputRealtime(bool state);
+  bool IsRealtimeInput();
   void SetSpeed(float speed);
   void SetNewSpeed(float speed);
   float GetNewSpeed();
@@ -101,6 +108,8 @@ public:
   bool GetGuiRender();
   void SetVideoRender(bool video);
   bool GetVideoRender();
+  void SetTimeToFirstFrame(int ms);
+  int GetTimeToFirstFrame();
 
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   int64_t GetMaxTime();
@@ -118,6 +127,8 @@ protected:
   // player video info
   bool m_videoIsHWDecoder;
   std::string m_videoDecoderName;
+  std::string m_videoDecoderThreadType;
+  int m_videoDecoderThreads;
   std::string m_videoDeintMethod;
   std::string m_videoPixelFormat;
   std::string m_videoStereoMode;
@@ -163,6 +174,8 @@ protected:
   int64_t m_timeMax;
   int64_t m_timeMin;
   bool m_realTimeStream;
+  bool m_realTimeInput = false;
+  int m_timeToFirstFrame = 0;
 
   // settings
   CCriticalSection m_settingsSection;
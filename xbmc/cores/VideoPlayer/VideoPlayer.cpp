@@ -23,6 +23,7 @@
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
 #include "DVDDemuxers/DVDDemuxFFmpeg.h"
+#include "DVDDemuxers/DemuxSeekIndex.h"
 
 #include "DVDFileInfo.h"
 
@@ -58,8 +59,10 @@
 #include "dialogs/GUIDialogKaiToast.h"
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "video/Bookmark.h"
 #include "video/VideoInfoTag.h"
+#include "video/VideoDatabase.h"
 #include "Util.h"
 #include "LangInfo.h"
 #include "URL.h"
@@ -768,6 +771,11 @@ bool CVideoPlayer::IsPlaying() const
   return !m_bStop;
 }
 
+int CVideoPlayer::GetStartupTime() const
+{
+  return static_cast<int>((CurrentHostCounter() - m_startupCounter) * 1000 / CurrentHostFrequency());
+}
+
 void CVideoPlayer::OnStartup()
 {
   m_CurrentVideo.Clear();
@@ -880,7 +888,11 @@ bool CVideoPlayer::OpenDemuxStream()
   m_pDemuxer->GetPrograms(m_programs);
   UpdateContent();
   m_demuxerSpeed = DVD_PLAYSPEED_NORMAL;
+  LoadSeekIndex();
   m_processInfo->SetStateRealtime(false);
+  // known before the codecs are opened so they can pick a low latency setup. The realtime
+  // state follows in UpdatePlayState, audio sets up passthrough and sync without it first
+  m_processInfo->SetInputRealtime(m_pInputStream->IsRealtime());
 
   int64_t len = m_pInputStream->GetLength();
   int64_t tim = m_pDemuxer->GetStreamLength();
@@ -894,6 +906,7 @@ bool CVideoPlayer::OpenDemuxStream()
 
 void CVideoPlayer::CloseDemuxer()
 {
+  SaveSeekIndex();
   delete m_pDemuxer;
   m_pDemuxer = nullptr;
   m_SelectionStreams.Clear(STREAM_NONE, STREAM_SOURCE_DEMUX);
@@ -903,6 +916,58 @@ void CVideoPlayer::CloseDemuxer()
   CServiceBroker::GetDataCacheCore().SignalSubtitleInfoChange();
 }
 
+bool CVideoPlayer::UseSeekIndexCache() const
+{
+  if (!m_pDemuxer || !m_pDemuxer->GetSeekIndex() || !m_pInputStream)
+    return false;
+
+  if (!m_pInputStream->IsStreamType(DVDSTREAM_TYPE_FILE) || m_pInputStream->IsRealtime())
+    return false;
+
+  return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoSeekIndexCache;
+}
+
+void CVideoPlayer::LoadSeekIndex()
+{
+  if (!UseSeekIndexCache())
+    return;
+
+  std::string data;
+  CVideoDatabase db;
+  if (!db.Open())
+    return;
+  db.GetSeekIndex(m_item.GetDynPath(), data);
+  db.Close();
+
+  CDemuxSeekIndex* index = m_pDemuxer->GetSeekIndex();
+  if (!data.empty() && index->Deserialize(data))
+    CLog::Log(LOGDEBUG, "%s - loaded %d seek index entries", __FUNCTION__, (int)index->Size());
+}
+
+void CVideoPlayer::SaveSeekIndex()
+{
+  if (!UseSeekIndexCache())
+    return;
+
+  CDemuxSeekIndex* index = m_pDemuxer->GetSeekIndex();
+  if (!index->IsModified() || index->Size() == 0)
+    return;
+
+  std::string path = m_item.GetDynPath();
+  std::string data = index->Serialize();
+  index->SetModified(false);
+
+  // don't hold up closing the player on a (possibly remote) database
+  CJobManager::GetInstance().Submit([path, data]() {
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      db.SetSeekIndex(path, data);
+      db.Close();
+    }
+  });
+}
+
 void CVideoPlayer::OpenDefaultStreams(bool reset)
 {
   // if input stream dictate, we will open later
@@ -1225,6 +1290,8 @@ void CVideoPlayer::CheckBetterStream(CCurrentStream& current, CDemuxStream* stre
 
 void CVideoPlayer::Prepare()
 {
+  m_startupCounter = CurrentHostCounter();
+  m_processInfo->SetTimeToFirstFrame(0);
   CFFmpegLog::SetLogLevel(1);
   SetPlaySpeed(DVD_PLAYSPEED_NORMAL);
   m_processInfo->SetSpeed(1.0);
@@ -1253,6 +1320,7 @@ void CVideoPlayer::Prepare()
     m_error = true;
     return;
   }
+  m_startupInputTime = GetStartupTime();
 
   bool discStateRestored = false;
   if (std::shared_ptr<CDVDInputStream::IMenus> ptr = std::dynamic_pointer_cast<CDVDInputStream::IMenus>(m_pInputStream))
@@ -1273,6 +1341,7 @@ void CVideoPlayer::Prepare()
     m_error = true;
     return;
   }
+  m_startupDemuxTime = GetStartupTime();
   // give players a chance to reconsider now codecs are known
   CreatePlayers();
 
@@ -2086,6 +2155,11 @@ void CVideoPlayer::HandlePlaySpeed()
           CApplicationMessenger::GetInstance().PostMsg(TMSG_SWITCHTOFULLSCREEN);
         }
 
+        int startupTime = GetStartupTime();
+        m_processInfo->SetTimeToFirstFrame(startupTime);
+        CLog::Log(LOGNOTICE, "VideoPlayer: first frame after %d ms (input %d ms, demuxer %d ms)",
+                  startupTime, m_startupInputTime, m_startupDemuxTime - m_startupInputTime);
+
         IPlayerCallback *cb = &m_callback;
         CFileItem fileItem = m_item;
         m_outboundEvents->Submit([=]() {
@@ -468,6 +468,10 @@ protected:
   bool OpenInputStream();
   bool OpenDemuxStream();
   void CloseDemuxer();
+  bool UseSeekIndexCache() const;
+  void LoadSeekIndex();
+  void SaveSeekIndex();
+  int GetStartupTime() const;
   void OpenDefaultStreams(bool reset = true);
 
   void UpdatePlayState(double timeout);
@@ -526,6 +530,11 @@ protected:
 
   double m_offset_pts;
 
+  // time to first frame, in ms since Prepare() unless noted
+  int64_t m_startupCounter = 0;
+  int m_startupInputTime = 0;
+  int m_startupDemuxTime = 0;
+
   CDVDMessageQueue m_messenger;
   std::unique_ptr<CJobQueue> m_outboundEvents;
 
@@ -382,13 +382,24 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
   }
   else
     position = 0.0;
-  int changes = 0;
-  ASS_Image* images = o->m_libass->RenderImage(targetWidth, targetHeight, videoWidth, videoHeight, sourceWidth, sourceHeight,
-                                               pts, useMargin, position, &changes);
+  CDVDSubtitlesLibass::SRenderParams params;
+  params.frameWidth = targetWidth;
+  params.frameHeight = targetHeight;
+  params.videoWidth = videoWidth;
+  params.videoHeight = videoHeight;
+  params.sourceWidth = sourceWidth;
+  params.sourceHeight = sourceHeight;
+  params.useMargin = useMargin;
+  params.position = position;
+
+  bool changed = true;
+  std::shared_ptr<SQuads> quads = o->m_libass->RenderQuads(params, pts, changed);
+  if (!quads)
+    return nullptr;
 
   if(o->m_textureid)
   {
-    if(changes == 0)
+    if(!changed)
     {
       std::map<unsigned int, COverlay*>::iterator it = m_textureCache.find(o->m_textureid);
       if (it != m_textureCache.end())
@@ -398,9 +409,9 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
 
   COverlay *overlay = NULL;
 #if defined(HAS_GL) || defined(HAS_GLES)
-  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight);
+  overlay = new COverlayGlyphGL(*quads, targetWidth, targetHeight);
 #elif defined(HAS_DX)
-  overlay = new COverlayQuadsDX(images, targetWidth, targetHeight);
+  overlay = new COverlayQuadsDX(*quads, targetWidth, targetHeight);
 #endif
   // scale to video dimensions
   if (overlay)
@@ -0,0 +1,460 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DecodeBenchmark.h"
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "cores/VideoPlayer/DVDCodecs/Audio/DVDAudioCodec.h"
+#include "cores/VideoPlayer/DVDCodecs/DVDFactoryCodec.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemux.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDFactoryDemuxer.h"
+#include "cores/VideoPlayer/DVDInputStreams/DVDFactoryInputStream.h"
+#include "cores/VideoPlayer/DVDInputStreams/DVDInputStream.h"
+#include "cores/VideoPlayer/DVDMessage.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/DVDStreamInfo.h"
+#include "cores/VideoPlayer/Process/ProcessInfo.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/Thread.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <memory>
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XTimeUtils.h"
+#endif
+
+namespace
+{
+
+int64_t ElapsedUs(int64_t start, int64_t end)
+{
+  return (end - start) * 1000000 / CurrentHostFrequency();
+}
+
+double ElapsedSeconds(int64_t start, int64_t end)
+{
+  return static_cast<double>(end - start) / CurrentHostFrequency();
+}
+
+class CBenchmarkPacketMsg : public CDVDMsgDemuxerPacket
+{
+public:
+  CBenchmarkPacketMsg(DemuxPacket* packet, int64_t queued)
+    : CDVDMsgDemuxerPacket(packet)
+    , m_queued(queued)
+  {}
+
+  int64_t m_queued;
+};
+
+class CDecodeWorker : public CThread
+{
+public:
+  CDecodeWorker(const char* name, DecodeBenchmarkStage &stage, int maxDataSize)
+    : CThread(name)
+    , m_queue(name)
+    , m_stage(stage)
+  {
+    m_queue.SetMaxDataSize(maxDataSize);
+    m_queue.SetMaxTimeSize(8.0);
+    m_queue.Init();
+  }
+
+  ~CDecodeWorker() override
+  {
+    m_queue.Abort();
+    StopThread();
+    m_queue.End();
+  }
+
+  CDVDMessageQueue m_queue;
+
+protected:
+  virtual void Decode(const DemuxPacket &packet) = 0;
+  virtual void Drain() = 0;
+
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      CDVDMsg* msg;
+      MsgQueueReturnCode ret = m_queue.Get(&msg, 1000);
+      if (MSGQ_IS_ERROR(ret))
+        break;
+      else if (ret == MSGQ_TIMEOUT)
+        continue;
+
+      if (msg->IsType(CDVDMsg::GENERAL_EOF))
+      {
+        int64_t start = CurrentHostCounter();
+        Drain();
+        m_stage.seconds += ElapsedSeconds(start, CurrentHostCounter());
+        msg->Release();
+        break;
+      }
+
+      if (msg->IsType(CDVDMsg::DEMUXER_PACKET))
+      {
+        CBenchmarkPacketMsg* packetMsg = static_cast<CBenchmarkPacketMsg*>(msg);
+        DemuxPacket* packet = packetMsg->GetPacket();
+
+        int64_t start = CurrentHostCounter();
+        m_stage.queueLatency.Add(ElapsedUs(packetMsg->m_queued, start));
+
+        Decode(*packet);
+
+        int64_t end = CurrentHostCounter();
+        m_stage.stageLatency.Add(ElapsedUs(start, end));
+        m_stage.seconds += ElapsedSeconds(start, end);
+        m_stage.packets++;
+        m_stage.bytes += packet->iSize;
+      }
+      msg->Release();
+    }
+  }
+
+  DecodeBenchmarkStage &m_stage;
+};
+
+class CVideoDecodeWorker : public CDecodeWorker
+{
+public:
+  CVideoDecodeWorker(DecodeBenchmarkStage &stage, CDVDVideoCodec* codec)
+    : CDecodeWorker("BenchVideo", stage, 40 * 1024 * 1024)
+    , m_codec(codec)
+  {}
+
+  ~CVideoDecodeWorker() override
+  {
+    m_picture.Reset();
+  }
+
+protected:
+  void Decode(const DemuxPacket &packet) override
+  {
+    bool added = false;
+    while (!added && !m_bStop)
+    {
+      added = m_codec->AddData(packet);
+      if (!ReceivePictures() && !added)
+        break;
+    }
+  }
+
+  void Drain() override
+  {
+    m_codec->SetCodecControl(DVD_CODEC_CTRL_DRAIN);
+    ReceivePictures();
+  }
+
+  // null renderer: count and release every picture
+  bool ReceivePictures()
+  {
+    bool gotPicture = false;
+    while (!m_bStop)
+    {
+      CDVDVideoCodec::VCReturn ret = m_codec->GetPicture(&m_picture);
+      if (ret == CDVDVideoCodec::VC_PICTURE)
+      {
+        m_stage.frames++;
+        gotPicture = true;
+        m_picture.Reset();
+      }
+      else if (ret != CDVDVideoCodec::VC_NONE)
+        break;
+    }
+    return gotPicture;
+  }
+
+  CDVDVideoCodec* m_codec;
+  VideoPicture m_picture = {};
+};
+
+class CAudioDecodeWorker : public CDecodeWorker
+{
+public:
+  CAudioDecodeWorker(DecodeBenchmarkStage &stage, CDVDAudioCodec* codec)
+    : CDecodeWorker("BenchAudio", stage, 6 * 1024 * 1024)
+    , m_codec(codec)
+  {}
+
+protected:
+  void Decode(const DemuxPacket &packet) override
+  {
+    m_codec->AddData(packet);
+    ReceiveFrames();
+  }
+
+  void Drain() override
+  {
+    ReceiveFrames();
+  }
+
+  // null audio sink: count and drop decoded samples
+  void ReceiveFrames()
+  {
+    DVDAudioFrame frame;
+    while (!m_bStop)
+    {
+      frame.hasDownmix = false;
+      m_codec->GetData(frame);
+      if (frame.nb_frames == 0)
+        break;
+      m_stage.frames += frame.nb_frames;
+    }
+  }
+
+  CDVDAudioCodec* m_codec;
+};
+
+void SampleLevel(DecodeBenchmarkStage &stage, const CDVDMessageQueue &queue)
+{
+  int level = queue.GetLevel();
+  stage.levelSamples++;
+  stage.levelSum += level;
+  if (level > stage.levelMax)
+    stage.levelMax = level;
+}
+
+std::string StageReport(const char* name, const DecodeBenchmarkStage &stage, double wallSeconds,
+                        const char* unit)
+{
+  std::string report = StringUtils::Format("%-6s packets: %llu, %.2f MB, %llu %s, busy %.2fs",
+                                           name,
+                                           static_cast<unsigned long long>(stage.packets),
+                                           stage.bytes / (1024.0 * 1024.0),
+                                           static_cast<unsigned long long>(stage.frames),
+                                           unit, stage.seconds);
+  if (wallSeconds > 0.0)
+    report += StringUtils::Format(", %.1f %s/s", stage.frames / wallSeconds, unit);
+  report += "\n";
+
+  if (stage.levelSamples)
+    report += StringUtils::Format("       queue level: avg %.1f%%, max %d%%\n",
+                                  static_cast<double>(stage.levelSum) / stage.levelSamples,
+                                  stage.levelMax);
+
+  const CLatencyHistogram* histograms[] = { &stage.queueLatency, &stage.stageLatency };
+  const char* labels[] = { "queue", "stage" };
+  for (int i = 0; i < 2; i++)
+  {
+    const CLatencyHistogram &histogram = *histograms[i];
+    if (!histogram.Count())
+      continue;
+
+    report += StringUtils::Format("       %s latency us: mean %.1f, p50 %lld, p90 %lld, p99 %lld, max %lld\n",
+                                  labels[i], histogram.Mean(),
+                                  static_cast<long long>(histogram.Percentile(50)),
+                                  static_cast<long long>(histogram.Percentile(90)),
+                                  static_cast<long long>(histogram.Percentile(99)),
+                                  static_cast<long long>(histogram.Max()));
+  }
+  return report;
+}
+
+}
+
+CDecodeBenchmark::CDecodeBenchmark(const DecodeBenchmarkOptions &options)
+  : m_options(options)
+{
+}
+
+bool CDecodeBenchmark::Run(const std::string &file, DecodeBenchmarkResult &result)
+{
+  result = DecodeBenchmarkResult();
+  result.file = file;
+
+  CFileItem item(file, false);
+  item.SetMimeTypeForInternetFile();
+  std::shared_ptr<CDVDInputStream> inputStream = CDVDFactoryInputStream::CreateInputStream(nullptr, item);
+  if (!inputStream || !inputStream->Open())
+  {
+    CLog::Log(LOGERROR, "CDecodeBenchmark::Run - unable to open input stream for %s", file.c_str());
+    return false;
+  }
+
+  std::unique_ptr<CDVDDemux> demuxer(CDVDFactoryDemuxer::CreateDemuxer(inputStream));
+  if (!demuxer)
+  {
+    CLog::Log(LOGERROR, "CDecodeBenchmark::Run - unable to create demuxer for %s", file.c_str());
+    return false;
+  }
+
+  CDemuxStream* videoStream = nullptr;
+  CDemuxStream* audioStream = nullptr;
+  for (CDemuxStream* stream : demuxer->GetStreams())
+  {
+    if (m_options.video && !videoStream && stream->type == STREAM_VIDEO &&
+        !(stream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      videoStream = stream;
+    else if (m_options.audio && !audioStream && stream->type == STREAM_AUDIO)
+      audioStream = stream;
+    else
+      demuxer->EnableStream(stream->demuxerId, stream->uniqueId, false);
+  }
+
+  // apply the threading override as a catch all rule in front of the user rules
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  std::vector<VideoDecoderThreadingRule> savedRules = advancedSettings->m_videoDecoderThreadingRules;
+  if (!m_options.threadType.empty() || m_options.threads > 0)
+  {
+    VideoDecoderThreadingRule rule;
+    rule.type = m_options.threadType;
+    rule.threads = m_options.threads;
+    advancedSettings->m_videoDecoderThreadingRules.insert(advancedSettings->m_videoDecoderThreadingRules.begin(), rule);
+  }
+
+  std::unique_ptr<CProcessInfo> processInfo(CProcessInfo::CreateInstance());
+  std::vector<AVPixelFormat> pixFormats = { AV_PIX_FMT_YUV420P, AV_PIX_FMT_YUV420P9, AV_PIX_FMT_YUV420P10,
+                                            AV_PIX_FMT_YUV420P12, AV_PIX_FMT_YUV420P14, AV_PIX_FMT_YUV420P16,
+                                            AV_PIX_FMT_NV12, AV_PIX_FMT_YUYV422, AV_PIX_FMT_UYVY422 };
+  processInfo->SetPixFormats(pixFormats);
+  processInfo->SetInputRealtime(inputStream->IsRealtime());
+
+  std::unique_ptr<CDVDVideoCodec> videoCodec;
+  std::unique_ptr<CDVDAudioCodec> audioCodec;
+  if (videoStream)
+  {
+    CDVDStreamInfo hint(*videoStream, true);
+    videoCodec.reset(CDVDFactoryCodec::CreateVideoCodec(hint, *processInfo));
+    if (videoCodec)
+    {
+      // no hw accels are registered headless, skip the single threaded
+      // probing pass and reopen straight into software decoding
+      videoCodec->Reopen();
+      result.videoDecoder = videoCodec->GetName();
+      result.threading = StringUtils::Format("%s (%d)", processInfo->GetVideoDecoderThreadType().c_str(),
+                                             processInfo->GetVideoDecoderThreads());
+    }
+  }
+  if (audioStream)
+  {
+    CDVDStreamInfo hint(*audioStream, true);
+    audioCodec.reset(CDVDFactoryCodec::CreateAudioCodec(hint, *processInfo, false, false,
+                                                        CAEStreamInfo::STREAM_TYPE_NULL));
+    if (audioCodec)
+      result.audioDecoder = audioCodec->GetName();
+  }
+
+  advancedSettings->m_videoDecoderThreadingRules = savedRules;
+
+  if (!videoCodec && !audioCodec)
+  {
+    CLog::Log(LOGERROR, "CDecodeBenchmark::Run - no decodable streams in %s", file.c_str());
+    return false;
+  }
+
+  std::unique_ptr<CVideoDecodeWorker> videoWorker;
+  std::unique_ptr<CAudioDecodeWorker> audioWorker;
+  if (videoCodec)
+  {
+    videoWorker.reset(new CVideoDecodeWorker(result.video, videoCodec.get()));
+    videoWorker->Create();
+  }
+  if (audioCodec)
+  {
+    audioWorker.reset(new CAudioDecodeWorker(result.audio, audioCodec.get()));
+    audioWorker->Create();
+  }
+
+  int64_t start = CurrentHostCounter();
+  int64_t limit = static_cast<int64_t>(m_options.maxSeconds * CurrentHostFrequency());
+  int emptyReads = 0;
+
+  while (true)
+  {
+    int64_t readStart = CurrentHostCounter();
+    if (limit > 0 && readStart - start > limit)
+      break;
+
+    DemuxPacket* packet = demuxer->Read();
+    int64_t readEnd = CurrentHostCounter();
+
+    if (!packet)
+    {
+      if (inputStream->IsEOF() || ++emptyReads > 100)
+        break;
+      continue;
+    }
+    emptyReads = 0;
+
+    result.demux.stageLatency.Add(ElapsedUs(readStart, readEnd));
+    result.demux.seconds += ElapsedSeconds(readStart, readEnd);
+    result.demux.packets++;
+    result.demux.frames++;
+    result.demux.bytes += packet->iSize;
+
+    CDecodeWorker* worker = nullptr;
+    DecodeBenchmarkStage* stage = nullptr;
+    if (videoWorker && packet->iStreamId == videoStream->uniqueId && packet->demuxerId == videoStream->demuxerId)
+    {
+      worker = videoWorker.get();
+      stage = &result.video;
+    }
+    else if (audioWorker && packet->iStreamId == audioStream->uniqueId && packet->demuxerId == audioStream->demuxerId)
+    {
+      worker = audioWorker.get();
+      stage = &result.audio;
+    }
+
+    if (!worker)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      continue;
+    }
+
+    // block like VideoPlayer does when the decoder can't keep up
+    while (worker->m_queue.IsFull() && worker->IsRunning())
+      Sleep(1);
+
+    SampleLevel(*stage, worker->m_queue);
+    worker->m_queue.Put(new CBenchmarkPacketMsg(packet, CurrentHostCounter()));
+  }
+
+  if (videoWorker)
+    videoWorker->m_queue.Put(new CDVDMsg(CDVDMsg::GENERAL_EOF));
+  if (audioWorker)
+    audioWorker->m_queue.Put(new CDVDMsg(CDVDMsg::GENERAL_EOF));
+
+  if (videoWorker)
+    videoWorker->WaitForThreadExit(0xFFFFFFFF);
+  if (audioWorker)
+    audioWorker->WaitForThreadExit(0xFFFFFFFF);
+
+  result.wallSeconds = ElapsedSeconds(start, CurrentHostCounter());
+
+  videoWorker.reset();
+  audioWorker.reset();
+
+  return true;
+}
+
+std::string CDecodeBenchmark::Report(const DecodeBenchmarkResult &result)
+{
+  std::string report = StringUtils::Format("%s\n", result.file.c_str());
+  if (!result.videoDecoder.empty())
+    report += StringUtils::Format("  video decoder: %s, threading: %s\n",
+                                  result.videoDecoder.c_str(), result.threading.c_str());
+  if (!result.audioDecoder.empty())
+    report += StringUtils::Format("  audio decoder: %s\n", result.audioDecoder.c_str());
+  report += StringUtils::Format("  wall time: %.3fs\n", result.wallSeconds);
+
+  report += "  " + StageReport("demux", result.demux, result.wallSeconds, "packets");
+  if (!result.videoDecoder.empty())
+    report += "  " + StageReport("video", result.video, result.wallSeconds, "frames");
+  if (!result.audioDecoder.empty())
+    report += "  " + StageReport("audio", result.audio, result.wallSeconds, "samples");
+
+  return report;
+}
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "LatencyHistogram.h"
+
+#include <string>
+#include <stdint.h>
+
+struct DecodeBenchmarkOptions
+{
+  bool video = true;
+  bool audio = true;
+  double maxSeconds = 0.0;   //!< stop after this much wall clock time, 0 for the whole file
+  std::string threadType;    //!< override the decoder threading policy (auto, frame, slice, none)
+  int threads = 0;           //!< override the decoder thread count, 0 keeps the policy default
+};
+
+struct DecodeBenchmarkStage
+{
+  uint64_t packets = 0;
+  uint64_t bytes = 0;
+  uint64_t frames = 0;       //!< decoded pictures or audio frames
+  double seconds = 0.0;      //!< time spent inside the stage
+  CLatencyHistogram queueLatency;   //!< time a packet spent in the message queue
+  CLatencyHistogram stageLatency;   //!< time spent reading or decoding one packet
+  uint64_t levelSamples = 0;
+  uint64_t levelSum = 0;
+  int levelMax = 0;
+};
+
+struct DecodeBenchmarkResult
+{
+  std::string file;
+  std::string videoDecoder;
+  std::string audioDecoder;
+  std::string threading;
+  double wallSeconds = 0.0;
+  DecodeBenchmarkStage demux;
+  DecodeBenchmarkStage video;
+  DecodeBenchmarkStage audio;
+};
+
+/*!
+ * \brief Runs the VideoPlayer demux and decode path without renderer and audio sink.
+ *
+ * The input stream and demuxer run on the calling thread and feed one message
+ * queue per decoder, as VideoPlayer does. Video and audio decode on their own
+ * threads and discard their output, so playback runs at unlimited speed.
+ */
+class CDecodeBenchmark
+{
+public:
+  explicit CDecodeBenchmark(const DecodeBenchmarkOptions &options);
+
+  bool Run(const std::string &file, DecodeBenchmarkResult &result);
+
+  static std::string Report(const DecodeBenchmarkResult &result);
+
+private:
+  DecodeBenchmarkOptions m_options;
+};
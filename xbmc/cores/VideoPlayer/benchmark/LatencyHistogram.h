@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <stdint.h>
+
+/*!
+ * \brief Log2 bucketed histogram of latencies in microseconds.
+ *
+ * Not thread safe, every pipeline stage owns its histograms and they are
+ * only read once the stage has stopped.
+ */
+class CLatencyHistogram
+{
+public:
+  static const int BUCKETS = 32;
+
+  void Add(int64_t us)
+  {
+    if (us < 0)
+      us = 0;
+
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (int64_t(1) << bucket) <= us)
+      bucket++;
+
+    m_buckets[bucket]++;
+    m_count++;
+    m_sum += us;
+    if (us > m_max)
+      m_max = us;
+  }
+
+  uint64_t Count() const { return m_count; }
+  int64_t Max() const { return m_max; }
+  double Mean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+  /*!
+   * \brief Upper bound of the bucket holding the given percentile
+   * \param percentile value between 0 and 100
+   */
+  int64_t Percentile(double percentile) const
+  {
+    if (!m_count)
+      return 0;
+
+    uint64_t target = static_cast<uint64_t>(m_count * percentile / 100.0);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+      seen += m_buckets[i];
+      if (seen > target)
+        return int64_t(1) << i;
+    }
+    return m_max;
+  }
+
+  const std::array<uint64_t, BUCKETS>& Buckets() const { return m_buckets; }
+
+private:
+  std::array<uint64_t, BUCKETS> m_buckets = {};
+  uint64_t m_count = 0;
+  int64_t m_sum = 0;
+  int64_t m_max = 0;
+};
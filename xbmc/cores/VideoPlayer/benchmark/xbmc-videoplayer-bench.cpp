@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DecodeBenchmark.h"
+#include "test/TestBasicEnvironment.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void PrintUsage(const char* name)
+{
+  printf("Usage: %s [options] file...\n"
+         "Decode files through the VideoPlayer pipeline without rendering.\n\n"
+         "  --novideo          don't decode video\n"
+         "  --noaudio          don't decode audio\n"
+         "  --seconds <n>      stop each run after n seconds\n"
+         "  --threadtype <t>   video decoder threading: auto, frame, slice or none\n"
+         "  --threads <n>      video decoder thread count\n"
+         "  --policies         run every threading type for each file\n", name);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+  DecodeBenchmarkOptions options;
+  std::vector<std::string> files;
+  bool allPolicies = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--novideo") == 0)
+      options.video = false;
+    else if (strcmp(argv[i], "--noaudio") == 0)
+      options.audio = false;
+    else if (strcmp(argv[i], "--policies") == 0)
+      allPolicies = true;
+    else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+      options.maxSeconds = atof(argv[++i]);
+    else if (strcmp(argv[i], "--threadtype") == 0 && i + 1 < argc)
+      options.threadType = argv[++i];
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+      options.threads = atoi(argv[++i]);
+    else if (argv[i][0] == '-')
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    else
+      files.push_back(argv[i]);
+  }
+
+  if (files.empty())
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> policies;
+  if (allPolicies)
+    policies = { "none", "slice", "frame", "auto" };
+  else
+    policies.push_back(options.threadType);
+
+  TestBasicEnvironment environment;
+  environment.SetUp();
+
+  int ret = EXIT_SUCCESS;
+  for (const auto &file : files)
+  {
+    for (const auto &policy : policies)
+    {
+      options.threadType = policy;
+      CDecodeBenchmark benchmark(options);
+      DecodeBenchmarkResult result;
+      if (!benchmark.Run(file, result))
+      {
+        fprintf(stderr, "Unable to decode %s\n", file.c_str());
+        ret = EXIT_FAILURE;
+        break;
+      }
+      printf("%s\n", CDecodeBenchmark::Report(result).c_str());
+    }
+  }
+
+  environment.TearDown();
+
+  return ret;
+}
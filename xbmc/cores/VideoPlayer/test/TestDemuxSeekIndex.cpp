@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxSeekIndex.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestDemuxSeekIndex, Add)
+{
+  CDemuxSeekIndex index;
+  EXPECT_FALSE(index.IsModified());
+
+  index.Add(0, 0);
+  index.Add(500, 1000);
+  index.Add(10000, 200000);
+  index.Add(4000, 80000);
+  index.Add(-1, 0);
+  EXPECT_EQ(3u, index.Size());
+  EXPECT_TRUE(index.IsModified());
+
+  index.Clear();
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_FALSE(index.IsModified());
+}
+
+TEST(TestDemuxSeekIndex, Find)
+{
+  CDemuxSeekIndex index;
+  CDemuxSeekIndex::Entry entry;
+  EXPECT_FALSE(index.Find(0, true, entry));
+
+  index.Add(2000, 4000);
+  index.Add(6000, 12000);
+  index.Add(20000, 40000);
+
+  EXPECT_TRUE(index.Find(5000, true, entry));
+  EXPECT_EQ(2000, entry.time);
+  EXPECT_EQ(4000, entry.pos);
+
+  EXPECT_TRUE(index.Find(5000, false, entry));
+  EXPECT_EQ(6000, entry.time);
+
+  EXPECT_TRUE(index.Find(6000, true, entry));
+  EXPECT_EQ(6000, entry.time);
+
+  EXPECT_FALSE(index.Find(1000, true, entry));
+  EXPECT_FALSE(index.Find(13000, true, entry));
+  EXPECT_FALSE(index.Find(13000, false, entry));
+  EXPECT_FALSE(index.Find(30000, false, entry));
+}
+
+TEST(TestDemuxSeekIndex, Serialize)
+{
+  CDemuxSeekIndex index;
+  index.Add(0, 188);
+  index.Add(2500, 1000000);
+  index.Add(5000, 900000);
+  index.Add(3600000, 4000000000LL);
+
+  CDemuxSeekIndex loaded;
+  ASSERT_TRUE(loaded.Deserialize(index.Serialize()));
+  EXPECT_EQ(index.Size(), loaded.Size());
+  EXPECT_FALSE(loaded.IsModified());
+
+  CDemuxSeekIndex::Entry entry;
+  EXPECT_TRUE(loaded.Find(5000, true, entry));
+  EXPECT_EQ(900000, entry.pos);
+  EXPECT_TRUE(loaded.Find(3600000, true, entry));
+  EXPECT_EQ(4000000000LL, entry.pos);
+
+  EXPECT_FALSE(loaded.Deserialize(""));
+  EXPECT_FALSE(loaded.Deserialize("invalid"));
+  EXPECT_EQ(0u, loaded.Size());
+}
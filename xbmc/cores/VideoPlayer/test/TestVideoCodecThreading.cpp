@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodecThreading.h"
+#include "settings/AdvancedSettings.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestVideoCodecThreading, DefaultPolicy)
+{
+  std::vector<VideoDecoderThreadingRule> rules;
+
+  VideoThreadingPolicy policy = CVideoCodecThreading::Resolve("h264", 1080, false, 4, rules, 16);
+  EXPECT_EQ(VideoThreadType::AUTO, policy.type);
+  EXPECT_EQ(6, policy.threads);
+
+  policy = CVideoCodecThreading::Resolve("h264", 1080, false, 32, rules, 16);
+  EXPECT_EQ(16, policy.threads);
+
+  policy = CVideoCodecThreading::Resolve("h264", 1080, false, 32, rules, 0);
+  EXPECT_EQ(48, policy.threads);
+}
+
+TEST(TestVideoCodecThreading, RuleMatching)
+{
+  std::vector<VideoDecoderThreadingRule> rules;
+
+  VideoDecoderThreadingRule live;
+  live.source = VideoDecoderThreadingRule::SOURCE_LIVE;
+  live.type = "slice";
+  live.maxThreads = 4;
+  rules.push_back(live);
+
+  VideoDecoderThreadingRule uhd;
+  uhd.codec = "hevc";
+  uhd.minHeight = 1440;
+  uhd.type = "frame";
+  uhd.threads = 24;
+  rules.push_back(uhd);
+
+  VideoThreadingPolicy policy = CVideoCodecThreading::Resolve("h264", 1080, true, 8, rules, 16);
+  EXPECT_EQ(VideoThreadType::SLICE, policy.type);
+  EXPECT_EQ(4, policy.threads);
+
+  policy = CVideoCodecThreading::Resolve("HEVC", 2160, false, 8, rules, 32);
+  EXPECT_EQ(VideoThreadType::FRAME, policy.type);
+  EXPECT_EQ(24, policy.threads);
+
+  policy = CVideoCodecThreading::Resolve("hevc", 1080, false, 8, rules, 16);
+  EXPECT_EQ(VideoThreadType::AUTO, policy.type);
+  EXPECT_EQ(12, policy.threads);
+}
+
+TEST(TestVideoCodecThreading, SingleThread)
+{
+  std::vector<VideoDecoderThreadingRule> rules;
+
+  VideoDecoderThreadingRule none;
+  none.codec = "mpeg2video";
+  none.type = "none";
+  rules.push_back(none);
+
+  VideoThreadingPolicy policy = CVideoCodecThreading::Resolve("mpeg2video", 576, false, 8, rules, 16);
+  EXPECT_EQ(VideoThreadType::NONE, policy.type);
+  EXPECT_EQ(1, policy.threads);
+
+  policy = CVideoCodecThreading::Resolve("h264", 576, false, 8, rules, 1);
+  EXPECT_EQ(VideoThreadType::NONE, policy.type);
+  EXPECT_EQ(1, policy.threads);
+}
@@ -18,6 +18,9 @@
 #include "DatabaseManager.h"
 #include "DbUrl.h"
 #include "ServiceBroker.h"
+#include "threads/SingleLock.h"
+
+#include <map>
 
 #if defined(HAS_MYSQL) || defined(HAS_MARIADB)
 #include "mysqldataset.h"
@@ -31,6 +34,18 @@ using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
 
+namespace
+{
+CCriticalSection changeCountersSection;
+std::map<std::string, std::atomic<unsigned int>> changeCounters; //!< changes made to each kind of database
+
+std::atomic<unsigned int>& GetChangeCounter(const std::string& baseName)
+{
+  CSingleLock lock(changeCountersSection);
+  return changeCounters[baseName];
+}
+}
+
 void CDatabase::Filter::AppendField(const std::string &strField)
 {
   if (strField.empty())
@@ -522,6 +537,8 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
                    dbSettings.ciphers.c_str(),
                    dbSettings.compression);
 
+  m_pDB->setChangeCounter(&GetChangeCounter(GetBaseDBName()));
+
   // create the datasets
   m_pDS.reset(m_pDB->CreateDataset());
   m_pDS2.reset(m_pDB->CreateDataset());
@@ -595,6 +612,8 @@ void CDatabase::Close()
 
   m_openCount = 0;
   m_multipleExecute = false;
+  m_batch = false;
+  m_savepoints = 0;
 
   if (NULL == m_pDB.get() ) return ;
   if (NULL != m_pDS.get()) m_pDS->close();
@@ -650,7 +669,12 @@ void CDatabase::BeginTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->start_transaction();
+    {
+      if (m_batch)
+        m_pDB->start_savepoint(StringUtils::Format("batch%u", ++m_savepoints));
+      else
+        m_pDB->start_transaction();
+    }
   }
   catch (...)
   {
@@ -663,7 +687,15 @@ bool CDatabase::CommitTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->commit_transaction();
+    {
+      if (m_batch)
+      {
+        if (m_savepoints > 0)
+          m_pDB->release_savepoint(StringUtils::Format("batch%u", m_savepoints--));
+      }
+      else
+        m_pDB->commit_transaction();
+    }
   }
   catch (...)
   {
@@ -678,7 +710,19 @@ void CDatabase::RollbackTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->rollback_transaction();
+    {
+      if (m_batch)
+      {
+        if (m_savepoints > 0)
+        {
+          const std::string savepoint = StringUtils::Format("batch%u", m_savepoints--);
+          m_pDB->rollback_savepoint(savepoint);
+          m_pDB->release_savepoint(savepoint);
+        }
+      }
+      else
+        m_pDB->rollback_transaction();
+    }
   }
   catch (...)
   {
@@ -686,9 +730,45 @@ void CDatabase::RollbackTransaction()
   }
 }
 
+void CDatabase::BeginBatch()
+{
+  if (m_batch)
+    return;
+
+  BeginTransaction();
+  m_batch = true;
+  m_savepoints = 0;
+}
+
+bool CDatabase::CommitBatch()
+{
+  if (!m_batch)
+    return false;
+
+  // unbalanced savepoints are released along with the transaction
+  m_batch = false;
+  m_savepoints = 0;
+  return CommitTransaction();
+}
+
+void CDatabase::RollbackBatch()
+{
+  if (!m_batch)
+    return;
+
+  m_batch = false;
+  m_savepoints = 0;
+  RollbackTransaction();
+}
+
+unsigned int CDatabase::GetChanges() const
+{
+  return GetChangeCounter(GetBaseDBName());
+}
+
 bool CDatabase::InTransaction()
 {
-  if (NULL != m_pDB.get()) return false;
+  if (NULL == m_pDB.get()) return false;
   return m_pDB->in_transaction();
 }
 
@@ -103,8 +103,44 @@ public:
 
   void BeginTransaction();
   virtual bool CommitTransaction();
-  void RollbackTransaction();
+  virtual void RollbackTransaction();
   bool InTransaction();
+
+  /*!
+   * @brief Group the transactions that follow into a single transaction, until
+   *        CommitBatch() or RollbackBatch() is called.
+   *        While a batch is open, BeginTransaction() sets a savepoint instead, so
+   *        RollbackTransaction() only undoes the changes since the matching
+   *        BeginTransaction().
+   * @sa CommitBatch, RollbackBatch
+   */
+  virtual void BeginBatch();
+
+  /*!
+   * @brief Commit the transaction of the batch.
+   * @return True if the batch was committed successfully, false otherwise.
+   */
+  bool CommitBatch();
+
+  /*!
+   * @brief Undo all changes made since BeginBatch().
+   */
+  void RollbackBatch();
+
+  /*!
+   * @return True if a batch is open, false otherwise.
+   */
+  bool InBatch() const { return m_batch; }
+
+  /*!
+   * @brief Get the number of changes made to this kind of database so far.
+   *        It increases whenever any connection of the process runs a statement
+   *        that may change the data or ends a transaction, so results of queries
+   *        can be reused as long as it's unchanged. The database needn't be open.
+   * @return The number of changes.
+   */
+  unsigned int GetChanges() const;
+
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -254,4 +290,7 @@ private:
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  bool m_batch = false;
+  unsigned int m_savepoints = 0; //!< number of transactions begun in the batch
 };
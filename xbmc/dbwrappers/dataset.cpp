@@ -11,6 +11,7 @@
  */
 
 #include "dataset.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 #include <cstring>
 #include <algorithm>
@@ -29,7 +30,8 @@ Database::Database():
   db(),
   login(),
   passwd(),
-  sequence_table("db_sequence")
+  sequence_table("db_sequence"),
+  changes(NULL)
 {
   active = false;	// No connection yet
   compression = false;
@@ -39,6 +41,21 @@ Database::~Database() {
   disconnect();		// Disconnect if connected to database
 }
 
+bool Database::changes_data(const std::string &sql) {
+  size_t pos = sql.find_first_not_of(" \t\r\n");
+  if (pos == std::string::npos)
+    return false;
+
+  // settings of the connection and queries leave the data alone
+  static const char *readOnly[] = { "PRAGMA", "SELECT", "SET " };
+  for (const char *statement : readOnly)
+  {
+    if (StringUtils::StartsWithNoCase(sql.c_str() + pos, statement))
+      return false;
+  }
+  return true;
+}
+
 int Database::connectFull(const char *newHost, const char *newPort, const char *newDb, const char *newLogin,
                           const char *newPasswd, const char *newKey, const char *newCert, const char *newCA,
                           const char *newCApath, const char *newCiphers, bool newCompression) {
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include "qry_dat.h"
+#include <atomic>
 #include <stdarg.h>
 
 namespace dbiplus {
@@ -54,6 +55,7 @@ protected:
     sequence_table, //Sequence table for nextid
     default_charset, //Default character set
     key, cert, ca, capath, ciphers; //SSL - Encryption info
+  std::atomic<unsigned int> *changes; //Changes made to the database, shared by its connections
 
 public:
 /* constructor */
@@ -125,12 +127,27 @@ public:
 
   virtual bool exists(void) { return false; }
 
+/* change tracking */
+/* sets the counter of the changes made to the database */
+  void setChangeCounter(std::atomic<unsigned int> *counter) { changes = counter; }
+/* counts a statement or transaction that may have changed the data */
+  void changed() { if (changes) ++(*changes); }
+/* whether a statement may change the data of the database */
+  static bool changes_data(const std::string &sql);
+
 /* virtual methods for transaction */
 
   virtual void start_transaction() {};
   virtual void commit_transaction() {};
   virtual void rollback_transaction() {};
 
+  /*! \brief Savepoints within the current transaction
+   \param name - name of the savepoint, unique within the transaction.
+   */
+  virtual void start_savepoint(const std::string &name) {};
+  virtual void release_savepoint(const std::string &name) {};
+  virtual void rollback_savepoint(const std::string &name) {};
+
 /* virtual methods for formatting */
 
   /*! \brief Prepare a SQL statement for execution or querying using C printf nomenclature.
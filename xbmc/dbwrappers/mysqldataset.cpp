@@ -519,6 +519,7 @@ void MysqlDatabase::commit_transaction() {
     mysql_autocommit(conn, true);
     CLog::Log(LOGDEBUG,"Mysql commit transaction");
     _in_transaction = false;
+    changed();
   }
 }
 
@@ -529,6 +530,32 @@ void MysqlDatabase::rollback_transaction() {
     mysql_autocommit(conn, true);
     CLog::Log(LOGDEBUG,"Mysql rollback transaction");
     _in_transaction = false;
+    changed();
+  }
+}
+
+void MysqlDatabase::start_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string qry = "SAVEPOINT " + name;
+    mysql_real_query(conn, qry.c_str(), qry.size());
+  }
+}
+
+void MysqlDatabase::release_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string qry = "RELEASE SAVEPOINT " + name;
+    mysql_real_query(conn, qry.c_str(), qry.size());
+  }
+}
+
+void MysqlDatabase::rollback_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string qry = "ROLLBACK TO SAVEPOINT " + name;
+    mysql_real_query(conn, qry.c_str(), qry.size());
+    changed();
   }
 }
 
@@ -1533,6 +1560,8 @@ int MysqlDataset::exec(const std::string &sql) {
   }
   else
   {
+    if (Database::changes_data(qry))
+      db->changed();
     //! @todo collect results and store in exec_res
     return res;
   }
@@ -71,6 +71,10 @@ public:
   void commit_transaction() override;
   void rollback_transaction() override;
 
+  void start_savepoint(const std::string &name) override;
+  void release_savepoint(const std::string &name) override;
+  void rollback_savepoint(const std::string &name) override;
+
 /* virtual methods for formatting */
   std::string vprepare(const char *format, va_list args) override;
 
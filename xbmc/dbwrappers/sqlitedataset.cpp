@@ -496,6 +496,7 @@ void SqliteDatabase::commit_transaction() {
   if (active) {
     sqlite3_exec(conn,"commit",NULL,NULL,NULL);
     _in_transaction = false;
+    changed();
   }
 }
 
@@ -503,6 +504,25 @@ void SqliteDatabase::rollback_transaction() {
   if (active) {
     sqlite3_exec(conn,"rollback",NULL,NULL,NULL);
     _in_transaction = false;
+    changed();
+  }
+}
+
+void SqliteDatabase::start_savepoint(const std::string &name) {
+  if (active)
+    sqlite3_exec(conn,("SAVEPOINT " + name).c_str(),NULL,NULL,NULL);
+}
+
+void SqliteDatabase::release_savepoint(const std::string &name) {
+  if (active)
+    sqlite3_exec(conn,("RELEASE SAVEPOINT " + name).c_str(),NULL,NULL,NULL);
+}
+
+void SqliteDatabase::rollback_savepoint(const std::string &name) {
+  if (active)
+  {
+    sqlite3_exec(conn,("ROLLBACK TO SAVEPOINT " + name).c_str(),NULL,NULL,NULL);
+    changed();
   }
 }
 
@@ -756,7 +776,11 @@ int SqliteDataset::exec(const std::string &sql) {
   }
 
   if((res = db->setErr(sqlite3_exec(handle(),qry.c_str(),&callback,&exec_res,&errmsg),qry.c_str())) == SQLITE_OK)
+  {
+    if (Database::changes_data(qry))
+      db->changed();
     return res;
+  }
   else
     {
       if (errmsg)
@@ -0,0 +1,529 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DirectoryManifest.h"
+#include "FileItem.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "filesystem/StackDirectory.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <ctime>
+
+#if defined(HAVE_INOTIFY)
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace XFILE;
+
+namespace
+{
+const char* MANIFEST_HEADER = "KODI-DIRECTORY-MANIFEST 3";
+// directories no scan looked at for this long are forgotten
+const int64_t MAX_UNSEEN_TIME = 90 * 24 * 60 * 60;
+
+// the manifest has a line per field, so line breaks in paths and settings are escaped
+std::string Escape(const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value)
+  {
+    if (c == '\\')
+      escaped += "\\\\";
+    else if (c == '\n')
+      escaped += "\\n";
+    else if (c == '\r')
+      escaped += "\\r";
+    else
+      escaped += c;
+  }
+  return escaped;
+}
+
+std::string Unescape(const std::string& value)
+{
+  std::string unescaped;
+  unescaped.reserve(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    if (value[i] == '\\' && i + 1 < value.size())
+    {
+      const char c = value[++i];
+      unescaped += c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+    }
+    else
+      unescaped += value[i];
+  }
+  return unescaped;
+}
+}
+
+namespace XFILE
+{
+#if defined(HAVE_INOTIFY)
+/*!
+ \brief Flags directories of a manifest as changed on inotify events
+ */
+class CChangeJournal : public CThread
+{
+public:
+  explicit CChangeJournal(CDirectoryManifest& manifest)
+    : CThread("ChangeJournal"),
+      m_manifest(manifest)
+  {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+      CLog::Log(LOGWARNING, "CChangeJournal: inotify not available (%d)", errno);
+    else
+      Create();
+  }
+
+  ~CChangeJournal() override
+  {
+    StopThread();
+    if (m_fd >= 0)
+      close(m_fd);
+  }
+
+  /*!
+   \brief Watch a directory for changes
+   \return true if changes of the directory are reported from now on
+   */
+  bool Watch(const std::string& directory)
+  {
+    if (m_fd < 0 || m_full || !URIUtils::IsHD(directory))
+      return false;
+
+    CSingleLock lock(m_section);
+    if (m_watched.find(directory) != m_watched.end())
+      return true;
+
+    const std::string path = CSpecialProtocol::TranslatePath(directory);
+    int wd = inotify_add_watch(m_fd, path.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                                   IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+    if (wd < 0)
+    {
+      if (errno == ENOSPC)
+      {
+        CLog::Log(LOGWARNING, "CChangeJournal: inotify watch limit reached, only the modification "
+                              "time of further directories is checked");
+        m_full = true;
+      }
+      return false;
+    }
+
+    m_watches[wd] = directory;
+    m_watched[directory] = wd;
+    return true;
+  }
+
+  void Unwatch(const std::string& directory)
+  {
+    CSingleLock lock(m_section);
+    auto it = m_watched.find(directory);
+    if (it == m_watched.end())
+      return;
+
+    inotify_rm_watch(m_fd, it->second);
+    m_watches.erase(it->second);
+    m_watched.erase(it);
+  }
+
+protected:
+  void Process() override
+  {
+    alignas(struct inotify_event) char buffer[4096];
+    while (!m_bStop)
+    {
+      struct pollfd pfd = { m_fd, POLLIN, 0 };
+      if (poll(&pfd, 1, 500) <= 0)
+        continue;
+
+      ssize_t len;
+      while ((len = read(m_fd, buffer, sizeof(buffer))) > 0)
+      {
+        for (char* p = buffer; p < buffer + len; )
+        {
+          const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+          p += sizeof(struct inotify_event) + event->len;
+
+          if (event->mask & IN_Q_OVERFLOW)
+          {
+            m_manifest.SetAllChanged();
+            continue;
+          }
+
+          std::string directory;
+          {
+            CSingleLock lock(m_section);
+            auto it = m_watches.find(event->wd);
+            if (it == m_watches.end())
+              continue;
+            directory = it->second;
+            if (event->mask & IN_IGNORED)
+            {
+              m_watched.erase(it->second);
+              m_watches.erase(it);
+            }
+          }
+          m_manifest.SetChanged(directory);
+        }
+      }
+    }
+  }
+
+private:
+  CDirectoryManifest& m_manifest;
+  CCriticalSection m_section;
+  int m_fd = -1;
+  bool m_full = false;
+  std::map<int, std::string> m_watches;
+  std::map<std::string, int> m_watched;
+};
+#else
+class CChangeJournal
+{
+public:
+  explicit CChangeJournal(CDirectoryManifest& manifest) {}
+  bool Watch(const std::string& directory) { return false; }
+  void Unwatch(const std::string& directory) {}
+};
+#endif
+}
+
+CDirectoryManifest::CDirectoryManifest(const std::string& file)
+  : m_file(file)
+{
+}
+
+CDirectoryManifest::~CDirectoryManifest()
+{
+  // stop the journal before the entries it updates go away
+  m_journal.reset();
+}
+
+bool CDirectoryManifest::IsSupported(const std::string& path)
+{
+  return (URIUtils::IsHD(path) || URIUtils::IsNfs(path)) && !URIUtils::IsOnDVD(path);
+}
+
+bool CDirectoryManifest::GetSignature(const std::string& directory, SEntry& entry)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(directory, &buffer) != 0)
+    return false;
+
+  entry.mtime = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+  entry.inode = buffer.st_ino;
+  entry.size = buffer.st_size;
+  return entry.mtime != 0;
+}
+
+bool CDirectoryManifest::GetSignature(const std::string& path, SFile& file)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return false;
+
+  file.path = path;
+  file.mtime = buffer.st_mtime;
+  file.size = buffer.st_size;
+  return true;
+}
+
+bool CDirectoryManifest::FilesUnchanged(const std::vector<SFile>& files)
+{
+  for (const auto& file : files)
+  {
+    SFile current;
+    if (!GetSignature(file.path, current) || current.mtime != file.mtime || current.size != file.size)
+      return false;
+  }
+  return true;
+}
+
+bool CDirectoryManifest::IsUnchanged(const std::string& directory, const std::string& settings, std::vector<std::string>& subDirectories)
+{
+  SEntry current;
+  if (!GetSignature(directory, current))
+  {
+    Remove(directory);
+    return false;
+  }
+
+  bool watched;
+  std::vector<SFile> files;
+  {
+    CSingleLock lock(m_section);
+    Load();
+
+    auto it = m_entries.find(directory);
+    if (it == m_entries.end())
+      return false;
+
+    SEntry& entry = it->second;
+    if (entry.changed || entry.settings != settings ||
+        entry.mtime != current.mtime || entry.inode != current.inode || entry.size != current.size)
+      return false;
+
+    if (entry.watched)
+    {
+      entry.seen = time(nullptr);
+      m_modified = true;
+      subDirectories = entry.subDirectories;
+      return true;
+    }
+
+    // nothing watched the files since they were recorded, e.g. while Kodi wasn't running. Watch
+    // before checking them, so a change made meanwhile isn't missed
+    watched = m_journal->Watch(directory);
+    files = entry.files;
+  }
+
+  if (!FilesUnchanged(files))
+    return false;
+
+  CSingleLock lock(m_section);
+  auto it = m_entries.find(directory);
+  if (it == m_entries.end() || it->second.changed)
+    return false;
+
+  SEntry& entry = it->second;
+  entry.watched = watched;
+  entry.seen = time(nullptr);
+  m_modified = true;
+  subDirectories = entry.subDirectories;
+  return true;
+}
+
+bool CDirectoryManifest::GetRecorded(const std::string& directory, std::vector<std::string>& files, std::vector<std::string>& subDirectories)
+{
+  CSingleLock lock(m_section);
+  Load();
+
+  auto it = m_entries.find(directory);
+  if (it == m_entries.end())
+    return false;
+
+  files.clear();
+  for (const auto& file : it->second.files)
+    files.push_back(file.path);
+  subDirectories = it->second.subDirectories;
+  return true;
+}
+
+void CDirectoryManifest::Update(const std::string& directory, const std::string& settings, const CFileItemList& items)
+{
+  SEntry entry;
+  if (!GetSignature(directory, entry))
+  {
+    Remove(directory);
+    return;
+  }
+  entry.settings = settings;
+  entry.seen = time(nullptr);
+
+  {
+    CSingleLock lock(m_section);
+    Load();
+
+    // watch before the files are recorded, so a change made meanwhile isn't missed
+    entry.watched = m_journal->Watch(directory);
+  }
+
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    const CFileItemPtr& item = items[i];
+    if (item->IsParentFolder())
+      continue;
+
+    if (item->m_bIsFolder)
+    {
+      if (!item->IsPlayList())
+        entry.subDirectories.push_back(item->GetPath());
+      continue;
+    }
+
+    std::vector<std::string> paths;
+    if (!item->IsStack() || !CStackDirectory::GetPaths(item->GetPath(), paths))
+      paths.push_back(item->GetPath());
+    for (const auto& path : paths)
+    {
+      SFile file;
+      if (GetSignature(path, file))
+        entry.files.push_back(std::move(file));
+    }
+  }
+
+  CSingleLock lock(m_section);
+  m_entries[directory] = std::move(entry);
+  m_modified = true;
+}
+
+void CDirectoryManifest::Remove(const std::string& directory)
+{
+  CSingleLock lock(m_section);
+  Load();
+
+  if (m_entries.erase(directory) > 0)
+  {
+    m_journal->Unwatch(directory);
+    m_modified = true;
+  }
+}
+
+void CDirectoryManifest::SetChanged(const std::string& directory)
+{
+  CSingleLock lock(m_section);
+  auto it = m_entries.find(directory);
+  if (it != m_entries.end() && !it->second.changed)
+  {
+    it->second.changed = true;
+    m_modified = true;
+  }
+}
+
+void CDirectoryManifest::SetAllChanged()
+{
+  CSingleLock lock(m_section);
+  for (auto& entry : m_entries)
+    entry.second.changed = true;
+  m_modified = true;
+}
+
+void CDirectoryManifest::Load()
+{
+  // the manifest follows the profile if it's stored in it
+  const std::string file = CSpecialProtocol::TranslatePath(m_file);
+  if (file == m_loadedFile)
+    return;
+
+  m_loadedFile = file;
+  m_entries.clear();
+  m_modified = false;
+  if (!m_journal)
+    m_journal.reset(new CChangeJournal(*this));
+
+  CFile manifest;
+  XUTILS::auto_buffer buffer;
+  if (manifest.LoadFile(m_loadedFile, buffer) <= 0)
+    return;
+
+  std::vector<std::string> lines = StringUtils::Split(std::string(buffer.get(), buffer.size()), '\n');
+  if (lines.empty() || lines[0] != MANIFEST_HEADER)
+  { // manifests of older versions are dropped as well, the next scan lists everything once
+    CLog::Log(LOGWARNING, "CDirectoryManifest: ignoring invalid manifest %s", m_loadedFile.c_str());
+    return;
+  }
+
+  SEntry* entry = nullptr;
+  for (size_t i = 1; i < lines.size(); i++)
+  {
+    const std::string& line = lines[i];
+    if (StringUtils::StartsWith(line, "D\t"))
+    {
+      // D <mtime> <inode> <size> <changed> <seen> <path>
+      std::vector<std::string> fields = StringUtils::Split(line, '\t', 7);
+      if (fields.size() != 7)
+      {
+        entry = nullptr;
+        continue;
+      }
+      entry = &m_entries[Unescape(fields[6])];
+      entry->mtime = strtoll(fields[1].c_str(), nullptr, 10);
+      entry->inode = strtoull(fields[2].c_str(), nullptr, 10);
+      entry->size = strtoll(fields[3].c_str(), nullptr, 10);
+      entry->changed = fields[4] == "1";
+      entry->seen = strtoll(fields[5].c_str(), nullptr, 10);
+    }
+    else if (StringUtils::StartsWith(line, "F\t") && entry)
+    {
+      // F <mtime> <size> <path>
+      std::vector<std::string> fields = StringUtils::Split(line, '\t', 4);
+      if (fields.size() != 4)
+        continue;
+      SFile file;
+      file.mtime = strtoll(fields[1].c_str(), nullptr, 10);
+      file.size = strtoll(fields[2].c_str(), nullptr, 10);
+      file.path = Unescape(fields[3]);
+      entry->files.push_back(std::move(file));
+    }
+    else if (StringUtils::StartsWith(line, "O\t") && entry)
+      entry->settings = Unescape(line.substr(2));
+    else if (StringUtils::StartsWith(line, "S\t") && entry)
+      entry->subDirectories.push_back(Unescape(line.substr(2)));
+  }
+
+  CLog::Log(LOGDEBUG, "CDirectoryManifest: loaded %u directories from %s",
+            static_cast<unsigned int>(m_entries.size()), m_loadedFile.c_str());
+}
+
+void CDirectoryManifest::Prune()
+{
+  // directories of removed sources or folders are never looked at again
+  const int64_t now = time(nullptr);
+  size_t pruned = 0;
+  for (auto it = m_entries.begin(); it != m_entries.end(); )
+  {
+    if (now - it->second.seen > MAX_UNSEEN_TIME)
+    {
+      m_journal->Unwatch(it->first);
+      it = m_entries.erase(it);
+      pruned++;
+    }
+    else
+      ++it;
+  }
+
+  if (pruned > 0)
+    CLog::Log(LOGDEBUG, "CDirectoryManifest: forgot %u directories no scan looked at recently",
+              static_cast<unsigned int>(pruned));
+}
+
+void CDirectoryManifest::Save()
+{
+  CSingleLock lock(m_section);
+  if (!m_modified || m_loadedFile.empty())
+    return;
+
+  Prune();
+
+  std::string data = MANIFEST_HEADER;
+  data += "\n";
+  for (const auto& it : m_entries)
+  {
+    const SEntry& entry = it.second;
+    data += StringUtils::Format("D\t%" PRId64 "\t%" PRIu64 "\t%" PRId64 "\t%d\t%" PRId64 "\t%s\n", entry.mtime,
+                                entry.inode, entry.size, entry.changed ? 1 : 0, entry.seen, Escape(it.first).c_str());
+    if (!entry.settings.empty())
+      data += "O\t" + Escape(entry.settings) + "\n";
+    for (const auto& subDirectory : entry.subDirectories)
+      data += "S\t" + Escape(subDirectory) + "\n";
+    for (const auto& file : entry.files)
+      data += StringUtils::Format("F\t%" PRId64 "\t%" PRId64 "\t", file.mtime, file.size) + Escape(file.path) + "\n";
+  }
+
+  CFile file;
+  if (!file.OpenForWrite(m_loadedFile, true) || file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGERROR, "CDirectoryManifest: failed to write %s", m_loadedFile.c_str());
+    return;
+  }
+  m_modified = false;
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CFileItemList;
+
+namespace XFILE
+{
+  class CChangeJournal;
+
+  /*!
+   \brief Persistent record of the directories seen by a library scan
+
+   For every scanned directory the manifest keeps its stat() signature
+   (modification time, inode and size), the size and modification time of its
+   files and its subdirectories. An incremental scan skips listing directories
+   whose signature didn't change and recurses into the recorded subdirectories
+   instead.
+
+   Changing a file in place doesn't touch the modification time of its
+   directory, so the files of a directory are checked as well. Where inotify is
+   available, recorded local directories are watched and flagged as changed on
+   any file event, and their files are only checked the first time in a
+   session. Directories not seen by a scan for a while are forgotten.
+   */
+  class CDirectoryManifest
+  {
+  public:
+    /*!
+     \param file the file the manifest is stored in, may contain special:// paths
+     */
+    explicit CDirectoryManifest(const std::string& file);
+    ~CDirectoryManifest();
+
+    /*! \brief Whether directories at path have a reliable signature (local disks and NFS)
+     */
+    static bool IsSupported(const std::string& path);
+
+    /*! \brief Check whether a directory is unchanged since it was last recorded
+     \param directory the directory to check
+     \param settings the scan settings of the directory, e.g. content and exclude expressions
+     \param subDirectories [out] the recorded subdirectories if unchanged
+     \return true if the directory doesn't need to be listed again
+     */
+    bool IsUnchanged(const std::string& directory, const std::string& settings, std::vector<std::string>& subDirectories);
+
+    /*! \brief Get what was recorded for a directory, without checking whether it changed
+     \param directory the directory
+     \param files [out] the recorded files
+     \param subDirectories [out] the recorded subdirectories
+     \return false if the directory isn't recorded
+     */
+    bool GetRecorded(const std::string& directory, std::vector<std::string>& files, std::vector<std::string>& subDirectories);
+
+    /*! \brief Record a directory after it has been scanned
+     \param directory the scanned directory
+     \param settings the scan settings the directory was scanned with
+     \param items the listing of the directory, folders are recorded as subdirectories
+     */
+    void Update(const std::string& directory, const std::string& settings, const CFileItemList& items);
+
+    /*! \brief Forget a directory, so that it is listed by the next scan
+     */
+    void Remove(const std::string& directory);
+
+    /*! \brief Write the manifest if it was modified
+     */
+    void Save();
+
+    /*! \brief Flag a recorded directory as changed, called by the change journal
+     */
+    void SetChanged(const std::string& directory);
+
+    /*! \brief Flag all recorded directories as changed
+     */
+    void SetAllChanged();
+
+  private:
+    CDirectoryManifest(const CDirectoryManifest&) = delete;
+    CDirectoryManifest& operator=(const CDirectoryManifest&) = delete;
+
+    struct SFile
+    {
+      std::string path;
+      int64_t mtime = 0;
+      int64_t size = 0;
+    };
+
+    struct SEntry
+    {
+      int64_t mtime = 0;
+      uint64_t inode = 0;
+      int64_t size = 0;
+      bool changed = false;
+      int64_t seen = 0; //!< when a scan last looked at the directory
+      bool watched = false; //!< the change journal saw all changes since the files were checked, not stored
+      std::string settings;
+      std::vector<std::string> subDirectories;
+      std::vector<SFile> files;
+    };
+
+    static bool GetSignature(const std::string& directory, SEntry& entry);
+    static bool GetSignature(const std::string& path, SFile& file);
+    static bool FilesUnchanged(const std::vector<SFile>& files);
+    void Load();
+    void Prune();
+
+    CCriticalSection m_section;
+    std::string m_file;
+    std::string m_loadedFile;
+    bool m_modified = false;
+    std::map<std::string, SEntry> m_entries;
+    std::unique_ptr<CChangeJournal> m_journal;
+  };
+}
@@ -11,11 +11,15 @@
 #include "SmartPlaylistDirectory.h"
 #include "FileItem.h"
 #include "ServiceBroker.h"
+#include "XBDateTime.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "filesystem/FileDirectoryFactory.h"
+#include "filesystem/SpecialProtocol.h"
 #include "music/MusicDatabase.h"
 #include "playlists/SmartPlayList.h"
+#include "playlists/SmartPlaylistCache.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/SortUtils.h"
@@ -49,6 +53,35 @@ namespace XFILE
   }
 
   bool CSmartPlaylistDirectory::GetDirectory(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir /* = "" */, bool filter /* = false */)
+  {
+    // random playlists change on every listing and other clients may change a shared database
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    std::string key;
+    if (!items.IsEmpty() || playlist.GetOrder() == SortByRandom ||
+        advancedSettings->m_databaseVideo.type == "mysql" || advancedSettings->m_databaseMusic.type == "mysql" ||
+        !playlist.SaveAsJson(key, true))
+      return GetDirectoryFromDatabase(playlist, items, strBaseDir, filter);
+
+    // the items depend on the profile and, with rules relative to the current date, on the day
+    key = StringUtils::Format("%s|%s|%s|%d|", CSpecialProtocol::TranslatePath("special://profile/").c_str(),
+                              CSpecialProtocol::TranslatePath("special://database/").c_str(),
+                              CDateTime::GetCurrentDateTime().GetAsDBDate().c_str(), filter) + strBaseDir + "|" + key;
+
+    // both only increase, so their sum changes whenever either database does
+    const unsigned int changes = CVideoDatabase().GetChanges() + CMusicDatabase().GetChanges();
+
+    bool result;
+    if (CSmartPlaylistCache::GetInstance().GetItems(key, changes, items, result))
+      return result;
+
+    result = GetDirectoryFromDatabase(playlist, items, strBaseDir, filter);
+    // placeholders are only filled in for lists that allow them
+    if (!items.GetPlaceholderLoader())
+      CSmartPlaylistCache::GetInstance().SetItems(key, changes, items, result);
+    return result;
+  }
+
+  bool CSmartPlaylistDirectory::GetDirectoryFromDatabase(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir, bool filter)
   {
     bool success = false, success2 = false;
     std::vector<std::string> virtualFolders;
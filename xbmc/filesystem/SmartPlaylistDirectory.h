@@ -28,5 +28,8 @@ namespace XFILE
     static bool GetDirectory(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir = "", bool filter = false);
 
     static std::string GetPlaylistByName(const std::string& name, const std::string& playlistType);
+
+  private:
+    static bool GetDirectoryFromDatabase(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir, bool filter);
   };
 }
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/DirectoryManifest.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "FileItem.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+static bool WriteFile(const std::string& path, const std::string& data)
+{
+  XFILE::CFile file;
+  return file.OpenForWrite(path, true) && file.Write(data.c_str(), data.size()) == static_cast<ssize_t>(data.size());
+}
+
+TEST(TestDirectoryManifest, FileRewrittenInPlace)
+{
+  std::string directory = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestDirectoryManifest");
+  URIUtils::AddSlashAtEnd(directory);
+  const std::string manifestFile = CSpecialProtocol::TranslatePath("special://temp/TestDirectoryManifest.txt");
+  const std::string path = URIUtils::AddFileToFolder(directory, "track.mp3");
+  ASSERT_TRUE(XFILE::CDirectory::Create(directory));
+  ASSERT_TRUE(WriteFile(path, "tags"));
+
+  CFileItemList items;
+  items.Add(CFileItemPtr(new CFileItem(path, false)));
+  std::vector<std::string> subDirectories;
+  {
+    XFILE::CDirectoryManifest manifest(manifestFile);
+    EXPECT_FALSE(manifest.IsUnchanged(directory, "", subDirectories));
+    manifest.Update(directory, "", items);
+    manifest.Save();
+  }
+
+  // a later session without any record of changes checks the files
+  {
+    XFILE::CDirectoryManifest manifest(manifestFile);
+    EXPECT_TRUE(manifest.IsUnchanged(directory, "", subDirectories));
+    EXPECT_FALSE(manifest.IsUnchanged(directory, "other settings", subDirectories));
+  }
+
+  // rewriting a file doesn't change the directory
+  ASSERT_TRUE(WriteFile(path, "retagged"));
+  {
+    XFILE::CDirectoryManifest manifest(manifestFile);
+    EXPECT_FALSE(manifest.IsUnchanged(directory, "", subDirectories));
+  }
+
+  EXPECT_TRUE(XFILE::CFile::Delete(manifestFile));
+  EXPECT_TRUE(XFILE::CDirectory::RemoveRecursive(directory));
+}
+
+TEST(TestDirectoryManifest, LineBreakInPath)
+{
+  std::string directory = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestDirectoryManifest");
+  URIUtils::AddSlashAtEnd(directory);
+  const std::string manifestFile = CSpecialProtocol::TranslatePath("special://temp/TestDirectoryManifest.txt");
+  const std::string path = URIUtils::AddFileToFolder(directory, "two\nlines\\.mp3");
+  const std::string subDirectory = URIUtils::AddFileToFolder(directory, "F\tsub\n/");
+  ASSERT_TRUE(XFILE::CDirectory::Create(directory));
+  ASSERT_TRUE(XFILE::CDirectory::Create(subDirectory));
+  ASSERT_TRUE(WriteFile(path, "tags"));
+
+  CFileItemList items;
+  items.Add(CFileItemPtr(new CFileItem(path, false)));
+  items.Add(CFileItemPtr(new CFileItem(subDirectory, true)));
+  {
+    XFILE::CDirectoryManifest manifest(manifestFile);
+    manifest.Update(directory, "", items);
+    manifest.Save();
+  }
+
+  std::vector<std::string> files;
+  std::vector<std::string> subDirectories;
+  XFILE::CDirectoryManifest manifest(manifestFile);
+  ASSERT_TRUE(manifest.GetRecorded(directory, files, subDirectories));
+  ASSERT_EQ(1u, files.size());
+  EXPECT_EQ(path, files[0]);
+  ASSERT_EQ(1u, subDirectories.size());
+  EXPECT_EQ(subDirectory, subDirectories[0]);
+  EXPECT_TRUE(manifest.IsUnchanged(directory, "", subDirectories));
+
+  EXPECT_TRUE(XFILE::CFile::Delete(manifestFile));
+  EXPECT_TRUE(XFILE::CDirectory::RemoveRecursive(directory));
+}
@@ -8,8 +8,30 @@
 
 #include "DirtyRegionSolvers.h"
 #include "windowing/GraphicContext.h"
+#include <algorithm>
 #include <stdio.h>
 
+namespace
+{
+// defaults until enough frames are measured, about what a low end device takes
+const float DEFAULT_PASS_COST = 0.5f;
+const float DEFAULT_AREA_COST = 1.0f;
+const unsigned int MIN_SAMPLES = 30;
+// weight of the previous frames, the fit follows the last few hundred frames
+const double SAMPLE_DECAY = 0.99;
+// fitted costs outside of these are measuring noise
+const float MIN_COST = 0.001f;
+const float MAX_PASS_COST = 20.0f;
+const float MAX_AREA_COST = 100.0f;
+// more regions are first merged with the greedy solver to bound the solving time
+const size_t MAX_CLUSTER_REGIONS = 64;
+
+float Megapixels(const CRect &rect)
+{
+  return rect.Area() / 1000000.0f;
+}
+}
+
 void CUnionDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
 {
   CDirtyRegion unifiedRegion;
@@ -38,6 +60,12 @@ CGreedyDirtyRegionSolver::CGreedyDirtyRegionSolver()
   m_costPerArea   = 0.01f;
 }
 
+CGreedyDirtyRegionSolver::CGreedyDirtyRegionSolver(float costNewRegion, float costPerArea)
+{
+  m_costNewRegion = costNewRegion;
+  m_costPerArea   = costPerArea;
+}
+
 void CGreedyDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
 {
   for (unsigned int i = 0; i < input.size(); i++)
@@ -69,3 +97,120 @@ void CGreedyDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegion
       output.push_back(currentRegion);
   }
 }
+
+CDirtyRegionCostModel::CDirtyRegionCostModel()
+  : CDirtyRegionCostModel(DEFAULT_PASS_COST, DEFAULT_AREA_COST)
+{
+}
+
+CDirtyRegionCostModel::CDirtyRegionCostModel(float passCost, float areaCost)
+  : m_passCost(passCost),
+    m_areaCost(areaCost)
+{
+}
+
+void CDirtyRegionCostModel::AddSample(const CDirtyRegionList &regions, float renderTime)
+{
+  double passes = 0.0;
+  double area = 0.0;
+  for (const auto &region : regions)
+  {
+    if (region.IsEmpty())
+      continue;
+    passes += 1.0;
+    area += Megapixels(region);
+  }
+  if (passes == 0.0)
+    return;
+
+  m_passes2 = m_passes2 * SAMPLE_DECAY + passes * passes;
+  m_passesArea = m_passesArea * SAMPLE_DECAY + passes * area;
+  m_area2 = m_area2 * SAMPLE_DECAY + area * area;
+  m_passesTime = m_passesTime * SAMPLE_DECAY + passes * renderTime;
+  m_areaTime = m_areaTime * SAMPLE_DECAY + area * renderTime;
+  if (++m_samples < MIN_SAMPLES)
+    return;
+
+  // the costs can't be told apart while the number of passes and the area change together
+  const double det = m_passes2 * m_area2 - m_passesArea * m_passesArea;
+  if (det <= 1e-6 * m_passes2 * m_area2)
+    return;
+
+  const double passCost = (m_passesTime * m_area2 - m_areaTime * m_passesArea) / det;
+  const double areaCost = (m_areaTime * m_passes2 - m_passesTime * m_passesArea) / det;
+  m_passCost = std::min(std::max(static_cast<float>(passCost), MIN_COST), MAX_PASS_COST);
+  m_areaCost = std::min(std::max(static_cast<float>(areaCost), MIN_COST), MAX_AREA_COST);
+}
+
+float CDirtyRegionCostModel::GetCost(const CDirtyRegionList &regions) const
+{
+  float cost = 0.0f;
+  for (const auto &region : regions)
+  {
+    if (!region.IsEmpty())
+      cost += m_passCost + m_areaCost * Megapixels(region);
+  }
+  return cost;
+}
+
+CClusterDirtyRegionSolver::CClusterDirtyRegionSolver(const CDirtyRegionCostModel &costModel)
+  : m_costModel(costModel)
+{
+}
+
+void CClusterDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
+{
+  const float passCost = m_costModel.GetPassCost();
+  const float areaCost = m_costModel.GetAreaCost();
+
+  CDirtyRegionList clusters;
+  if (input.size() > MAX_CLUSTER_REGIONS)
+  {
+    CGreedyDirtyRegionSolver greedy(passCost, areaCost / 1000000.0f);
+    greedy.Solve(input, clusters);
+    if (clusters.size() > MAX_CLUSTER_REGIONS)
+    {
+      output.insert(output.end(), clusters.begin(), clusters.end());
+      return;
+    }
+  }
+  else
+  {
+    for (const auto &region : input)
+    {
+      if (!region.IsEmpty())
+        clusters.push_back(region);
+    }
+  }
+
+  while (clusters.size() > 1)
+  {
+    float bestSaving = 0.0f;
+    size_t bestFirst = 0;
+    size_t bestSecond = 0;
+    for (size_t i = 0; i < clusters.size(); i++)
+    {
+      for (size_t j = i + 1; j < clusters.size(); j++)
+      {
+        CRect merged = clusters[i];
+        merged.Union(clusters[j]);
+        // overlapping clusters are filled twice, so merging them may fill less
+        float saving = passCost - areaCost * (Megapixels(merged) - Megapixels(clusters[i]) - Megapixels(clusters[j]));
+        if (saving > bestSaving)
+        {
+          bestSaving = saving;
+          bestFirst = i;
+          bestSecond = j;
+        }
+      }
+    }
+    if (bestSaving <= 0.0f)
+      break;
+
+    clusters[bestFirst].Union(clusters[bestSecond]);
+    clusters[bestSecond] = clusters.back();
+    clusters.pop_back();
+  }
+
+  output.insert(output.end(), clusters.begin(), clusters.end());
+}
@@ -32,8 +32,69 @@ class CGreedyDirtyRegionSolver : public IDirtyRegionSolver
 {
 public:
   CGreedyDirtyRegionSolver();
+  CGreedyDirtyRegionSolver(float costNewRegion, float costPerArea);
   void Solve(const CDirtyRegionList &input, CDirtyRegionList &output) override;
 private:
   float m_costNewRegion;
   float m_costPerArea;
 };
+
+/*!
+ \brief Estimates how long rendering dirty regions takes.
+
+ Every rendering pass has a fixed cost, as all visible controls are drawn clipped to the
+ region, and a cost for the area it fills. Both are fitted to the measured render times
+ with a least squares fit that favours the recent frames.
+ */
+class CDirtyRegionCostModel
+{
+public:
+  CDirtyRegionCostModel();
+  /*!
+   \param passCost the initial cost of a rendering pass in ms.
+   \param areaCost the initial cost of filling a megapixel in ms.
+   */
+  CDirtyRegionCostModel(float passCost, float areaCost);
+
+  /*!
+   \brief Add the measured time it took to render the given regions.
+   \param regions the regions rendered, one pass each.
+   \param renderTime the time it took in ms.
+   */
+  void AddSample(const CDirtyRegionList &regions, float renderTime);
+
+  //! the cost of a rendering pass in ms
+  float GetPassCost() const { return m_passCost; }
+  //! the cost of filling a megapixel in ms
+  float GetAreaCost() const { return m_areaCost; }
+  //! the estimated time in ms it takes to render the given regions
+  float GetCost(const CDirtyRegionList &regions) const;
+
+private:
+  float m_passCost;
+  float m_areaCost;
+
+  // decayed sums of the least squares fit
+  double m_passes2 = 0.0;
+  double m_passesArea = 0.0;
+  double m_area2 = 0.0;
+  double m_passesTime = 0.0;
+  double m_areaTime = 0.0;
+  unsigned int m_samples = 0;
+};
+
+/*!
+ \brief Clusters the dirty regions so that the estimated render time is the lowest.
+
+ Starting with a pass for every region, the two clusters whose merging saves the most time
+ are merged until no merge saves any more. Merging saves a pass, but fills the area between
+ the clusters as well.
+ */
+class CClusterDirtyRegionSolver : public IDirtyRegionSolver
+{
+public:
+  explicit CClusterDirtyRegionSolver(const CDirtyRegionCostModel &costModel);
+  void Solve(const CDirtyRegionList &input, CDirtyRegionList &output) override;
+private:
+  const CDirtyRegionCostModel &m_costModel;
+};
@@ -7,10 +7,14 @@
  */
 
 #include "DirtyRegionTracker.h"
+#include "filesystem/File.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
+#include "windowing/GraphicContext.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include "DirtyRegionSolvers.h"
 #include "ServiceBroker.h"
 
@@ -23,6 +27,8 @@ CDirtyRegionTracker::CDirtyRegionTracker(int buffering)
 CDirtyRegionTracker::~CDirtyRegionTracker()
 {
   delete m_solver;
+  if (m_recording)
+    m_recording->Close();
 }
 
 void CDirtyRegionTracker::SelectAlgorithm()
@@ -43,6 +49,10 @@ void CDirtyRegionTracker::SelectAlgorithm()
       m_solver = new CUnionDirtyRegionSolver();
       CLog::Log(LOGDEBUG, "guilib: Union as algorithm for solving rendering passes");
       break;
+    case DIRTYREGION_SOLVER_CLUSTER:
+      CLog::Log(LOGDEBUG, "guilib: Clustering by measured cost as algorithm for solving rendering passes");
+      m_solver = new CClusterDirtyRegionSolver(m_costModel);
+      break;
     case DIRTYREGION_SOLVER_FILL_VIEWPORT_ALWAYS:
     default:
       CLog::Log(LOGDEBUG, "guilib: Fill viewport always for solving rendering passes");
@@ -66,12 +76,29 @@ CDirtyRegionList CDirtyRegionTracker::GetDirtyRegions()
 {
   CDirtyRegionList output;
 
+  if (m_recording || CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiRecordDirtyRegions)
+    Record();
+
   if (m_solver)
     m_solver->Solve(m_markedRegions, output);
 
   return output;
 }
 
+void CDirtyRegionTracker::AddTimedRegions(const CDirtyRegionList &regions)
+{
+  m_timedRegions.push_back(regions);
+}
+
+void CDirtyRegionTracker::AddRenderTime(float renderTime)
+{
+  if (m_timedRegions.empty())
+    return;
+
+  m_costModel.AddSample(m_timedRegions.front(), renderTime);
+  m_timedRegions.pop_front();
+}
+
 void CDirtyRegionTracker::CleanMarkedRegions()
 {
   int buffering = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions ? 20 : m_buffering;
@@ -84,3 +111,63 @@ void CDirtyRegionTracker::CleanMarkedRegions()
     i--;
   }
 }
+
+std::string CDirtyRegionTracker::ToString(const CDirtyRegionList &regions)
+{
+  std::string line;
+  for (const auto &region : regions)
+  {
+    if (!line.empty())
+      line += " ";
+    line += StringUtils::Format("%g,%g,%g,%g", region.x1, region.y1, region.x2, region.y2);
+  }
+  return line;
+}
+
+CDirtyRegionList CDirtyRegionTracker::FromString(const std::string &line)
+{
+  CDirtyRegionList regions;
+  for (const auto &region : StringUtils::Split(line, ' '))
+  {
+    std::vector<std::string> coords = StringUtils::Split(region, ',');
+    if (coords.size() != 4)
+      continue;
+    regions.push_back(CDirtyRegion(static_cast<float>(atof(coords[0].c_str())),
+                                   static_cast<float>(atof(coords[1].c_str())),
+                                   static_cast<float>(atof(coords[2].c_str())),
+                                   static_cast<float>(atof(coords[3].c_str()))));
+  }
+  return regions;
+}
+
+void CDirtyRegionTracker::Record()
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiRecordDirtyRegions)
+  {
+    m_recording->Close();
+    m_recording.reset();
+    return;
+  }
+
+  if (!m_recording)
+  {
+    const std::string file = "special://temp/dirtyregions.txt";
+    m_recording.reset(new XFILE::CFile);
+    if (!m_recording->OpenForWrite(file, true))
+    {
+      CLog::Log(LOGERROR, "guilib: unable to record dirty regions to %s", file.c_str());
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiRecordDirtyRegions = false;
+      m_recording.reset();
+      return;
+    }
+    CLog::Log(LOGNOTICE, "guilib: recording dirty regions to %s", file.c_str());
+
+    CDirtyRegionList viewport;
+    viewport.push_back(CDirtyRegion(CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow()));
+    std::string header = "# viewport " + ToString(viewport) + "\n";
+    m_recording->Write(header.c_str(), header.size());
+  }
+
+  std::string line = ToString(m_markedRegions) + "\n";
+  m_recording->Write(line.c_str(), line.size());
+}
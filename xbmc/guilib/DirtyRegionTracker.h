@@ -8,8 +8,18 @@
 
 #pragma once
 
+#include "DirtyRegionSolvers.h"
 #include "IDirtyRegionSolver.h"
 
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace XFILE
+{
+  class CFile;
+}
+
 #if defined(TARGET_DARWIN_IOS)
 #define DEFAULT_BUFFERING 4
 #else
@@ -28,8 +38,34 @@ public:
   CDirtyRegionList GetDirtyRegions();
   void CleanMarkedRegions();
 
+  /*!
+   \brief Remember the dirty regions of a frame whose render time is being measured.
+   \param regions the dirty regions rendered.
+   \sa AddRenderTime
+   */
+  void AddTimedRegions(const CDirtyRegionList &regions);
+
+  /*!
+   \brief Add the measured time it took to render the oldest timed regions, see CDirtyRegionCostModel.
+   \param renderTime the time it took in ms.
+   */
+  void AddRenderTime(float renderTime);
+
+  /*!
+   \brief Format regions as a line of a recording. With <gui><recorddirtyregions> the
+   marked regions of every frame are recorded to special://temp/dirtyregions.txt,
+   to replay them through the solvers.
+   */
+  static std::string ToString(const CDirtyRegionList &regions);
+  static CDirtyRegionList FromString(const std::string &line);
+
 private:
+  void Record();
+
   CDirtyRegionList m_markedRegions;
   int m_buffering;
   IDirtyRegionSolver *m_solver;
+  CDirtyRegionCostModel m_costModel;
+  std::deque<CDirtyRegionList> m_timedRegions;
+  std::unique_ptr<XFILE::CFile> m_recording;
 };
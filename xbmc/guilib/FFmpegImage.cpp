@@ -147,8 +147,24 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
 
   av_frame_free(&m_pFrame);
   m_pFrame = ExtractFrame();
+  if (!m_pFrame)
+    return false;
 
-  return !(m_pFrame == nullptr);
+  // scale down to the ideal size on decode if asked to, the image still covers it
+  if (m_scaleOnDecode && width && height)
+  {
+    // exif orientations 5 to 8 rotate by 90 degrees
+    if (m_orientation >= 5)
+      std::swap(width, height);
+    float scale = std::max(width / static_cast<float>(m_originalWidth), height / static_cast<float>(m_originalHeight));
+    if (scale < 1.0f)
+    {
+      m_width = std::max(1u, static_cast<unsigned int>(m_originalWidth * scale + 0.5f));
+      m_height = std::max(1u, static_cast<unsigned int>(m_originalHeight * scale + 0.5f));
+    }
+  }
+
+  return true;
 }
 
 bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
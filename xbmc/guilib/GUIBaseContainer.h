@@ -13,6 +13,7 @@
 \brief
 */
 
+#include <memory>
 #include <utility>
 #include <vector>
 #include <list>
@@ -29,6 +30,7 @@
 class IListProvider;
 class TiXmlNode;
 class CGUIListItemLayout;
+class CPlaceholderLoader;
 
 class CGUIBaseContainer : public IGUIContainer
 {
@@ -127,6 +129,7 @@ protected:
   int ScrollCorrectionRange() const;
   inline float Size() const;
   void FreeMemory(int keepStart, int keepEnd);
+  void LoadPlaceholders(int first, int last);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -159,6 +162,7 @@ protected:
   CScroller m_scroller;
 
   IListProvider *m_listProvider;
+  std::shared_ptr<CPlaceholderLoader> m_placeholderLoader; ///< \brief fills in the placeholders of the bound items
 
   bool m_wasReset;  // true if we've received a Reset message until we've rendered once.  Allows
                     // us to make sure we don't tell the infomanager that we've been moving when
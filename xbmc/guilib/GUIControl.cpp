@@ -155,6 +155,15 @@ void CGUIControl::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyreg
   }
 }
 
+bool CGUIControl::HasOpaqueTransform() const
+{
+  // the render region is the bounding box of the transformed control
+  const TransformMatrix &transform = m_cachedTransform;
+  return transform.alpha >= 1.0f &&
+         transform.m[0][1] == 0.0f && transform.m[1][0] == 0.0f &&
+         transform.m[2][0] == 0.0f && transform.m[2][1] == 0.0f;
+}
+
 void CGUIControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   // update our render region
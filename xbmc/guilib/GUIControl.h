@@ -180,6 +180,11 @@ public:
   /*! \brief return the render region in screen coordinates of this control
    */
   const CRect &GetRenderRegion() const { return m_renderRegion; };
+  /*! \brief whether this control draws opaque pixels over all of the given region
+   Used to skip rendering windows that are hidden behind a dialog. Only valid once processed.
+   \param region the region in screen coordinates
+   */
+  virtual bool IsOpaque(const CRect &region) const { return false; };
   /*! \brief calculate the render region in parentcontrol coordinates of this control
    Called during process to update m_renderRegion
    */
@@ -320,6 +325,10 @@ protected:
   virtual bool UpdateColors();
   virtual bool Animate(unsigned int currentTime);
   virtual bool CheckAnimation(ANIMATION_TYPE animType);
+  /*! \brief whether the control is drawn without transparency and without rotation, so that
+   its render region is exactly the area it fills
+   */
+  bool HasOpaqueTransform() const;
   void UpdateStates(ANIMATION_TYPE type, ANIMATION_PROCESS currentProcess, ANIMATION_STATE currentState);
   bool SendWindowMessage(CGUIMessage &message) const;
 
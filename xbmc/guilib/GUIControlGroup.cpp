@@ -283,6 +283,20 @@ bool CGUIControlGroup::CanFocus() const
   return false;
 }
 
+bool CGUIControlGroup::IsOpaque(const CRect &region) const
+{
+  if (!IsVisible())
+    return false;
+
+  // the children are rendered above each other, so one opaque child is enough
+  for (auto *control : m_children)
+  {
+    if (control->IsOpaque(region))
+      return true;
+  }
+  return false;
+}
+
 void CGUIControlGroup::SetInitialVisibility()
 {
   CGUIControl::SetInitialVisibility();
@@ -11,6 +11,8 @@
 #include "utils/TimeUtils.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+
 bool CGUIControlProfiler::m_bIsRunning = false;
 
 CGUIControlProfilerItem::CGUIControlProfilerItem(CGUIControlProfiler *pProfiler, CGUIControlProfilerItem *pParent, CGUIControl *pControl)
@@ -237,6 +239,8 @@ bool CGUIControlProfiler::IsRunning(void)
 void CGUIControlProfiler::Start(void)
 {
   m_iFrameCount = 0;
+  m_iInfoBoolUpdates = 0;
+  m_infoBoolUpdates.clear();
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
@@ -297,6 +301,8 @@ CGUIControlProfilerItem *CGUIControlProfiler::FindOrAddControl(CGUIControl *pCon
 void CGUIControlProfiler::EndFrame(void)
 {
   m_iFrameCount++;
+  m_infoBoolUpdates.push_back(m_iInfoBoolUpdates);
+  m_iInfoBoolUpdates = 0;
   if (m_iFrameCount >= m_iMaxFrameCount)
   {
     const unsigned int dwSize = m_ItemHead.m_vecChildren.size();
@@ -328,6 +334,25 @@ bool CGUIControlProfiler::SaveResults(void)
   root->SetAttribute("timeunit", "ms");
   doc.LinkEndChild(root);
 
+  // number of conditions that had to be evaluated again, per frame
+  unsigned int total = 0;
+  unsigned int peak = 0;
+  std::string frames;
+  for (unsigned int updates : m_infoBoolUpdates)
+  {
+    total += updates;
+    peak = std::max(peak, updates);
+    if (!frames.empty())
+      frames += ",";
+    frames += StringUtils::Format("%u", updates);
+  }
+  TiXmlElement *infoBools = new TiXmlElement("infobools");
+  infoBools->SetAttribute("total", StringUtils::Format("%u", total).c_str());
+  infoBools->SetAttribute("perframe", StringUtils::Format("%u", m_infoBoolUpdates.empty() ? 0 : total / static_cast<unsigned int>(m_infoBoolUpdates.size())).c_str());
+  infoBools->SetAttribute("peak", StringUtils::Format("%u", peak).c_str());
+  infoBools->LinkEndChild(new TiXmlText(frames));
+  root->LinkEndChild(infoBools);
+
   m_ItemHead.SaveToXML(root);
   return doc.SaveFile(m_strOutputFile);
 }
@@ -20,6 +20,7 @@
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "settings/lib/Setting.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
@@ -33,13 +34,22 @@
 
 using namespace ADDON;
 
+namespace
+{
+// frames a font isn't drawn in before its character cache may be evicted, as it's
+// rebuilt once drawn again
+const unsigned int FONT_EVICTION_IDLE_FRAMES = 300;
+}
+
 GUIFontManager::GUIFontManager(void)
 {
   m_canReload = true;
+  CGUITextureBudget::GetInstance().RegisterOwner(CGUITextureBudget::CATEGORY_FONTS, this);
 }
 
 GUIFontManager::~GUIFontManager(void)
 {
+  CGUITextureBudget::GetInstance().UnregisterOwner(this);
   Clear();
 }
 
@@ -267,6 +277,28 @@ void GUIFontManager::FreeFontFile(CGUIFontTTFBase *pFont)
   }
 }
 
+void GUIFontManager::GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates)
+{
+  const unsigned int frame = CGUITextureBudget::GetInstance().GetFrame();
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  for (const auto fontFile : m_vecFontFiles)
+  {
+    if (fontFile->GetTextureMemory() && frame - fontFile->GetLastDrawFrame() >= FONT_EVICTION_IDLE_FRAMES)
+      candidates.push_back({ fontFile, fontFile->GetLastDrawFrame(), fontFile->GetTextureMemory() });
+  }
+}
+
+bool GUIFontManager::Evict(const void *id)
+{
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  for (const auto fontFile : m_vecFontFiles)
+  {
+    if (fontFile == id)
+      return fontFile->GetTextureMemory() && fontFile->EvictCharacterCache();
+  }
+  return false;
+}
+
 CGUIFontTTFBase* GUIFontManager::GetFontFile(const std::string& strFileName)
 {
   for (int i = 0; i < (int)m_vecFontFiles.size(); ++i)
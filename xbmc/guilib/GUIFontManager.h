@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "windowing/GraphicContext.h"
+#include "GUITextureBudget.h"
 #include "IMsgTargetCallback.h"
 #include "utils/Color.h"
 #include "utils/GlobalsHandling.h"
@@ -43,7 +44,7 @@ struct OrigFontInfo
  \ingroup textures
  \brief
  */
-class GUIFontManager : public IMsgTargetCallback
+class GUIFontManager : public IMsgTargetCallback, public CGUITextureBudget::IOwner
 {
 public:
   GUIFontManager(void);
@@ -65,6 +66,10 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTFBase *pFont);
 
+  // implementation of CGUITextureBudget::IOwner, the character caches of fonts not drawn for a while may be evicted
+  void GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates) override;
+  bool Evict(const void *id) override;
+
   static void SettingOptionsFontsFiller(std::shared_ptr<const CSetting> setting, std::vector< std::pair<std::string, std::string> > &list, std::string &current, void *data);
 
 protected:
@@ -9,6 +9,7 @@
 #include "GUIFont.h"
 #include "GUIFontTTF.h"
 #include "GUIFontManager.h"
+#include "GUITextureBudget.h"
 #include "Texture.h"
 #include "windowing/GraphicContext.h"
 #include "ServiceBroker.h"
@@ -194,6 +195,7 @@ void CGUIFontTTFBase::ClearCharacterCache()
   DeleteHardwareTexture();
 
   m_texture = NULL;
+  UpdateTextureMemory();
   delete[] m_char;
   m_char = new Character[CHAR_CHUNK];
   memset(m_charquick, 0, sizeof(m_charquick));
@@ -205,10 +207,33 @@ void CGUIFontTTFBase::ClearCharacterCache()
   m_textureHeight = 0;
 }
 
+bool CGUIFontTTFBase::EvictCharacterCache()
+{
+  if (m_nestedBeginCount)
+    return false;
+
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
+  ClearCharacterCache();
+  return true;
+}
+
+void CGUIFontTTFBase::UpdateTextureMemory()
+{
+  const uint64_t textureMemory = m_texture ? m_texture->GetPitch() * m_texture->GetRows() : 0;
+  if (textureMemory == m_textureMemory)
+    return;
+
+  CGUITextureBudget::GetInstance().Freed(CGUITextureBudget::CATEGORY_FONTS, m_textureMemory);
+  CGUITextureBudget::GetInstance().Allocated(CGUITextureBudget::CATEGORY_FONTS, textureMemory);
+  m_textureMemory = textureMemory;
+}
+
 void CGUIFontTTFBase::Clear()
 {
   delete(m_texture);
   m_texture = NULL;
+  UpdateTextureMemory();
   delete[] m_char;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_char = NULL;
@@ -292,6 +317,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
   delete(m_texture);
   m_texture = NULL;
+  UpdateTextureMemory();
   delete[] m_char;
   m_char = NULL;
 
@@ -322,6 +348,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
 void CGUIFontTTFBase::Begin()
 {
+  m_lastDrawFrame = CGUITextureBudget::GetInstance().GetFrame();
   if (m_nestedBeginCount == 0 && m_texture != NULL && FirstBegin())
   {
     m_vertexTrans.clear();
@@ -755,6 +782,7 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
           return false;
         }
         m_texture = newTexture;
+        UpdateTextureMemory();
       }
     }
 
@@ -85,6 +85,16 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief the frame the font was last drawn in, see CGUITextureBudget::GetFrame()
+   */
+  unsigned int GetLastDrawFrame() const { return m_lastDrawFrame; }
+  uint64_t GetTextureMemory() const { return m_textureMemory; }
+
+  /*! \brief Free the character cache, it is built again once the font is drawn.
+   \return false if the font is being drawn
+   */
+  bool EvictCharacterCache();
+
 protected:
   struct Character
   {
@@ -114,6 +124,7 @@ protected:
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
+  void UpdateTextureMemory();
 
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
@@ -124,6 +135,8 @@ protected:
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
+  uint64_t m_textureMemory = 0;      // memory of m_texture accounted for in CGUITextureBudget
+  unsigned int m_lastDrawFrame = 0;
 
   unsigned int m_textureWidth;       // width of our texture
   unsigned int m_textureHeight;      // height of our texture
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFrameStats.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+float Percentile(const std::vector<float> &sorted, float percentile)
+{
+  // nearest rank
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0f * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+CGUIFrameStats::Summary Summarize(std::vector<float> &values)
+{
+  CGUIFrameStats::Summary summary;
+  if (values.empty())
+    return summary;
+
+  std::sort(values.begin(), values.end());
+  float total = 0.0f;
+  for (float value : values)
+    total += value;
+
+  summary.average = total / values.size();
+  summary.p50 = Percentile(values, 50.0f);
+  summary.p95 = Percentile(values, 95.0f);
+  summary.p99 = Percentile(values, 99.0f);
+  summary.max = values.back();
+  return summary;
+}
+}
+
+const unsigned int CGUIFrameStats::WINDOW_FRAMES;
+const unsigned int CGUIFrameStats::HISTOGRAM_BUCKETS;
+constexpr float CGUIFrameStats::HITCH_FACTOR;
+thread_local unsigned int CGUIFrameStats::m_threadInfoUpdates = 0;
+
+CGUIFrameStats& CGUIFrameStats::GetInstance()
+{
+  static CGUIFrameStats instance;
+  return instance;
+}
+
+CGUIFrameStats::CGUIFrameStats()
+  : m_histogram(HISTOGRAM_BUCKETS, 0)
+{
+  for (auto &ticks : m_stageTicks)
+    ticks = 0;
+  m_frames.reserve(WINDOW_FRAMES);
+}
+
+void CGUIFrameStats::EndFrame()
+{
+  const int64_t now = CurrentHostCounter();
+  const float msPerTick = 1000.0f / CurrentHostFrequency();
+
+  Frame frame;
+  for (unsigned int i = 0; i < STAGE_COUNT; i++)
+    frame.stages[i] = m_stageTicks[i].exchange(0, std::memory_order_relaxed) * msPerTick;
+  frame.infoUpdates = m_threadInfoUpdates;
+  m_threadInfoUpdates = 0;
+
+  // the first frame has nothing to be measured against
+  const int64_t lastFrameEnd = m_lastFrameEnd;
+  m_lastFrameEnd = now;
+  if (lastFrameEnd == 0)
+    return;
+
+  frame.frameTime = (now - lastFrameEnd) * msPerTick;
+  AddFrame(frame);
+}
+
+void CGUIFrameStats::AddFrame(const Frame &frame)
+{
+  CSingleLock lock(m_critSection);
+  if (m_frames.size() < WINDOW_FRAMES)
+    m_frames.push_back(frame);
+  else
+  {
+    m_frames[m_nextFrame] = frame;
+    m_nextFrame = (m_nextFrame + 1) % WINDOW_FRAMES;
+  }
+
+  const unsigned int bucket = static_cast<unsigned int>(std::max(frame.frameTime, 0.0f));
+  m_histogram[std::min(bucket, HISTOGRAM_BUCKETS - 1)]++;
+  m_frameCount++;
+
+  if (m_averageFrameTime > 0.0f && frame.frameTime > HITCH_FACTOR * m_averageFrameTime)
+  {
+    m_hitches++;
+    const float *longest = std::max_element(frame.stages, frame.stages + STAGE_COUNT);
+    if (longest - frame.stages == STAGE_UPLOAD)
+      m_uploadHitches++;
+  }
+  // a hitch only moves the average as much as a frame twice as long as the average
+  if (m_averageFrameTime > 0.0f)
+    m_averageFrameTime += (std::min(frame.frameTime, HITCH_FACTOR * m_averageFrameTime) - m_averageFrameTime) * 0.05f;
+  else
+    m_averageFrameTime = frame.frameTime;
+}
+
+CGUIFrameStats::Statistics CGUIFrameStats::GetStatistics() const
+{
+  Statistics stats;
+  std::vector<float> frameTimes;
+  std::vector<float> stages[STAGE_COUNT];
+  unsigned int infoUpdates = 0;
+  {
+    CSingleLock lock(m_critSection);
+    stats.frames = m_frameCount;
+    stats.window = m_frames.size();
+    stats.histogram = m_histogram;
+    stats.hitches = m_hitches;
+    stats.uploadHitches = m_uploadHitches;
+
+    frameTimes.reserve(m_frames.size());
+    for (auto &values : stages)
+      values.reserve(m_frames.size());
+    for (const auto &frame : m_frames)
+    {
+      frameTimes.push_back(frame.frameTime);
+      for (unsigned int i = 0; i < STAGE_COUNT; i++)
+        stages[i].push_back(frame.stages[i]);
+      infoUpdates += frame.infoUpdates;
+    }
+  }
+
+  stats.frameTime = Summarize(frameTimes);
+  for (unsigned int i = 0; i < STAGE_COUNT; i++)
+    stats.stages[i] = Summarize(stages[i]);
+  if (stats.window > 0)
+    stats.infoUpdates = static_cast<float>(infoUpdates) / stats.window;
+
+  return stats;
+}
+
+std::vector<CGUIFrameStats::Frame> CGUIFrameStats::GetFrames(unsigned int count) const
+{
+  CSingleLock lock(m_critSection);
+  count = std::min<unsigned int>(count, m_frames.size());
+
+  std::vector<Frame> frames;
+  frames.reserve(count);
+  for (unsigned int i = m_frames.size() - count; i < m_frames.size(); i++)
+    frames.push_back(m_frames[(m_nextFrame + i) % m_frames.size()]);
+  return frames;
+}
+
+void CGUIFrameStats::Reset()
+{
+  CSingleLock lock(m_critSection);
+  m_frames.clear();
+  m_nextFrame = 0;
+  m_frameCount = 0;
+  m_hitches = 0;
+  m_uploadHitches = 0;
+  std::fill(m_histogram.begin(), m_histogram.end(), 0);
+}
+
+const char* CGUIFrameStats::GetStageName(Stage stage)
+{
+  switch (stage)
+  {
+  case STAGE_FRAMEMOVE:
+    return "framemove";
+  case STAGE_PROCESS:
+    return "process";
+  case STAGE_DIRTYREGIONS:
+    return "dirtyregions";
+  case STAGE_RENDER:
+    return "render";
+  case STAGE_SWAP:
+    return "swap";
+  case STAGE_INFO:
+    return "info";
+  case STAGE_UPLOAD:
+    return "upload";
+  default:
+    return "unknown";
+  }
+}
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "utils/TimeUtils.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+/*!
+ \ingroup guilib
+ \brief Measures where the time of each GUI frame goes.
+
+ The stages of a frame are timed with CGUIFrameStageTimer, which is cheap enough to be
+ always on. The frames of the last few seconds are kept to compute percentiles, the
+ frame time histogram counts all frames since the statistics were reset.
+ */
+class CGUIFrameStats
+{
+public:
+  enum Stage
+  {
+    STAGE_FRAMEMOVE = 0, //!< CGUIWindowManager::FrameMove
+    STAGE_PROCESS,       //!< CGUIWindowManager::Process
+    STAGE_DIRTYREGIONS,  //!< solving the dirty regions to render
+    STAGE_RENDER,        //!< rendering the windows
+    STAGE_SWAP,          //!< presenting the frame, including waiting for vsync
+    STAGE_INFO,          //!< the per frame update of the info manager, partly within framemove. Conditions
+                         //!< are evaluated in the stages using them
+    STAGE_UPLOAD,        //!< uploading background loaded textures to the GPU
+    STAGE_COUNT
+  };
+
+  //! the number of frames percentiles are computed over
+  static const unsigned int WINDOW_FRAMES = 1024;
+  //! the frame time histogram has buckets of 1 ms, the last one counts all longer frames
+  static const unsigned int HISTOGRAM_BUCKETS = 100;
+  //! a frame taking this many times longer than the recent frames is a hitch
+  static constexpr float HITCH_FACTOR = 2.0f;
+
+  struct Frame
+  {
+    float frameTime = 0.0f; //!< time since the previous frame in ms
+    float stages[STAGE_COUNT] = {}; //!< time spent in each stage in ms
+    unsigned int infoUpdates = 0; //!< the number of info bools updated
+  };
+
+  struct Summary
+  {
+    float average = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+  };
+
+  struct Statistics
+  {
+    uint64_t frames = 0; //!< frames since the statistics were reset
+    unsigned int window = 0; //!< the number of recent frames the summaries are computed over
+    Summary frameTime;
+    Summary stages[STAGE_COUNT];
+    float infoUpdates = 0.0f; //!< average number of info bools updated per frame
+    uint64_t hitches = 0; //!< frames since the statistics were reset that took too long
+    uint64_t uploadHitches = 0; //!< hitches that were mostly spent uploading textures
+    std::vector<unsigned int> histogram; //!< frame times since the statistics were reset
+  };
+
+  static CGUIFrameStats& GetInstance();
+
+  CGUIFrameStats();
+  ~CGUIFrameStats() = default;
+
+  /*!
+   \brief Add time spent in a stage of the current frame. May be called from any thread.
+   \param stage the stage the time was spent in.
+   \param ticks the time spent, see CurrentHostCounter().
+   */
+  void AddStageTime(Stage stage, int64_t ticks)
+  {
+    m_stageTicks[stage].fetch_add(ticks, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Count an info bool update. Called for every condition evaluated, so it's a plain
+   increment. Only the updates made on the thread ending the frames are counted.
+   */
+  static void InfoBoolUpdated() { ++m_threadInfoUpdates; }
+
+  /*!
+   \brief End the current frame, called on the GUI thread once the frame is presented.
+   */
+  void EndFrame();
+
+  /*!
+   \brief Add a complete frame. Used by EndFrame().
+   */
+  void AddFrame(const Frame &frame);
+
+  Statistics GetStatistics() const;
+
+  /*!
+   \brief Get the recent frames, oldest first.
+   \param count the maximum number of frames to get.
+   */
+  std::vector<Frame> GetFrames(unsigned int count) const;
+
+  void Reset();
+
+  static const char* GetStageName(Stage stage);
+
+private:
+  std::atomic<int64_t> m_stageTicks[STAGE_COUNT];
+  static thread_local unsigned int m_threadInfoUpdates;
+  int64_t m_lastFrameEnd = 0;
+
+  mutable CCriticalSection m_critSection;
+  std::vector<Frame> m_frames; //!< ring buffer of the recent frames
+  unsigned int m_nextFrame = 0;
+  uint64_t m_frameCount = 0;
+  uint64_t m_hitches = 0;
+  uint64_t m_uploadHitches = 0;
+  float m_averageFrameTime = 0.0f; //!< moving average the hitches are detected with
+  std::vector<unsigned int> m_histogram;
+};
+
+/*!
+ \ingroup guilib
+ \brief Adds the time from its construction to its destruction to a stage of the frame.
+ */
+class CGUIFrameStageTimer
+{
+public:
+  explicit CGUIFrameStageTimer(CGUIFrameStats::Stage stage)
+    : m_stage(stage),
+      m_start(CurrentHostCounter())
+  {
+  }
+
+  ~CGUIFrameStageTimer()
+  {
+    CGUIFrameStats::GetInstance().AddStageTime(m_stage, CurrentHostCounter() - m_start);
+  }
+
+  CGUIFrameStageTimer(const CGUIFrameStageTimer&) = delete;
+  CGUIFrameStageTimer& operator=(const CGUIFrameStageTimer&) = delete;
+
+private:
+  CGUIFrameStats::Stage m_stage;
+  int64_t m_start;
+};
@@ -291,6 +291,16 @@ CRect CGUIImage::CalcRenderRegion() const
   return CGUIControl::CalcRenderRegion().Intersect(region);
 }
 
+bool CGUIImage::IsOpaque(const CRect &region) const
+{
+  // while crossfading the textures are blended
+  if (!IsVisible() || !m_fadingTextures.empty() || !HasOpaqueTransform() || !m_texture.IsOpaque())
+    return false;
+
+  return m_renderRegion.x1 <= region.x1 && m_renderRegion.y1 <= region.y1 &&
+         m_renderRegion.x2 >= region.x2 && m_renderRegion.y2 >= region.y2;
+}
+
 const std::string &CGUIImage::GetFileName() const
 {
   return m_texture.GetFileName();
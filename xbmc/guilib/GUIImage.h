@@ -85,6 +85,7 @@ public:
   float GetTextureHeight() const;
 
   CRect CalcRenderRegion() const override;
+  bool IsOpaque(const CRect &region) const override;
 
 #ifdef _DEBUG
   void DumpTextureUse() override;
@@ -11,6 +11,7 @@
 #include "GUIInfoManager.h"
 #include "guilib/guiinfo/GUIInfoLabel.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUISkinCache.h"
 #include "utils/log.h"
 #include "utils/XBMCTinyXML.h"
 #include "utils/XMLUtils.h"
@@ -92,6 +93,7 @@ void CGUIIncludes::Clear()
   m_constants.clear();
   m_skinvariables.clear();
   m_files.clear();
+  m_fileTimes.clear();
   m_expressions.clear();
 }
 
@@ -109,6 +111,7 @@ bool CGUIIncludes::Load_Internal(const std::string &file)
   if (HasLoaded(file))
     return true;
 
+  const int64_t modified = CGUISkinCache::GetModificationTime(file);
   CXBMCTinyXML doc;
   if (!doc.LoadFile(file))
   {
@@ -131,6 +134,7 @@ bool CGUIIncludes::Load_Internal(const std::string &file)
   LoadIncludes(root);
 
   m_files.push_back(file);
+  m_fileTimes.push_back(modified);
 
   return true;
 }
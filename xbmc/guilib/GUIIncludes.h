@@ -61,6 +61,20 @@ public:
    */
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
+  /*!
+   \brief Get the files the include components were loaded from.
+
+   \return the loaded files
+   */
+  const std::vector<std::string>& GetFiles() const { return m_files; }
+
+  /*!
+   \brief Get the modification times of the loaded files, taken before they were read.
+
+   \return the times, in the order of GetFiles()
+   */
+  const std::vector<int64_t>& GetFileTimes() const { return m_fileTimes; }
+
 private:
   enum ResolveParamsResult
   {
@@ -119,6 +133,7 @@ private:
   std::string ResolveExpressions(const std::string &expression) const;
 
   std::vector<std::string> m_files;
+  std::vector<int64_t> m_fileTimes;
   std::map<std::string, std::pair<TiXmlElement, Params>> m_includes;
   std::map<std::string, TiXmlElement> m_defaults;
   std::map<std::string, TiXmlElement> m_skinvariables;
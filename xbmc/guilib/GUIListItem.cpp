@@ -8,6 +8,7 @@
 
 #include "GUIListItem.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "GUIListItemLayout.h"
@@ -16,9 +17,15 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+struct PropertyCompare
+{
+  bool operator()(const std::pair<std::string, CVariant> &property, const std::string &strKey) const
+  {
+    return StringUtils::CompareNoCase(property.first, strKey) < 0;
+  }
+};
 }
 
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
@@ -111,13 +118,15 @@ void CGUIListItem::SetArt(const ArtMap &art)
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  if (!m_artFallbacks)
+    m_artFallbacks.reset(new ArtMap);
+  (*m_artFallbacks)[from] = to;
 }
 
 void CGUIListItem::ClearArt()
 {
   m_art.clear();
-  m_artFallbacks.clear();
+  m_artFallbacks.reset();
 }
 
 void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
@@ -131,8 +140,10 @@ std::string CGUIListItem::GetArt(const std::string &type) const
   ArtMap::const_iterator i = m_art.find(type);
   if (i != m_art.end())
     return i->second;
-  i = m_artFallbacks.find(type);
-  if (i != m_artFallbacks.end())
+  if (!m_artFallbacks)
+    return "";
+  i = m_artFallbacks->find(type);
+  if (i != m_artFallbacks->end())
   {
     ArtMap::const_iterator j = m_art.find(i->second);
     if (j != m_art.end())
@@ -227,7 +238,7 @@ CGUIListItem& CGUIListItem::operator =(const CGUIListItem& item)
   m_bIsFolder = item.m_bIsFolder;
   m_mapProperties = item.m_mapProperties;
   m_art = item.m_art;
-  m_artFallbacks = item.m_artFallbacks;
+  m_artFallbacks.reset(item.m_artFallbacks ? new ArtMap(*item.m_artFallbacks) : nullptr);
   SetInvalid();
   return *this;
 }
@@ -255,8 +266,10 @@ void CGUIListItem::Archive(CArchive &ar)
       ar << i->first;
       ar << i->second;
     }
-    ar << (int)m_artFallbacks.size();
-    for (ArtMap::const_iterator i = m_artFallbacks.begin(); i != m_artFallbacks.end(); ++i)
+    const ArtMap noFallbacks;
+    const ArtMap &artFallbacks = m_artFallbacks ? *m_artFallbacks : noFallbacks;
+    ar << (int)artFallbacks.size();
+    for (ArtMap::const_iterator i = artFallbacks.begin(); i != artFallbacks.end(); ++i)
     {
       ar << i->first;
       ar << i->second;
@@ -299,7 +312,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      SetArtFallback(key, value);
     }
     SetInvalid();
   }
@@ -371,10 +384,10 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyCompare());
+  if (iter == m_mapProperties.end() || StringUtils::CompareNoCase(iter->first, strKey) != 0)
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_mapProperties.insert(iter, make_pair(strKey, value));
     SetInvalid();
   }
   else if (iter->second != value)
@@ -386,7 +399,7 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
   if (iter == m_mapProperties.end())
@@ -397,16 +410,21 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   if (iter == m_mapProperties.end())
     return false;
 
   return true;
 }
 
+bool CGUIListItem::HasProperties() const
+{
+  return !m_mapProperties.empty();
+}
+
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = FindProperty(strKey);
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -423,6 +441,22 @@ void CGUIListItem::ClearProperties()
   }
 }
 
+CGUIListItem::PropertyMap::iterator CGUIListItem::FindProperty(const std::string &strKey)
+{
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyCompare());
+  if (iter != m_mapProperties.end() && StringUtils::CompareNoCase(iter->first, strKey) != 0)
+    return m_mapProperties.end();
+  return iter;
+}
+
+CGUIListItem::PropertyMap::const_iterator CGUIListItem::FindProperty(const std::string &strKey) const
+{
+  PropertyMap::const_iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyCompare());
+  if (iter != m_mapProperties.end() && StringUtils::CompareNoCase(iter->first, strKey) != 0)
+    return m_mapProperties.end();
+  return iter;
+}
+
 void CGUIListItem::IncrementProperty(const std::string &strKey, int nVal)
 {
   int64_t i = GetProperty(strKey).asInteger();
@@ -16,6 +16,8 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -159,7 +161,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool       HasProperties() const { return !m_mapProperties.empty(); };
+  bool       HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -168,23 +170,22 @@ protected:
   std::string m_strLabel2;     // text of column2
   std::string m_strIcon;      // filename of icon
   GUIIconOverlay m_overlayIcon; // type of overlay icon
+  bool m_bSelected;     // item is selected or not
 
   CGUIListItemLayoutPtr m_layout;
   CGUIListItemLayoutPtr m_focusedLayout;
-  bool m_bSelected;     // item is selected or not
 
-  struct icompare
-  {
-    bool operator()(const std::string &s1, const std::string &s2) const;
-  };
-
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  // items only have a few properties, a sorted vector saves an allocation per property over a map
+  typedef std::vector<std::pair<std::string, CVariant>> PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  PropertyMap::iterator FindProperty(const std::string &strKey);
+  PropertyMap::const_iterator FindProperty(const std::string &strKey) const;
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
   ArtMap m_art;
-  ArtMap m_artFallbacks;
+  std::unique_ptr<ArtMap> m_artFallbacks; // only allocated for the few items having any
 };
 
@@ -0,0 +1,297 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUISkinCache.h"
+#include "FileItem.h"
+#include "GUIComponent.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "addons/Skin.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// increase when the format of the cache files changes
+const int SKIN_CACHE_VERSION = 1;
+const int SKIN_CACHE_END = 0x534b4e43;
+const char* SKIN_CACHE_PATH = "special://temp/skincache/";
+
+enum NodeType
+{
+  NODE_ELEMENT = 0,
+  NODE_TEXT,
+  NODE_CDATA
+};
+
+void WriteElement(CArchive &ar, const TiXmlElement &element)
+{
+  ar << element.ValueStr();
+
+  int count = 0;
+  for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+    count++;
+  ar << count;
+  for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+  {
+    ar << attribute->NameTStr();
+    ar << attribute->ValueStr();
+  }
+
+  // comments and the like aren't needed to create the controls
+  count = 0;
+  for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+      count++;
+  }
+  ar << count;
+  for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT)
+    {
+      ar << static_cast<int>(NODE_ELEMENT);
+      WriteElement(ar, *child->ToElement());
+    }
+    else if (child->Type() == TiXmlNode::TINYXML_TEXT)
+    {
+      ar << static_cast<int>(child->ToText()->CDATA() ? NODE_CDATA : NODE_TEXT);
+      ar << child->ValueStr();
+    }
+  }
+}
+
+bool ReadElement(CArchive &ar, TiXmlElement &element)
+{
+  std::string name, value;
+  int count;
+  ar >> count;
+  if (count < 0)
+    return false;
+  for (int i = 0; i < count; i++)
+  {
+    ar >> name;
+    ar >> value;
+    element.SetAttribute(name, value);
+  }
+
+  ar >> count;
+  if (count < 0)
+    return false;
+  for (int i = 0; i < count; i++)
+  {
+    int type;
+    ar >> type;
+    ar >> value;
+    if (type == NODE_ELEMENT)
+    {
+      TiXmlElement child(value);
+      if (!ReadElement(ar, child))
+        return false;
+      element.InsertEndChild(child);
+    }
+    else if (type == NODE_TEXT || type == NODE_CDATA)
+    {
+      TiXmlText text(value);
+      text.SetCDATA(type == NODE_CDATA);
+      element.InsertEndChild(text);
+    }
+    else
+      return false;
+  }
+  return true;
+}
+}
+
+std::unique_ptr<TiXmlElement> CGUISkinCache::Get(const std::string &xmlFile, std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  const std::string cacheFile = GetCacheFile(xmlFile);
+  XFILE::CFile file;
+  if (!g_SkinInfo || !file.Open(cacheFile))
+    return nullptr;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    int version;
+    std::string skin, path;
+    ar >> version;
+    ar >> skin;
+    ar >> path;
+    if (version != SKIN_CACHE_VERSION || skin != GetSkin() || path != xmlFile)
+      return nullptr;
+
+    // the window and include files must not have changed
+    int count;
+    ar >> count;
+    std::vector<std::string> includeFiles;
+    for (int i = 0; i < count; i++)
+    {
+      std::string file;
+      int64_t modified;
+      ar >> file;
+      ar >> modified;
+      if (modified != GetModificationTime(file))
+        return nullptr;
+      if (file != xmlFile)
+        includeFiles.push_back(file);
+    }
+
+    // the includes must be resolved the same way
+    CGUIInfoManager &infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+    std::map<INFO::InfoPtr, bool> conditions;
+    ar >> count;
+    for (int i = 0; i < count; i++)
+    {
+      std::string condition;
+      bool value;
+      ar >> condition;
+      ar >> value;
+      INFO::InfoPtr info = infoMgr.Register(condition);
+      if (!info || info->Get() != value)
+        return nullptr;
+      conditions.insert(std::make_pair(info, value));
+    }
+
+    std::string name;
+    ar >> name;
+    std::unique_ptr<TiXmlElement> root(new TiXmlElement(name));
+    int end = 0;
+    if (!ReadElement(ar, *root) || !(ar >> end, end == SKIN_CACHE_END))
+    {
+      CLog::Log(LOGERROR, "CGUISkinCache: corrupt cache file %s for %s", cacheFile.c_str(), xmlFile.c_str());
+      return nullptr;
+    }
+
+    // other windows may rely on the includes loaded while resolving this one
+    for (const auto &includeFile : includeFiles)
+      g_SkinInfo->LoadIncludeFile(includeFile);
+
+    includeConditions.swap(conditions);
+    return root;
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "CGUISkinCache: corrupt cache file %s for %s", cacheFile.c_str(), xmlFile.c_str());
+  }
+  return nullptr;
+}
+
+void CGUISkinCache::Set(const std::string &xmlFile, int64_t modified, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  if (!g_SkinInfo)
+    return;
+
+  const std::string cacheDirectory = GetCacheDirectory();
+  if (!XFILE::CDirectory::Exists(cacheDirectory))
+  {
+    // the first window cached for this skin, the files of others are of no use anymore
+    Prune();
+    XFILE::CDirectory::Create(cacheDirectory);
+  }
+
+  // written to a temporary file first, an interrupted write mustn't leave a partial cache file
+  const std::string cacheFile = GetCacheFile(xmlFile);
+  const std::string tempFile = cacheFile + ".tmp";
+  XFILE::CFile file;
+  if (!file.OpenForWrite(tempFile, true))
+  {
+    CLog::Log(LOGERROR, "CGUISkinCache: failed to create cache file %s for %s", tempFile.c_str(), xmlFile.c_str());
+    return;
+  }
+
+  CArchive ar(&file, CArchive::store);
+  ar << SKIN_CACHE_VERSION;
+  ar << GetSkin();
+  ar << xmlFile;
+
+  // the times the files had when they were read, not the current ones
+  const std::vector<std::string> &includeFiles = g_SkinInfo->GetIncludeFiles();
+  const std::vector<int64_t> &includeTimes = g_SkinInfo->GetIncludeFileTimes();
+  ar << static_cast<int>(includeFiles.size() + 1);
+  ar << xmlFile;
+  ar << modified;
+  for (size_t i = 0; i < includeFiles.size(); i++)
+  {
+    ar << includeFiles[i];
+    ar << includeTimes[i];
+  }
+
+  ar << static_cast<int>(includeConditions.size());
+  for (const auto &condition : includeConditions)
+  {
+    ar << condition.first->GetExpression();
+    ar << condition.second;
+  }
+
+  WriteElement(ar, root);
+  ar << SKIN_CACHE_END;
+  ar.Close();
+  file.Close();
+
+  if (ar.HasWriteError() || !XFILE::CFile::Rename(tempFile, cacheFile))
+  {
+    CLog::Log(LOGERROR, "CGUISkinCache: failed to write cache file %s for %s", cacheFile.c_str(), xmlFile.c_str());
+    XFILE::CFile::Delete(tempFile);
+  }
+}
+
+bool CGUISkinCache::Exists(const std::string &xmlFile)
+{
+  return g_SkinInfo && XFILE::CFile::Exists(GetCacheFile(xmlFile));
+}
+
+std::string CGUISkinCache::GetCacheDirectory()
+{
+  return StringUtils::Format("%s%s-%s/", SKIN_CACHE_PATH, g_SkinInfo->ID().c_str(), g_SkinInfo->Version().asString().c_str());
+}
+
+std::string CGUISkinCache::GetCacheFile(const std::string &xmlFile)
+{
+  return StringUtils::Format("%s%08x.bin", GetCacheDirectory().c_str(), static_cast<uint32_t>(Crc32::ComputeFromLowerCase(xmlFile)));
+}
+
+std::string CGUISkinCache::GetSkin()
+{
+  return g_SkinInfo->ID() + " " + g_SkinInfo->Version().asString();
+}
+
+void CGUISkinCache::Prune()
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(SKIN_CACHE_PATH, items, "", XFILE::DIR_FLAG_NO_FILE_DIRS))
+    return;
+
+  for (int i = 0; i < items.Size(); i++)
+  {
+    const CFileItemPtr &item = items[i];
+    CLog::Log(LOGDEBUG, "CGUISkinCache: removing %s", item->GetPath().c_str());
+    if (item->m_bIsFolder)
+      XFILE::CDirectory::RemoveRecursive(item->GetPath());
+    else
+      XFILE::CFile::Delete(item->GetPath());
+  }
+}
+
+int64_t CGUISkinCache::GetModificationTime(const std::string &file)
+{
+  struct __stat64 buffer;
+  if (XFILE::CFile::Stat(file, &buffer) != 0)
+    return -1;
+  return static_cast<int64_t>(buffer.st_mtime);
+}
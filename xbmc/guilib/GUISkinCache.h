@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+class TiXmlElement;
+
+/*!
+ \ingroup windows
+ \brief Keeps the window xml with its includes resolved on disk.
+
+ Resolving the includes, constants and expressions of a window takes most of the
+ time spent loading it. The resolved tree is stored in a compact binary file, which
+ stays valid as long as the skin, the window file and the include files don't change
+ and the conditions of the includes have the same values. Each skin version has its own
+ directory, the ones of other skins are removed when the first window of a skin is cached.
+ */
+class CGUISkinCache
+{
+public:
+  /*!
+   \brief Get the cached window xml with its includes resolved.
+   \param xmlFile the path of the window xml.
+   \param includeConditions [out] the conditions of the includes with their values.
+   \return the root element, nullptr if nothing valid is cached.
+   */
+  static std::unique_ptr<TiXmlElement> Get(const std::string &xmlFile, std::map<INFO::InfoPtr, bool> &includeConditions);
+
+  /*!
+   \brief Cache the window xml with its includes resolved.
+   \param xmlFile the path of the window xml.
+   \param modified the modification time of the window xml when it was read.
+   \param root the root element, with its includes resolved.
+   \param includeConditions the conditions of the includes with their values.
+   */
+  static void Set(const std::string &xmlFile, int64_t modified, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &includeConditions);
+
+  /*!
+   \brief Check whether the window xml has a cache file. It may still turn out not to be valid.
+   \param xmlFile the path of the window xml.
+   \return true if there's a cache file, false otherwise.
+   */
+  static bool Exists(const std::string &xmlFile);
+
+  /*!
+   \brief Get the modification time of a file. Taken before the file is read, so
+   changes made while it's read invalidate the cache.
+   \param file the path of the file.
+   \return the modification time, -1 if the file doesn't exist.
+   */
+  static int64_t GetModificationTime(const std::string &file);
+
+private:
+  static std::string GetCacheDirectory();
+  static std::string GetCacheFile(const std::string &xmlFile);
+  static std::string GetSkin();
+
+  /*!
+   \brief Remove the cache files of other skins and skin versions.
+   */
+  static void Prune();
+};
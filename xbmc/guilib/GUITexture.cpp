@@ -7,12 +7,17 @@
  */
 
 #include "GUITexture.h"
+#include "GUITextureBudget.h"
 #include "windowing/GraphicContext.h"
 #include "TextureManager.h"
+#include "Texture.h"
 #include "GUILargeTextureManager.h"
 #include "utils/MathUtils.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <cmath>
+
 CTextureInfo::CTextureInfo()
 {
   orientation = 0;
@@ -66,6 +71,11 @@ CGUITextureBase::CGUITextureBase(float posX, float posY, float width, float heig
 
   m_allocateDynamically = false;
   m_isAllocated = NO;
+  m_largeWidth = 0;
+  m_largeHeight = 0;
+  m_pendingLargeWidth = 0;
+  m_pendingLargeHeight = 0;
+  m_largeFullSize = false;
   m_invalid = true;
   m_use_cache = true;
 }
@@ -102,6 +112,11 @@ CGUITextureBase::CGUITextureBase(const CGUITextureBase &right) :
   ResetAnimState();
 
   m_isAllocated = NO;
+  m_largeWidth = 0;
+  m_largeHeight = 0;
+  m_pendingLargeWidth = 0;
+  m_pendingLargeHeight = 0;
+  m_largeFullSize = false;
   m_invalid = true;
 }
 
@@ -113,6 +128,8 @@ bool CGUITextureBase::AllocateOnDemand()
   { // visible, so make sure we're allocated
     if (!IsAllocated() || (m_isAllocated == LARGE && !m_texture.size()))
       return AllocResources();
+    if (m_isAllocated == LARGE)
+      return UpdateLargeTexture();
   }
   else
   { // hidden, so deallocate as applicable
@@ -165,6 +182,9 @@ void CGUITextureBase::Render()
 
   color = CServiceBroker::GetWinSystem()->GetGfxContext().MergeAlpha(color);
 
+  // remember when the texture was drawn, the least recently drawn are evicted first
+  m_texture.m_textures[m_currentFrame]->SetLastDrawFrame(CGUITextureBudget::GetInstance().GetFrame());
+
   // setup our renderer
   Begin(color);
 
@@ -298,9 +318,17 @@ bool CGUITextureBase::AllocResources()
       }
     }
     if (m_isAllocated != NORMAL)
-    { // use our large image background loader
+    { // use our large image background loader, at the size we're shown at
+      unsigned int width, height;
+      float distance = GetScreenDistance(width, height);
+      if (!IsAllocated())
+      {
+        m_largeWidth = width;
+        m_largeHeight = height;
+      }
       CTextureArray texture;
-      if (CServiceBroker::GetGUI()->GetLargeTextureManager().GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache))
+      if (CServiceBroker::GetGUI()->GetLargeTextureManager().GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache,
+                                                                     m_largeWidth, m_largeHeight, distance))
       {
         m_isAllocated = LARGE;
 
@@ -442,10 +470,17 @@ bool CGUITextureBase::CalculateSize()
 void CGUITextureBase::FreeResources(bool immediately /* = false */)
 {
   if (m_isAllocated == LARGE || m_isAllocated == LARGE_FAILED)
-    CServiceBroker::GetGUI()->GetLargeTextureManager().ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED));
+    CServiceBroker::GetGUI()->GetLargeTextureManager().ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED),
+                                                                   m_largeWidth, m_largeHeight);
   else if (m_isAllocated == NORMAL && m_texture.size())
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseTexture(m_info.filename, immediately);
 
+  if (m_pendingLargeWidth)
+    CServiceBroker::GetGUI()->GetLargeTextureManager().ReleaseImage(m_info.filename, true, m_pendingLargeWidth, m_pendingLargeHeight);
+  m_pendingLargeWidth = 0;
+  m_pendingLargeHeight = 0;
+  m_largeFullSize = false;
+
   if (m_diffuse.size())
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseTexture(m_info.diffuse, immediately);
   m_diffuse.Reset();
@@ -463,6 +498,74 @@ void CGUITextureBase::FreeResources(bool immediately /* = false */)
   m_isAllocated = NO;
 }
 
+float CGUITextureBase::GetScreenDistance(unsigned int &width, unsigned int &height) const
+{
+  const CGraphicContext &context = CServiceBroker::GetWinSystem()->GetGfxContext();
+  CRect rect(context.ScaleFinalXCoord(m_posX, m_posY), context.ScaleFinalYCoord(m_posX, m_posY),
+             context.ScaleFinalXCoord(m_posX + m_width, m_posY + m_height), context.ScaleFinalYCoord(m_posX + m_width, m_posY + m_height));
+  width = static_cast<unsigned int>(std::abs(rect.Width()));
+  height = static_cast<unsigned int>(std::abs(rect.Height()));
+
+  // how far we are outside of the screen, in pixels
+  const float screenWidth = static_cast<float>(context.GetWidth());
+  const float screenHeight = static_cast<float>(context.GetHeight());
+  float distanceX = std::max(0.0f, std::max(std::min(rect.x1, rect.x2) - screenWidth, -std::max(rect.x1, rect.x2)));
+  float distanceY = std::max(0.0f, std::max(std::min(rect.y1, rect.y2) - screenHeight, -std::max(rect.y1, rect.y2)));
+  return distanceX + distanceY;
+}
+
+bool CGUITextureBase::UpdateLargeTexture()
+{
+  CGUILargeTextureManager &manager = CServiceBroker::GetGUI()->GetLargeTextureManager();
+  unsigned int width, height;
+  float distance = GetScreenDistance(width, height);
+  if (!m_pendingLargeWidth)
+  {
+    // request it again once it's shown larger than it was decoded at, unless that's its full size
+    const CBaseTexture *decoded = m_texture.m_textures[0];
+    unsigned int decodedWidth = decoded->GetWidth();
+    unsigned int decodedHeight = decoded->GetHeight();
+    if (decoded->GetOrientation() >= 4)
+      std::swap(decodedWidth, decodedHeight);
+    if (m_largeFullSize || !width || !height || (width <= decodedWidth && height <= decodedHeight) ||
+        (decoded->GetWidth() >= decoded->GetOriginalWidth() && decoded->GetHeight() >= decoded->GetOriginalHeight()))
+      return false;
+
+    CTextureArray texture;
+    m_pendingLargeWidth = width;
+    m_pendingLargeHeight = height;
+    manager.GetImage(m_info.filename, texture, true, m_use_cache, m_pendingLargeWidth, m_pendingLargeHeight, distance);
+  }
+
+  // keep drawing the one we have until it's loaded
+  CTextureArray texture;
+  bool loaded = manager.GetImage(m_info.filename, texture, false, m_use_cache, m_pendingLargeWidth, m_pendingLargeHeight, distance);
+  if (loaded && !texture.size())
+    return false;
+
+  bool changed = false;
+  if (!loaded || texture.m_textures[0] == m_texture.m_textures[0])
+  {
+    manager.ReleaseImage(m_info.filename, true, m_pendingLargeWidth, m_pendingLargeHeight);
+    m_largeFullSize = true;
+  }
+  else
+  {
+    manager.ReleaseImage(m_info.filename, false, m_largeWidth, m_largeHeight);
+    m_largeWidth = m_pendingLargeWidth;
+    m_largeHeight = m_pendingLargeHeight;
+    m_texture = texture;
+    m_frameWidth = static_cast<float>(m_texture.m_width);
+    m_frameHeight = static_cast<float>(m_texture.m_height);
+    CalculateSize();
+    Allocate();
+    changed = true;
+  }
+  m_pendingLargeWidth = 0;
+  m_pendingLargeHeight = 0;
+  return changed;
+}
+
 void CGUITextureBase::DynamicResourceAlloc(bool allocateDynamically)
 {
   m_allocateDynamically = allocateDynamically;
@@ -545,6 +648,20 @@ bool CGUITextureBase::ReadyToRender() const
   return m_texture.size() > 0;
 }
 
+bool CGUITextureBase::IsOpaque() const
+{
+  if (!m_visible || m_currentFrame >= m_texture.size())
+    return false;
+
+  // same as the renderers decide whether to blend
+  UTILS::Color color = (m_info.diffuseColor) ? (UTILS::Color)m_info.diffuseColor : m_diffuseColor;
+  if (m_alpha != 0xFF || (color >> 24) != 0xFF)
+    return false;
+  if (m_texture.m_textures[m_currentFrame]->HasAlpha())
+    return false;
+  return !m_diffuse.size() || !m_diffuse.m_textures[0]->HasAlpha();
+}
+
 void CGUITextureBase::OrientateTexture(CRect &rect, float width, float height, int orientation)
 {
   switch (orientation & 3)
@@ -105,6 +105,9 @@ public:
   bool IsAllocated() const { return m_isAllocated != NO; };
   bool FailedToAlloc() const { return m_isAllocated == NORMAL_FAILED || m_isAllocated == LARGE_FAILED; };
   bool ReadyToRender() const;
+  /*! \brief whether the texture is drawn without any transparency, apart from the alpha of the transform
+   */
+  bool IsOpaque() const;
 protected:
   bool CalculateSize();
   void LoadDiffuseImage();
@@ -113,6 +116,8 @@ protected:
   void Render(float left, float top, float bottom, float right, float u1, float v1, float u2, float v2, float u3, float v3);
   static void OrientateTexture(CRect &rect, float width, float height, int orientation);
   void ResetAnimState();
+  float GetScreenDistance(unsigned int &width, unsigned int &height) const;
+  bool UpdateLargeTexture();
 
   // functions that our implementation classes handle
   virtual void Allocate() {}; ///< called after our textures have been allocated
@@ -149,6 +154,11 @@ protected:
   bool m_allocateDynamically;
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
+  unsigned int m_largeWidth;  // size in pixels the large texture was requested at
+  unsigned int m_largeHeight;
+  unsigned int m_pendingLargeWidth;  // size in pixels it's requested at again when shown larger
+  unsigned int m_pendingLargeHeight;
+  bool m_largeFullSize;               // no larger version of it can be loaded
 
   CTextureInfo m_info;
   CAspectRatio m_aspect;
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextureBudget.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XMemUtils.h"
+#endif
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace
+{
+// the budget is never set lower than this by default
+const uint64_t MIN_DEFAULT_BUDGET = 64 * 1024 * 1024;
+}
+
+CGUITextureBudget& CGUITextureBudget::GetInstance()
+{
+  static CGUITextureBudget instance;
+  return instance;
+}
+
+CGUITextureBudget::CGUITextureBudget()
+  : m_budget(0),
+    m_frame(1),
+    m_peak(0),
+    m_evictedBytes(0),
+    m_overBudgetFrames(0)
+{
+  for (unsigned int i = 0; i < CATEGORY_COUNT; i++)
+  {
+    m_used[i] = 0;
+    m_evictions[i] = 0;
+  }
+}
+
+uint64_t CGUITextureBudget::GetDefaultBudget()
+{
+  MEMORYSTATUSEX stat;
+  stat.dwLength = sizeof(MEMORYSTATUSEX);
+  GlobalMemoryStatusEx(&stat);
+  return std::max<uint64_t>(stat.ullTotalPhys / 8, MIN_DEFAULT_BUDGET);
+}
+
+void CGUITextureBudget::RegisterOwner(Category category, IOwner *owner)
+{
+  CSingleLock lock(m_ownersSection);
+  m_owners.push_back(std::make_pair(category, owner));
+}
+
+void CGUITextureBudget::UnregisterOwner(IOwner *owner)
+{
+  CSingleLock lock(m_ownersSection);
+  m_owners.erase(std::remove_if(m_owners.begin(), m_owners.end(), [owner](const std::pair<Category, IOwner*> &registered)
+  {
+    return registered.second == owner;
+  }), m_owners.end());
+}
+
+void CGUITextureBudget::Allocated(Category category, uint64_t size)
+{
+  m_used[category].fetch_add(size, std::memory_order_relaxed);
+
+  uint64_t used = 0;
+  for (const auto &categoryUsed : m_used)
+    used += categoryUsed.load(std::memory_order_relaxed);
+  uint64_t peak = m_peak.load(std::memory_order_relaxed);
+  while (used > peak && !m_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+    ;
+}
+
+void CGUITextureBudget::Freed(Category category, uint64_t size)
+{
+  m_used[category].fetch_sub(size, std::memory_order_relaxed);
+}
+
+void CGUITextureBudget::EndFrame()
+{
+  const unsigned int frame = m_frame++;
+  const uint64_t budget = m_budget;
+  if (!budget)
+    return;
+
+  auto getUsed = [this]()
+  {
+    uint64_t used = 0;
+    for (const auto &categoryUsed : m_used)
+      used += categoryUsed.load(std::memory_order_relaxed);
+    return used;
+  };
+  if (getUsed() <= budget)
+  {
+    m_overBudget = false;
+    return;
+  }
+
+  struct Owned
+  {
+    Candidate candidate;
+    Category category;
+    IOwner *owner;
+  };
+  std::vector<Owned> owned;
+  std::vector<Candidate> candidates;
+
+  CSingleLock lock(m_ownersSection);
+  for (const auto &registered : m_owners)
+  {
+    candidates.clear();
+    registered.second->GetEvictionCandidates(candidates);
+    for (const auto &candidate : candidates)
+    {
+      // evicting what was just drawn would only load it again
+      if (candidate.lastDrawFrame < frame)
+        owned.push_back({ candidate, registered.first, registered.second });
+    }
+  }
+
+  // least recently drawn first
+  std::stable_sort(owned.begin(), owned.end(), [](const Owned &a, const Owned &b)
+  {
+    return a.candidate.lastDrawFrame < b.candidate.lastDrawFrame;
+  });
+
+  uint64_t evictable = 0;
+  for (const auto &entry : owned)
+    evictable += entry.candidate.size;
+
+  for (const auto &entry : owned)
+  {
+    // stop once the rest can't get us within the budget, evicting them would only cost
+    // loading them again
+    const uint64_t used = getUsed();
+    if (used <= budget || used - std::min(used, evictable) > budget)
+      break;
+    evictable -= entry.candidate.size;
+    if (entry.owner->Evict(entry.candidate.id))
+    {
+      m_evictions[entry.category]++;
+      m_evictedBytes += entry.candidate.size;
+    }
+  }
+
+  const uint64_t used = getUsed();
+  if (used > budget)
+  {
+    m_overBudgetFrames++;
+    if (!m_overBudget)
+      CLog::Log(LOGWARNING, "CGUITextureBudget: %" PRIu64 " KB of textures in use, over the budget of %" PRIu64 " KB",
+                used / 1024, budget / 1024);
+  }
+  m_overBudget = used > budget;
+}
+
+CGUITextureBudget::Statistics CGUITextureBudget::GetStatistics() const
+{
+  Statistics stats;
+  stats.budget = m_budget;
+  for (unsigned int i = 0; i < CATEGORY_COUNT; i++)
+  {
+    stats.categoryUsed[i] = m_used[i];
+    stats.evictions[i] = m_evictions[i];
+    stats.used += stats.categoryUsed[i];
+  }
+  stats.peak = m_peak;
+  stats.evictedBytes = m_evictedBytes;
+  stats.overBudgetFrames = m_overBudgetFrames;
+  return stats;
+}
+
+const char* CGUITextureBudget::GetCategoryName(Category category)
+{
+  switch (category)
+  {
+  case CATEGORY_TEXTURES:
+    return "textures";
+  case CATEGORY_LARGE:
+    return "large";
+  case CATEGORY_FONTS:
+    return "fonts";
+  default:
+    return "unknown";
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Accounts for the memory of the GUI textures and keeps it within a budget.
+
+ The texture manager, the large texture manager and the fonts report the memory of their
+ textures. Once a frame ends over the budget, textures that are no longer in use are
+ evicted, least recently drawn first. Textures still in use are never evicted, apart from
+ the character caches of fonts not drawn for a while, which are rebuilt once the font is
+ drawn again. Nothing is evicted when evicting all candidates wouldn't get within the
+ budget.
+ */
+class CGUITextureBudget
+{
+public:
+  enum Category
+  {
+    CATEGORY_TEXTURES = 0, //!< skin textures, see CGUITextureManager
+    CATEGORY_LARGE,        //!< background loaded images, see CGUILargeTextureManager
+    CATEGORY_FONTS,        //!< character caches of the fonts, see GUIFontManager
+    CATEGORY_COUNT
+  };
+
+  struct Candidate
+  {
+    const void *id; //!< identifies the texture to its owner, never dereferenced by the budget
+    unsigned int lastDrawFrame; //!< see GetFrame()
+    uint64_t size; //!< bytes freed by evicting the texture
+  };
+
+  /*!
+   \brief Implemented by the owners of textures that may be evicted.
+   */
+  class IOwner
+  {
+  public:
+    virtual ~IOwner() = default;
+
+    /*!
+     \brief Add the textures that may be evicted now.
+     */
+    virtual void GetEvictionCandidates(std::vector<Candidate> &candidates) = 0;
+
+    /*!
+     \brief Evict a texture returned by GetEvictionCandidates().
+     \return true if the texture was evicted, false if it's gone or in use again.
+     */
+    virtual bool Evict(const void *id) = 0;
+  };
+
+  struct Statistics
+  {
+    uint64_t budget = 0; //!< bytes, 0 for no limit
+    uint64_t used = 0;
+    uint64_t peak = 0;
+    uint64_t categoryUsed[CATEGORY_COUNT] = {};
+    uint64_t evictions[CATEGORY_COUNT] = {}; //!< textures evicted since the start
+    uint64_t evictedBytes = 0;
+    uint64_t overBudgetFrames = 0; //!< frames over the budget that evicting the candidates couldn't get within it
+  };
+
+  static CGUITextureBudget& GetInstance();
+
+  CGUITextureBudget();
+  ~CGUITextureBudget() = default;
+
+  /*!
+   \brief The budget used unless one is configured, an eighth of the physical memory.
+   */
+  static uint64_t GetDefaultBudget();
+
+  /*!
+   \param budget the budget in bytes, 0 for no limit.
+   */
+  void SetBudget(uint64_t budget) { m_budget = budget; }
+  uint64_t GetBudget() const { return m_budget; }
+
+  void RegisterOwner(Category category, IOwner *owner);
+  void UnregisterOwner(IOwner *owner);
+
+  /*!
+   \brief Account for memory of textures. May be called from any thread.
+   */
+  void Allocated(Category category, uint64_t size);
+  void Freed(Category category, uint64_t size);
+
+  /*!
+   \brief The current frame, textures remember the frame they were last drawn in.
+   */
+  unsigned int GetFrame() const { return m_frame; }
+
+  /*!
+   \brief End the current frame, and evict textures if over the budget. Called on the
+   render thread once the frame is rendered.
+   */
+  void EndFrame();
+
+  Statistics GetStatistics() const;
+
+  static const char* GetCategoryName(Category category);
+
+private:
+  std::atomic<uint64_t> m_budget;
+  std::atomic<unsigned int> m_frame;
+  std::atomic<uint64_t> m_used[CATEGORY_COUNT];
+  std::atomic<uint64_t> m_peak;
+  std::atomic<uint64_t> m_evictions[CATEGORY_COUNT];
+  std::atomic<uint64_t> m_evictedBytes;
+  std::atomic<uint64_t> m_overBudgetFrames;
+  bool m_overBudget = false;
+
+  CCriticalSection m_ownersSection;
+  std::vector<std::pair<Category, IOwner*>> m_owners;
+};
@@ -13,6 +13,7 @@
 #include "GUIControlFactory.h"
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
+#include "GUISkinCache.h"
 
 #include "addons/Skin.h"
 #include "GUIInfoManager.h"
@@ -56,6 +57,7 @@ CGUIWindow::CGUIWindow(int id, const std::string &xmlFile)
   m_exclusiveMouseControl = 0;
   m_clearBackground = 0xff000000; // opaque black -> always clear
   m_windowXMLRootElement = nullptr;
+  m_windowXMLModified = -1;
   m_menuControlID = 0;
   m_menuLastFocusedControlID = 0;
   m_custom = false;
@@ -125,9 +127,26 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  // the includes of the window may have been resolved before
+  std::unique_ptr<TiXmlElement> cached = CGUISkinCache::Get(strPath, m_xmlIncludeConditions);
+  if (cached)
+  {
+    CLog::Log(LOGDEBUG, "Using cached xml for %s", strPath.c_str());
+    return Load(cached.get());
+  }
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
+    // it may have been parsed while the skin was loading
+    m_windowXMLRootElement = CServiceBroker::GetGUI()->GetWindowManager().GetPreloadedXML(strPath, m_windowXMLModified).release();
+  }
+
+  if (!m_windowXMLRootElement)
+  {
+    // taken before reading, so changes made meanwhile invalidate the cache
+    m_windowXMLModified = CGUISkinCache::GetModificationTime(strPath);
+
     CXBMCTinyXML xmlDoc;
     std::string strPathLower = strPath;
     StringUtils::ToLower(strPathLower);
@@ -151,7 +170,12 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  // only reached when nothing valid is cached
+  std::unique_ptr<TiXmlElement> prepared = Prepare(m_windowXMLRootElement);
+  if (prepared)
+    CGUISkinCache::Set(strPath, m_windowXMLModified, *prepared, m_xmlIncludeConditions);
+
+  return Load(prepared.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -274,6 +274,7 @@ protected:
   CGUIAction m_unloadActions;
 
   TiXmlElement* m_windowXMLRootElement;
+  int64_t m_windowXMLModified; ///< modification time of the window xml when it was read
 
   bool m_manualRunActions;
 
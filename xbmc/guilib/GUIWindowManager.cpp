@@ -9,6 +9,7 @@
 #include "GUIWindowManager.h"
 #include "GUIAudioManager.h"
 #include "GUIDialog.h"
+#include "GUIFrameStats.h"
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/helpers/DialogHelper.h"
@@ -19,11 +20,13 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "addons/Skin.h"
+#include "rendering/RenderSystem.h"
 #include "GUITexture.h"
 #include "utils/Variant.h"
 #include "input/Key.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
 
 #include "windows/GUIWindowHome.h"
 #include "events/windows/GUIWindowEventLog.h"
@@ -145,6 +148,8 @@
 #include "games/dialogs/osd/DialogGameVideoRotation.h"
 #include "games/dialogs/osd/DialogGameVolume.h"
 
+#include <algorithm>
+
 using namespace KODI;
 using namespace PVR;
 using namespace PERIPHERALS;
@@ -155,6 +160,7 @@ CGUIWindowManager::CGUIWindowManager()
   m_pCallback = nullptr;
   m_iNested = 0;
   m_initialized = false;
+  m_occludingDialog = WINDOW_INVALID;
 }
 
 CGUIWindowManager::~CGUIWindowManager() = default;
@@ -1087,12 +1093,25 @@ void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(g_application.IsCurrentThread());
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_PROCESS);
+
+  ProcessWindows(currentTime);
+}
 
+void CGUIWindowManager::ProcessWindows(unsigned int currentTime)
+{
   m_dirtyregions.clear();
 
+  // the active window is always processed, so its animations advance and the window
+  // manager waiting for its close animation isn't stuck. Hidden behind a dialog it
+  // isn't rendered though, so it doesn't mark regions dirty.
+  const bool occluded = GetOccludingDialog() != nullptr;
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
   if (pWindow)
-    pWindow->DoProcess(currentTime, m_dirtyregions);
+  {
+    CDirtyRegionList hiddenRegions;
+    pWindow->DoProcess(currentTime, occluded ? hiddenRegions : m_dirtyregions);
+  }
 
   // process all dialogs - visibility may change etc.
   for (const auto& entry : m_mapWindows)
@@ -1102,6 +1121,11 @@ void CGUIWindowManager::Process(unsigned int currentTime)
       pWindow->DoProcess(currentTime, m_dirtyregions);
   }
 
+  // once the dialog stops hiding the window, all of it has to be rendered again
+  m_occludingDialog = FindOccludingDialog();
+  if (occluded && !GetOccludingDialog())
+    MarkDirty();
+
   for (CDirtyRegionList::iterator itr = m_dirtyregions.begin(); itr != m_dirtyregions.end(); ++itr)
     m_tracker.MarkDirtyRegion(*itr);
 }
@@ -1128,8 +1152,11 @@ void CGUIWindowManager::MarkDirty(const CRect& rect)
 
 void CGUIWindowManager::RenderPass() const
 {
+  // nothing below an opaque dialog is visible
+  CGUIWindow* occluder = GetOccludingDialog();
+
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
-  if (pWindow)
+  if (pWindow && !occluder)
   {
     pWindow->ClearBackground();
     pWindow->DoRender();
@@ -1139,15 +1166,50 @@ void CGUIWindowManager::RenderPass() const
   auto renderList = m_activeDialogs;
   stable_sort(renderList.begin(), renderList.end(), RenderOrderSortFunction);
 
-  for (const auto& window : renderList)
+  auto first = std::find(renderList.begin(), renderList.end(), occluder);
+  if (first == renderList.end())
+    first = renderList.begin();
+
+  for (auto it = first; it != renderList.end(); ++it)
   {
-    if (window->IsDialogRunning())
-      window->DoRender();
+    if ((*it)->IsDialogRunning())
+      (*it)->DoRender();
   }
 }
 
+int CGUIWindowManager::FindOccludingDialog() const
+{
+  CGraphicContext &context = CServiceBroker::GetWinSystem()->GetGfxContext();
+  // in stereo modes the screen is rendered in parts
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiOcclusionCulling || context.GetStereoMode())
+    return WINDOW_INVALID;
+
+  auto renderList = m_activeDialogs;
+  stable_sort(renderList.begin(), renderList.end(), RenderOrderSortFunction);
+
+  const CRect screen(0, 0, static_cast<float>(context.GetWidth()), static_cast<float>(context.GetHeight()));
+  for (auto it = renderList.rbegin(); it != renderList.rend(); ++it)
+  {
+    if ((*it)->IsDialogRunning() && (*it)->IsOpaque(screen))
+      return (*it)->GetID();
+  }
+  return WINDOW_INVALID;
+}
+
+CGUIWindow* CGUIWindowManager::GetOccludingDialog() const
+{
+  if (m_occludingDialog == WINDOW_INVALID)
+    return nullptr;
+
+  CGUIWindow *dialog = GetWindow(m_occludingDialog);
+  if (!dialog || !dialog->IsDialogRunning())
+    return nullptr;
+  return dialog;
+}
+
 void CGUIWindowManager::RenderEx() const
 {
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_RENDER);
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
   if (pWindow)
     pWindow->RenderEx();
@@ -1169,8 +1231,13 @@ bool CGUIWindowManager::Render()
   assert(g_application.IsCurrentThread());
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
+  CDirtyRegionList dirtyRegions;
+  {
+    CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_DIRTYREGIONS);
+    dirtyRegions = m_tracker.GetDirtyRegions();
+  }
 
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_RENDER);
   bool hasRendered = false;
   // If we visualize the regions we will always render the entire viewport
   if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions || CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ALWAYS)
@@ -1188,6 +1255,9 @@ bool CGUIWindowManager::Render()
   }
   else
   {
+    // the GPU time of the passes is learned for the solver, it's known once the GPU is done
+    CRenderSystemBase *renderSystem = CServiceBroker::GetRenderSystem();
+    const bool timed = renderSystem->BeginTimeQuery();
     for (CDirtyRegionList::const_iterator i = dirtyRegions.begin(); i != dirtyRegions.end(); ++i)
     {
       if (i->IsEmpty())
@@ -1198,6 +1268,15 @@ bool CGUIWindowManager::Render()
       hasRendered = true;
     }
     CServiceBroker::GetWinSystem()->GetGfxContext().ResetScissors();
+
+    if (timed)
+    {
+      renderSystem->EndTimeQuery();
+      m_tracker.AddTimedRegions(dirtyRegions);
+    }
+    float renderTime;
+    while (renderSystem->GetTimeQueryResult(renderTime))
+      m_tracker.AddRenderTime(renderTime);
   }
 
   if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions)
@@ -1215,6 +1294,7 @@ bool CGUIWindowManager::Render()
 
 void CGUIWindowManager::AfterRender()
 {
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_RENDER);
   m_tracker.CleanMarkedRegions();
 
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
@@ -1239,6 +1319,7 @@ void CGUIWindowManager::FrameMove()
 {
   assert(g_application.IsCurrentThread());
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  CGUIFrameStageTimer timer(CGUIFrameStats::STAGE_FRAMEMOVE);
 
   if(m_iNested == 0)
   {
@@ -1263,6 +1344,7 @@ void CGUIWindowManager::FrameMove()
     window->FrameMove();
   }
 
+  CGUIFrameStageTimer infoTimer(CGUIFrameStats::STAGE_INFO);
   CServiceBroker::GetGUI()->GetInfoManager().UpdateAVInfo();
 }
 
@@ -1316,6 +1398,8 @@ void CGUIWindowManager::DeInitialize()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
+  m_preloader.Clear();
+
   // Need a copy bacause addon-dialogs remove itself on Close()
   std::unordered_map<int, CGUIWindow*> closeMap(m_mapWindows);
   for (const auto& entry : closeMap)
@@ -1545,6 +1629,36 @@ bool CGUIWindowManager::IsWindowVisible(const std::string &xmlFile) const
   return IsWindowActive(xmlFile, false);
 }
 
+void CGUIWindowManager::PreloadWindows()
+{
+  if (!g_SkinInfo || !CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiParallelSkinLoad)
+    return;
+
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  std::vector<std::string> files;
+  for (const auto& entry : m_mapWindows)
+  {
+    // the windows loaded with the skin and the home window shown right after it
+    CGUIWindow *pWindow = entry.second;
+    if (pWindow->GetLoadType() != CGUIWindow::LOAD_ON_GUI_INIT && entry.first != WINDOW_HOME)
+      continue;
+
+    // windows of add-ons come with their own path
+    std::string xmlFile = pWindow->GetProperty("xmlfile").asString();
+    if (xmlFile.empty() || xmlFile.find_first_of("/\\") != std::string::npos)
+      continue;
+
+    RESOLUTION_INFO res;
+    files.push_back(g_SkinInfo->GetSkinPath(xmlFile, &res));
+  }
+  m_preloader.Start(files);
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowManager::GetPreloadedXML(const std::string &xmlFile, int64_t &modified)
+{
+  return m_preloader.Get(xmlFile, modified);
+}
+
 void CGUIWindowManager::LoadNotOnDemandWindows()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
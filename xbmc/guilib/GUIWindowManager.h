@@ -16,6 +16,7 @@
 #include "DirtyRegionTracker.h"
 #include "guilib/WindowIDs.h"
 #include "GUIWindow.h"
+#include "GUIWindowPreloader.h"
 #include "IMsgTargetCallback.h"
 #include "IWindowManagerCallback.h"
 #include "messaging/IMessageTarget.h"
@@ -49,6 +50,7 @@ class CGUIWindowManager : public KODI::MESSAGING::IMessageTarget
 {
   friend CGUIDialog;
   friend CGUIMediaWindow;
+  friend class TestGUIWindowManagerHelper;
 public:
   CGUIWindowManager();
   ~CGUIWindowManager() override;
@@ -159,6 +161,19 @@ public:
   void SetCallback(IWindowManagerCallback& callback);
   void DeInitialize();
 
+  /*! \brief Start parsing the xml of the windows loaded with the skin on worker threads.
+   Called once the skin is known, so the windows are parsed while the rest of the skin loads.
+   \sa GetPreloadedXML
+   */
+  void PreloadWindows();
+
+  /*! \brief Take the preloaded root element of a window xml file.
+   \param xmlFile the path of the window xml file.
+   \param modified [out] the modification time of the file when it was read.
+   \return the root element, null if the file wasn't preloaded.
+   */
+  std::unique_ptr<TiXmlElement> GetPreloadedXML(const std::string &xmlFile, int64_t &modified);
+
   /*! \brief Register a dialog as active dialog
    *
    * \param dialog The dialog to register as active dialog
@@ -215,8 +230,22 @@ public:
   void DumpTextureUse();
 #endif
 private:
+  /*!
+   \brief Process the active window and the dialogs, see Process.
+   */
+  void ProcessWindows(unsigned int currentTime);
   void RenderPass() const;
 
+  /*!
+   \brief Find the topmost running dialog that hides everything below it.
+   \return the id of the dialog, WINDOW_INVALID if no dialog hides the screen.
+   */
+  int FindOccludingDialog() const;
+  /*!
+   \brief Get the dialog found by FindOccludingDialog during the last Process, if it's still running.
+   */
+  CGUIWindow* GetOccludingDialog() const;
+
   void LoadNotOnDemandWindows();
   void UnloadNotOnDemandWindows();
   void AddToWindowHistory(int newWindowID);
@@ -267,4 +296,6 @@ private:
 
   CDirtyRegionList m_dirtyregions;
   CDirtyRegionTracker m_tracker;
+  int m_occludingDialog;
+  CGUIWindowPreloader m_preloader;
 };
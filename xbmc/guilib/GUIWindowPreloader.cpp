@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowPreloader.h"
+#include "GUISkinCache.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <utility>
+
+namespace
+{
+// don't hold up the skin for longer if the workers are busy with other jobs
+const unsigned int PRELOAD_TIMEOUT = 2000;
+
+std::unique_ptr<TiXmlElement> Parse(const std::string &file, int64_t &modified)
+{
+  // windows that are cached don't need to be parsed
+  if (CGUISkinCache::Exists(file))
+    return nullptr;
+
+  modified = CGUISkinCache::GetModificationTime(file);
+  CXBMCTinyXML xmlDoc;
+  std::string fileLower = file;
+  StringUtils::ToLower(fileLower);
+  if (!xmlDoc.LoadFile(file) && !xmlDoc.LoadFile(fileLower))
+    return nullptr;
+
+  // errors are reported when the window is loaded the usual way
+  if (!StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
+    return nullptr;
+
+  return std::unique_ptr<TiXmlElement>(static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone()));
+}
+}
+
+struct CGUIWindowPreloader::State
+{
+  CCriticalSection section;
+  CEvent parsed;
+  std::set<std::string> pending;
+  std::map<std::string, std::pair<std::unique_ptr<TiXmlElement>, int64_t>> elements;
+};
+
+void CGUIWindowPreloader::Start(const std::vector<std::string> &files)
+{
+  std::shared_ptr<State> state = std::make_shared<State>();
+  state->pending.insert(files.begin(), files.end());
+  m_state = state;
+
+  // the jobs remove their file from the pending ones, so don't iterate over those
+  const std::set<std::string> pending = state->pending;
+  for (const auto &file : pending)
+  {
+    const unsigned int jobId = CJobManager::GetInstance().Submit([state, file]()
+    {
+      int64_t modified = -1;
+      std::unique_ptr<TiXmlElement> element = Parse(file, modified);
+
+      CSingleLock lock(state->section);
+      state->pending.erase(file);
+      if (element)
+        state->elements.insert(std::make_pair(file, std::make_pair(std::move(element), modified)));
+      state->parsed.Set();
+    }, CJob::PRIORITY_HIGH);
+
+    // the window is parsed when it's loaded instead of waiting for a job that never runs
+    if (!jobId)
+    {
+      CSingleLock lock(state->section);
+      state->pending.erase(file);
+    }
+  }
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowPreloader::Get(const std::string &file, int64_t &modified)
+{
+  std::shared_ptr<State> state = m_state;
+  if (!state)
+    return nullptr;
+
+  CSingleLock lock(state->section);
+  XbmcThreads::EndTime timeout(PRELOAD_TIMEOUT);
+  while (state->pending.find(file) != state->pending.end())
+  {
+    if (timeout.IsTimePast())
+    {
+      CLog::Log(LOGWARNING, "CGUIWindowPreloader: timed out waiting for %s", file.c_str());
+      return nullptr;
+    }
+    CSingleExit exit(state->section);
+    state->parsed.WaitMSec(timeout.MillisLeft());
+  }
+
+  auto it = state->elements.find(file);
+  if (it == state->elements.end())
+    return nullptr;
+
+  std::unique_ptr<TiXmlElement> element = std::move(it->second.first);
+  modified = it->second.second;
+  state->elements.erase(it);
+  return element;
+}
+
+void CGUIWindowPreloader::Clear()
+{
+  // jobs still running keep their own reference to the state
+  m_state.reset();
+}
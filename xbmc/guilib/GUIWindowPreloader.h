@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class TiXmlElement;
+
+/*!
+ \ingroup windows
+ \brief Parses window xml files on worker threads while the skin is loading.
+
+ Only parsing happens in the background. Resolving the includes and creating
+ the controls stay on the GUI thread, see CGUIWindow::LoadXML.
+ */
+class CGUIWindowPreloader
+{
+public:
+  CGUIWindowPreloader() = default;
+  ~CGUIWindowPreloader() = default;
+
+  /*!
+   \brief Start parsing the given window xml files, dropping any files parsed before.
+   \param files the paths of the window xml files.
+   */
+  void Start(const std::vector<std::string> &files);
+
+  /*!
+   \brief Take the root element of a window xml file, waiting for it to be parsed if needed.
+   \param file the path of the window xml file.
+   \param modified [out] the modification time of the file when it was read.
+   \return the root element, nullptr if the file isn't preloaded or couldn't be parsed.
+   */
+  std::unique_ptr<TiXmlElement> Get(const std::string &file, int64_t &modified);
+
+  /*!
+   \brief Drop the files that weren't taken yet.
+   */
+  void Clear();
+
+private:
+  struct State;
+  std::shared_ptr<State> m_state;
+};
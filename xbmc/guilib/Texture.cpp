@@ -178,7 +178,8 @@ void CBaseTexture::ClampToEdge()
   }
 }
 
-CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigned int idealWidth, unsigned int idealHeight, bool requirePixels, const std::string& strMimeType)
+CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigned int idealWidth, unsigned int idealHeight, bool requirePixels, const std::string& strMimeType,
+                                         bool scaleOnDecode)
 {
 #if defined(TARGET_ANDROID)
   CURL url(texturePath);
@@ -203,6 +204,7 @@ CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigne
   }
 #endif
   CTexture *texture = new CTexture();
+  texture->m_scaleOnDecode = scaleOnDecode;
   if (texture->LoadFromFileInternal(texturePath, idealWidth, idealHeight, requirePixels, strMimeType))
     return texture;
   delete texture;
@@ -303,6 +305,8 @@ bool CBaseTexture::LoadFromFileInMem(unsigned char* buffer, size_t size, const s
 
 bool CBaseTexture::LoadIImage(IImage *pImage, unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height)
 {
+  if (pImage != NULL)
+    pImage->SetScaleOnDecode(m_scaleOnDecode);
   if(pImage != NULL && pImage->LoadImageFromMemory(buffer, bufSize, width, height))
   {
     if (pImage->Width() > 0 && pImage->Height() > 0)
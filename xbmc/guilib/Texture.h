@@ -48,10 +48,13 @@ public:
    \param idealWidth the ideal width of the texture (defaults to 0, no ideal width).
    \param idealHeight the ideal height of the texture (defaults to 0, no ideal height).
    \param strMimeType mimetype of the given texture if available (defaults to empty)
+   \param scaleOnDecode scale the image down on decode so it just covers the ideal size (defaults to false,
+   the caller resamples it). Only honoured by loaders that support it.
    \return a CBaseTexture pointer to the created texture - NULL if the texture failed to load.
    */
   static CBaseTexture *LoadFromFile(const std::string& texturePath, unsigned int idealWidth = 0, unsigned int idealHeight = 0,
-                                    bool requirePixels = false, const std::string& strMimeType = "");
+                                    bool requirePixels = false, const std::string& strMimeType = "",
+                                    bool scaleOnDecode = false);
 
   /*! \brief Load a texture from a file in memory
    Loads a texture from a file in memory, restricting in size if needed based on maxHeight and maxWidth.
@@ -98,6 +101,10 @@ public:
   int GetOrientation() const { return m_orientation; }
   void SetOrientation(int orientation) { m_orientation = orientation; }
 
+  /*! \brief the frame the texture was last drawn in, see CGUITextureBudget */
+  unsigned int GetLastDrawFrame() const { return m_lastDrawFrame; }
+  void SetLastDrawFrame(unsigned int frame) { m_lastDrawFrame = frame; }
+
   void Update(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, bool loadToGPU);
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   void ClampToEdge();
@@ -134,6 +141,8 @@ protected:
   bool m_mipmapping =  false ;
   TEXTURE_SCALING m_scalingMethod = TEXTURE_SCALING::LINEAR;
   bool m_bCacheMemory = false;
+  bool m_scaleOnDecode = false;
+  unsigned int m_lastDrawFrame = 0;
 };
 
 #if defined(TARGET_RASPBERRY_PI)
@@ -8,6 +8,7 @@
 
 #include "TextureManager.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "addons/Skin.h"
@@ -171,6 +172,14 @@ unsigned int CTextureMap::GetMemoryUsage() const
   return m_memUsage;
 }
 
+unsigned int CTextureMap::GetLastDrawFrame() const
+{
+  unsigned int lastDrawFrame = 0;
+  for (const auto texture : m_texture.m_textures)
+    lastDrawFrame = std::max(lastDrawFrame, texture->GetLastDrawFrame());
+  return lastDrawFrame;
+}
+
 void CTextureMap::Flush()
 {
   if (!m_referenceCount)
@@ -180,6 +189,8 @@ void CTextureMap::Flush()
 
 void CTextureMap::FreeTexture()
 {
+  CGUITextureBudget::GetInstance().Freed(CGUITextureBudget::CATEGORY_TEXTURES, m_memUsage);
+  m_memUsage = 0;
   m_texture.Free();
 }
 
@@ -203,7 +214,11 @@ void CTextureMap::Add(CBaseTexture* texture, int delay)
   m_texture.Add(texture, delay);
 
   if (texture)
-    m_memUsage += sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
+  {
+    uint32_t memUsage = sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
+    m_memUsage += memUsage;
+    CGUITextureBudget::GetInstance().Allocated(CGUITextureBudget::CATEGORY_TEXTURES, memUsage);
+  }
 }
 
 /************************************************************************/
@@ -213,10 +228,12 @@ CGUITextureManager::CGUITextureManager(void)
 {
   // we set the theme bundle to be the first bundle (thus prioritizing it)
   m_TexBundle[0].SetThemeBundle(true);
+  CGUITextureBudget::GetInstance().RegisterOwner(CGUITextureBudget::CATEGORY_TEXTURES, this);
 }
 
 CGUITextureManager::~CGUITextureManager(void)
 {
+  CGUITextureBudget::GetInstance().UnregisterOwner(this);
   Cleanup();
 }
 
@@ -520,6 +537,28 @@ void CGUITextureManager::ReleaseHwTexture(unsigned int texture)
   m_unusedHwTextures.push_back(texture);
 }
 
+void CGUITextureManager::GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates)
+{
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  for (const auto &unused : m_unusedTextures)
+    candidates.push_back({ unused.first, unused.first->GetLastDrawFrame(), unused.first->GetMemoryUsage() });
+}
+
+bool CGUITextureManager::Evict(const void *id)
+{
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  for (ilistUnused i = m_unusedTextures.begin(); i != m_unusedTextures.end(); ++i)
+  {
+    if (i->first == id)
+    {
+      delete i->first;
+      m_unusedTextures.erase(i);
+      return true;
+    }
+  }
+  return false;
+}
+
 void CGUITextureManager::Cleanup()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
@@ -12,6 +12,7 @@
 #include <vector>
 #include <utility>
 
+#include "GUITextureBudget.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
 
@@ -67,6 +68,7 @@ public:
   const CTextureArray& GetTexture();
   void Dump() const;
   uint32_t GetMemoryUsage() const;
+  unsigned int GetLastDrawFrame() const;
   void Flush();
   bool IsEmpty() const;
   void SetHeight(int height);
@@ -87,11 +89,11 @@ protected:
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
-class CGUITextureManager
+class CGUITextureManager : public CGUITextureBudget::IOwner
 {
 public:
   CGUITextureManager(void);
-  virtual ~CGUITextureManager(void);
+  ~CGUITextureManager(void) override;
 
   bool HasTexture(const std::string &textureName, std::string *path = NULL, int *bundle = NULL, int *size = NULL);
   static bool CanLoad(const std::string &texturePath); ///< Returns true if the texture manager can load this texture
@@ -110,6 +112,10 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+
+  // implementation of CGUITextureBudget::IOwner, unused textures may be evicted
+  void GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates) override;
+  bool Evict(const void *id) override;
 protected:
   std::vector<CTextureMap*> m_vecTextures;
   std::list<std::pair<CTextureMap*, unsigned int> > m_unusedTextures;
@@ -330,6 +330,14 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_PROCESS_AUDIOBITSPERSAMPLE:
       value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetAudioBitsPerSample());
       return true;
+    case PLAYER_PROCESS_VIDEOTHREADS:
+      value = StringUtils::Format("%s (%d)",
+                                  CServiceBroker::GetDataCacheCore().GetVideoDecoderThreadType().c_str(),
+                                  CServiceBroker::GetDataCacheCore().GetVideoDecoderThreads());
+      return true;
+    case PLAYER_PROCESS_TIMETOFIRSTFRAME:
+      value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetTimeToFirstFrame());
+      return true;
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // PLAYLIST_*
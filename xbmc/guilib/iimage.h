@@ -62,6 +62,12 @@ public:
   unsigned int Orientation() const        { return m_orientation; }
   bool hasAlpha() const                   { return m_hasAlpha; }
 
+  /*!
+   \brief Scale the image down on decode so that it just covers the ideal size given to LoadImageFromMemory
+   \remarks Loaders that can't scale on decode ignore it and keep the full size
+   */
+  void SetScaleOnDecode(bool scaleOnDecode) { m_scaleOnDecode = scaleOnDecode; }
+
 protected:
 
   unsigned int m_width = 0;
@@ -70,5 +76,6 @@ protected:
   unsigned int m_originalHeight = 0;  ///< original image height before scaling or cropping
   unsigned int m_orientation = 0;
   bool m_hasAlpha = false;
+  bool m_scaleOnDecode = false;
 
 };
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/DirtyRegionSolvers.h"
+#include "guilib/DirtyRegionTracker.h"
+#include "utils/StringUtils.h"
+
+#include "test/TestUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+// the render time the solvers are compared by, independent of the cost model of
+// the cluster solver which has to learn it
+const float PASS_TIME = 0.3f;
+const float AREA_TIME = 2.0f;
+
+float RenderTime(const CDirtyRegionList &regions)
+{
+  float time = 0.0f;
+  for (const auto &region : regions)
+    time += PASS_TIME + AREA_TIME * region.Area() / 1000000.0f;
+  return time;
+}
+
+bool Covers(const CDirtyRegionList &output, const CDirtyRegion &region)
+{
+  for (const auto &rect : output)
+  {
+    if (rect.x1 <= region.x1 && rect.y1 <= region.y1 && rect.x2 >= region.x2 && rect.y2 >= region.y2)
+      return true;
+  }
+  return false;
+}
+}
+
+TEST(TestDirtyRegionSolvers, ClusterMergesOverlapping)
+{
+  CDirtyRegionCostModel costModel;
+  CClusterDirtyRegionSolver solver(costModel);
+  CDirtyRegionList input;
+  input.push_back(CDirtyRegion(0, 0, 100, 100));
+  input.push_back(CDirtyRegion(50, 50, 150, 150));
+  input.push_back(CDirtyRegion(60, 60, 70, 70));
+
+  CDirtyRegionList output;
+  solver.Solve(input, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(0, 0, 150, 150), output[0]);
+}
+
+TEST(TestDirtyRegionSolvers, ClusterByCost)
+{
+  CDirtyRegionList input;
+  input.push_back(CDirtyRegion(0, 0, 100, 100));
+  input.push_back(CDirtyRegion(1800, 1000, 1900, 1060));
+
+  // filling the area in between costs more than a pass
+  CDirtyRegionCostModel cheapPasses(0.1f, 1.0f);
+  CClusterDirtyRegionSolver cheapPassesSolver(cheapPasses);
+  CDirtyRegionList output;
+  cheapPassesSolver.Solve(input, output);
+  EXPECT_EQ(2u, output.size());
+
+  CDirtyRegionCostModel expensivePasses(10.0f, 1.0f);
+  CClusterDirtyRegionSolver expensivePassesSolver(expensivePasses);
+  output.clear();
+  expensivePassesSolver.Solve(input, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(0, 0, 1900, 1060), output[0]);
+}
+
+TEST(TestDirtyRegionSolvers, CostModelFit)
+{
+  // measured 2 ms per pass and 3 ms per megapixel
+  CDirtyRegionCostModel costModel;
+  for (int i = 0; i < 100; i++)
+  {
+    CDirtyRegionList regions;
+    for (int pass = 0; pass <= i % 4; pass++)
+      regions.push_back(CDirtyRegion(0, 0, 100.0f * (1 + i % 7), 1000));
+    float area = regions.size() * regions[0].Area() / 1000000.0f;
+    costModel.AddSample(regions, 2.0f * regions.size() + 3.0f * area);
+  }
+  EXPECT_NEAR(2.0f, costModel.GetPassCost(), 0.01f);
+  EXPECT_NEAR(3.0f, costModel.GetAreaCost(), 0.01f);
+}
+
+TEST(TestDirtyRegionSolvers, RecordingFormat)
+{
+  CDirtyRegionList regions;
+  regions.push_back(CDirtyRegion(0, 0, 1920, 1080));
+  regions.push_back(CDirtyRegion(10.5f, 20, 30, 40.25f));
+
+  std::string line = CDirtyRegionTracker::ToString(regions);
+  EXPECT_EQ("0,0,1920,1080 10.5,20,30,40.25", line);
+  CDirtyRegionList parsed = CDirtyRegionTracker::FromString(line);
+  ASSERT_EQ(2u, parsed.size());
+  EXPECT_EQ(regions[0], parsed[0]);
+  EXPECT_EQ(regions[1], parsed[1]);
+  EXPECT_TRUE(CDirtyRegionTracker::FromString("").empty());
+}
+
+// Replays a recording of the marked regions of each frame through the solvers and
+// compares the render time they'd take, the cluster solver learning it from the
+// frames it solved like it does from the GPU time queries. Recordings of other skins can
+// be made with <gui><recorddirtyregions>.
+TEST(TestDirtyRegionSolvers, ReplayRecording)
+{
+  XFILE::CFile file;
+  ASSERT_TRUE(file.Open(XBMC_REF_FILE_PATH("xbmc/guilib/test/data/dirtyregions.txt")));
+
+  CDirtyRegion viewport;
+  std::vector<CDirtyRegionList> frames;
+  char line[4096];
+  while (file.ReadString(line, sizeof(line)))
+  {
+    std::string str(line);
+    StringUtils::Trim(str);
+    if (StringUtils::StartsWith(str, "# viewport "))
+      viewport = CDirtyRegionTracker::FromString(str.substr(11)).at(0);
+    else if (!str.empty() && str[0] != '#')
+      frames.push_back(CDirtyRegionTracker::FromString(str));
+  }
+  ASSERT_FALSE(viewport.IsEmpty());
+  ASSERT_FALSE(frames.empty());
+
+  CDirtyRegionCostModel costModel;
+  struct Result
+  {
+    const char *name;
+    std::unique_ptr<IDirtyRegionSolver> solver;
+    unsigned int passes = 0;
+    float area = 0.0f;
+    float cost = 0.0f;
+    double solveTime = 0.0;
+  };
+  Result results[] = {
+    { "union", std::unique_ptr<IDirtyRegionSolver>(new CUnionDirtyRegionSolver) },
+    { "cost reduction", std::unique_ptr<IDirtyRegionSolver>(new CGreedyDirtyRegionSolver) },
+    { "cluster", std::unique_ptr<IDirtyRegionSolver>(new CClusterDirtyRegionSolver(costModel)) },
+    { "fill viewport on change", nullptr },
+  };
+
+  for (const auto &frame : frames)
+  {
+    for (auto &result : results)
+    {
+      CDirtyRegionList output;
+      if (result.solver)
+      {
+        auto start = std::chrono::steady_clock::now();
+        result.solver->Solve(frame, output);
+        result.solveTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        for (const auto &region : frame)
+          EXPECT_TRUE(Covers(output, region)) << result.name;
+        if (result.solver.get() == results[2].solver.get() && !output.empty())
+          costModel.AddSample(output, RenderTime(output));
+      }
+      else if (!frame.empty())
+      {
+        // the viewport solvers need the window system, so it's solved here
+        output.push_back(viewport);
+      }
+
+      for (const auto &region : output)
+      {
+        result.passes++;
+        result.area += region.Area() / 1000000.0f;
+      }
+      result.cost += RenderTime(output);
+    }
+  }
+
+  std::cout << "Replayed " << frames.size() << " frames taking " << PASS_TIME << " ms per pass and "
+            << AREA_TIME << " ms per megapixel, learned " << costModel.GetPassCost() << " ms and "
+            << costModel.GetAreaCost() << " ms\n";
+  for (const auto &result : results)
+  {
+    std::cout << StringUtils::Format("%-24s %6u passes %8.1f MP %8.1f ms rendering %8.1f us solving\n",
+                                     result.name, result.passes, result.area, result.cost, result.solveTime);
+  }
+
+  const Result &cluster = results[2];
+  for (const auto &result : results)
+    EXPECT_LE(cluster.cost, result.cost * 1.0001f) << result.name;
+}
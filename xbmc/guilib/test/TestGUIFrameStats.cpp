@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIFrameStats.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+namespace
+{
+CGUIFrameStats::Frame MakeFrame(float frameTime)
+{
+  CGUIFrameStats::Frame frame;
+  frame.frameTime = frameTime;
+  frame.stages[CGUIFrameStats::STAGE_RENDER] = frameTime / 2;
+  frame.infoUpdates = 10;
+  return frame;
+}
+}
+
+TEST(TestGUIFrameStats, Empty)
+{
+  CGUIFrameStats frameStats;
+  CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  EXPECT_EQ(0u, stats.frames);
+  EXPECT_EQ(0u, stats.window);
+  EXPECT_EQ(0.0f, stats.frameTime.p99);
+  EXPECT_EQ(CGUIFrameStats::HISTOGRAM_BUCKETS, stats.histogram.size());
+  EXPECT_TRUE(frameStats.GetFrames(10).empty());
+}
+
+TEST(TestGUIFrameStats, Percentiles)
+{
+  CGUIFrameStats frameStats;
+  // 1 to 100 ms, in reverse to check they're sorted
+  for (int i = 100; i > 0; i--)
+    frameStats.AddFrame(MakeFrame(static_cast<float>(i)));
+
+  CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  EXPECT_EQ(100u, stats.frames);
+  EXPECT_EQ(100u, stats.window);
+  EXPECT_FLOAT_EQ(50.5f, stats.frameTime.average);
+  EXPECT_FLOAT_EQ(50.0f, stats.frameTime.p50);
+  EXPECT_FLOAT_EQ(95.0f, stats.frameTime.p95);
+  EXPECT_FLOAT_EQ(99.0f, stats.frameTime.p99);
+  EXPECT_FLOAT_EQ(100.0f, stats.frameTime.max);
+  EXPECT_FLOAT_EQ(49.5f, stats.stages[CGUIFrameStats::STAGE_RENDER].p99);
+  EXPECT_FLOAT_EQ(0.0f, stats.stages[CGUIFrameStats::STAGE_SWAP].max);
+  EXPECT_FLOAT_EQ(10.0f, stats.infoUpdates);
+}
+
+TEST(TestGUIFrameStats, Histogram)
+{
+  CGUIFrameStats frameStats;
+  frameStats.AddFrame(MakeFrame(0.5f));
+  frameStats.AddFrame(MakeFrame(16.7f));
+  frameStats.AddFrame(MakeFrame(16.2f));
+  frameStats.AddFrame(MakeFrame(1000.0f));
+
+  CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  EXPECT_EQ(1u, stats.histogram[0]);
+  EXPECT_EQ(2u, stats.histogram[16]);
+  EXPECT_EQ(1u, stats.histogram.back());
+
+  frameStats.Reset();
+  stats = frameStats.GetStatistics();
+  EXPECT_EQ(0u, stats.frames);
+  EXPECT_EQ(0u, stats.histogram[16]);
+}
+
+TEST(TestGUIFrameStats, RecentFrames)
+{
+  CGUIFrameStats frameStats;
+  const unsigned int count = CGUIFrameStats::WINDOW_FRAMES + 10;
+  for (unsigned int i = 0; i < count; i++)
+    frameStats.AddFrame(MakeFrame(static_cast<float>(i)));
+
+  CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  EXPECT_EQ(count, stats.frames);
+  EXPECT_EQ(CGUIFrameStats::WINDOW_FRAMES, stats.window);
+  // the oldest 10 frames are dropped
+  EXPECT_FLOAT_EQ(10.0f + CGUIFrameStats::WINDOW_FRAMES / 2 - 1, stats.frameTime.p50);
+
+  // the latest frames, oldest first
+  std::vector<CGUIFrameStats::Frame> frames = frameStats.GetFrames(3);
+  ASSERT_EQ(3u, frames.size());
+  EXPECT_FLOAT_EQ(count - 3.0f, frames[0].frameTime);
+  EXPECT_FLOAT_EQ(count - 1.0f, frames[2].frameTime);
+}
+
+TEST(TestGUIFrameStats, Hitches)
+{
+  CGUIFrameStats frameStats;
+  for (int i = 0; i < 100; i++)
+    frameStats.AddFrame(MakeFrame(16.7f));
+
+  // slower than usual, but not a hitch
+  frameStats.AddFrame(MakeFrame(25.0f));
+  EXPECT_EQ(0u, frameStats.GetStatistics().hitches);
+
+  frameStats.AddFrame(MakeFrame(50.0f));
+  CGUIFrameStats::Frame upload = MakeFrame(50.0f);
+  upload.stages[CGUIFrameStats::STAGE_UPLOAD] = 40.0f;
+  frameStats.AddFrame(upload);
+
+  CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  EXPECT_EQ(2u, stats.hitches);
+  EXPECT_EQ(1u, stats.uploadHitches);
+
+  frameStats.Reset();
+  EXPECT_EQ(0u, frameStats.GetStatistics().hitches);
+}
+
+TEST(TestGUIFrameStats, InfoUpdatesOfTheFrameThread)
+{
+  CGUIFrameStats frameStats;
+  // the first frame has nothing to be measured against
+  frameStats.EndFrame();
+
+  for (int i = 0; i < 3; i++)
+    CGUIFrameStats::InfoBoolUpdated();
+  std::thread([]() { CGUIFrameStats::InfoBoolUpdated(); }).join();
+  frameStats.EndFrame();
+
+  std::vector<CGUIFrameStats::Frame> frames = frameStats.GetFrames(1);
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(3u, frames[0].infoUpdates);
+}
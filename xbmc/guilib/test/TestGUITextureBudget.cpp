@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUITextureBudget.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+
+namespace
+{
+class CTestOwner : public CGUITextureBudget::IOwner
+{
+public:
+  CTestOwner(CGUITextureBudget &budget, CGUITextureBudget::Category category)
+    : m_budget(budget),
+      m_category(category)
+  {
+    m_budget.RegisterOwner(m_category, this);
+  }
+
+  ~CTestOwner() override
+  {
+    m_budget.UnregisterOwner(this);
+  }
+
+  void Add(int id, unsigned int lastDrawFrame, uint64_t size)
+  {
+    m_textures[id] = { reinterpret_cast<const void*>(static_cast<intptr_t>(id)), lastDrawFrame, size };
+    m_budget.Allocated(m_category, size);
+  }
+
+  bool Has(int id) const { return m_textures.find(id) != m_textures.end(); }
+
+  void GetEvictionCandidates(std::vector<CGUITextureBudget::Candidate> &candidates) override
+  {
+    for (const auto &texture : m_textures)
+      candidates.push_back(texture.second);
+  }
+
+  bool Evict(const void *id) override
+  {
+    for (auto it = m_textures.begin(); it != m_textures.end(); ++it)
+    {
+      if (it->second.id == id)
+      {
+        m_budget.Freed(m_category, it->second.size);
+        m_textures.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  CGUITextureBudget &m_budget;
+  CGUITextureBudget::Category m_category;
+  std::map<int, CGUITextureBudget::Candidate> m_textures;
+};
+}
+
+TEST(TestGUITextureBudget, NoLimit)
+{
+  CGUITextureBudget budget;
+  CTestOwner owner(budget, CGUITextureBudget::CATEGORY_TEXTURES);
+  owner.Add(1, 0, 1000);
+  budget.EndFrame();
+
+  EXPECT_TRUE(owner.Has(1));
+  CGUITextureBudget::Statistics stats = budget.GetStatistics();
+  EXPECT_EQ(1000u, stats.used);
+  EXPECT_EQ(1000u, stats.peak);
+  EXPECT_EQ(0u, stats.overBudgetFrames);
+}
+
+TEST(TestGUITextureBudget, LeastRecentlyDrawnFirst)
+{
+  CGUITextureBudget budget;
+  budget.SetBudget(250);
+  CTestOwner textures(budget, CGUITextureBudget::CATEGORY_TEXTURES);
+  CTestOwner fonts(budget, CGUITextureBudget::CATEGORY_FONTS);
+  budget.EndFrame();
+  budget.EndFrame();
+  // drawn in the current frame, never evicted
+  const unsigned int frame = budget.GetFrame();
+  textures.Add(1, frame, 100);
+  textures.Add(2, frame - 1, 100);
+  fonts.Add(3, 0, 100);
+  textures.Add(4, 0, 100);
+  budget.EndFrame();
+
+  // the two drawn longest ago are evicted, one more would go below the budget
+  EXPECT_TRUE(textures.Has(1));
+  EXPECT_TRUE(textures.Has(2));
+  EXPECT_FALSE(fonts.Has(3));
+  EXPECT_FALSE(textures.Has(4));
+
+  CGUITextureBudget::Statistics stats = budget.GetStatistics();
+  EXPECT_EQ(200u, stats.used);
+  EXPECT_EQ(400u, stats.peak);
+  EXPECT_EQ(200u, stats.evictedBytes);
+  EXPECT_EQ(1u, stats.evictions[CGUITextureBudget::CATEGORY_TEXTURES]);
+  EXPECT_EQ(1u, stats.evictions[CGUITextureBudget::CATEGORY_FONTS]);
+  EXPECT_EQ(0u, stats.overBudgetFrames);
+}
+
+TEST(TestGUITextureBudget, OverBudget)
+{
+  CGUITextureBudget budget;
+  budget.SetBudget(150);
+  CTestOwner owner(budget, CGUITextureBudget::CATEGORY_LARGE);
+  owner.Add(1, budget.GetFrame(), 100);
+  owner.Add(2, budget.GetFrame(), 100);
+  budget.EndFrame();
+
+  EXPECT_TRUE(owner.Has(1));
+  EXPECT_TRUE(owner.Has(2));
+  EXPECT_EQ(1u, budget.GetStatistics().overBudgetFrames);
+
+  // not drawn since, the first one is enough
+  budget.EndFrame();
+  EXPECT_EQ(1, owner.Has(1) + owner.Has(2));
+  EXPECT_EQ(100u, budget.GetStatistics().categoryUsed[CGUITextureBudget::CATEGORY_LARGE]);
+  EXPECT_EQ(1u, budget.GetStatistics().overBudgetFrames);
+}
+
+TEST(TestGUITextureBudget, BudgetBelowInUse)
+{
+  CGUITextureBudget budget;
+  budget.SetBudget(150);
+  CTestOwner owner(budget, CGUITextureBudget::CATEGORY_TEXTURES);
+  budget.EndFrame();
+  const unsigned int frame = budget.GetFrame();
+  owner.Add(1, frame, 100);
+  owner.Add(2, frame, 100);
+  owner.Add(3, frame - 1, 20);
+  owner.Add(4, frame - 1, 10);
+  budget.EndFrame();
+
+  // evicting everything not drawn wouldn't get within the budget, so it's kept
+  EXPECT_TRUE(owner.Has(3));
+  EXPECT_TRUE(owner.Has(4));
+  CGUITextureBudget::Statistics stats = budget.GetStatistics();
+  EXPECT_EQ(230u, stats.used);
+  EXPECT_EQ(0u, stats.evictedBytes);
+  EXPECT_EQ(1u, stats.overBudgetFrames);
+}
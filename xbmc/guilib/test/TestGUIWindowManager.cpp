@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "guilib/GUIDialog.h"
+#include "guilib/GUIWindowManager.h"
+#include "guilib/WindowIDs.h"
+#include "rendering/RenderSystem.h"
+#include "windowing/WinSystem.h"
+
+#include "gtest/gtest.h"
+
+class TestGUIWindowManagerHelper
+{
+public:
+  static void SetActiveWindow(CGUIWindowManager &manager, int id) { manager.AddToWindowHistory(id); }
+  static void Process(CGUIWindowManager &manager, unsigned int currentTime) { manager.ProcessWindows(currentTime); }
+  static CGUIWindow* GetOccludingDialog(const CGUIWindowManager &manager) { return manager.GetOccludingDialog(); }
+};
+
+namespace
+{
+// processing windows needs a graphics context, nothing is rendered
+class CTestWinSystem : public CWinSystemBase, public CRenderSystemBase
+{
+public:
+  CRenderSystemBase *GetRenderSystem() override { return this; }
+
+  bool CreateNewWindow(const std::string& name, bool fullScreen, RESOLUTION_INFO& res) override { return false; }
+  bool ResizeWindow(int newWidth, int newHeight, int newLeft, int newTop) override { return false; }
+  bool SetFullScreen(bool fullScreen, RESOLUTION_INFO& res, bool blankOtherDisplays) override { return false; }
+  void Register(IDispResource *resource) override {}
+  void Unregister(IDispResource *resource) override {}
+
+  bool InitRenderSystem() override { return true; }
+  bool DestroyRenderSystem() override { return true; }
+  bool ResetRenderSystem(int width, int height) override { return true; }
+  bool BeginRender() override { return true; }
+  bool EndRender() override { return true; }
+  void PresentRender(bool rendered, bool videoLayer) override {}
+  bool ClearBuffers(UTILS::Color color) override { return true; }
+  bool IsExtSupported(const char* extension) const override { return false; }
+  void SetViewPort(const CRect& viewPort) override {}
+  void GetViewPort(CRect& viewPort) override {}
+  void SetScissors(const CRect &rect) override {}
+  void ResetScissors() override {}
+  void CaptureStateBlock() override {}
+  void ApplyStateBlock() override {}
+  void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor) override {}
+};
+
+class CTestWindow : public CGUIWindow
+{
+public:
+  CTestWindow() : CGUIWindow(WINDOW_HOME, "")
+  {
+    std::vector<CAnimation> animations;
+    animations.push_back(CAnimation::CreateFader(100, 0, 0, 200, ANIM_TYPE_WINDOW_CLOSE));
+    SetAnimations(animations);
+    m_bAllocated = true;
+    m_active = true;
+  }
+
+  void StartClosing() { Close_Internal(false, 0, false); }
+
+  // the window manager closes the window once this is done, see AfterRender
+  bool IsCloseAnimationRunning() { return CGUIControlGroup::IsAnimating(ANIM_TYPE_WINDOW_CLOSE); }
+};
+
+class CTestDialog : public CGUIDialog
+{
+public:
+  CTestDialog() : CGUIDialog(WINDOW_DIALOG_BUSY, "") {}
+
+  void Open(CGUIWindowManager &manager)
+  {
+    m_active = true;
+    manager.RegisterDialog(this);
+  }
+
+  bool IsOpaque(const CRect &region) const override { return true; }
+};
+}
+
+TEST(TestGUIWindowManager, CloseAnimatedWindowBehindOpaqueDialog)
+{
+  CTestWinSystem winSystem;
+  CServiceBroker::RegisterWinSystem(&winSystem);
+  {
+    CTestWindow window;
+    CTestDialog dialog;
+    CGUIWindowManager manager;
+    manager.Add(&window);
+    manager.Add(&dialog);
+    TestGUIWindowManagerHelper::SetActiveWindow(manager, window.GetID());
+
+    unsigned int time = 1000;
+    TestGUIWindowManagerHelper::Process(manager, time);
+    dialog.Open(manager);
+    TestGUIWindowManagerHelper::Process(manager, time += 20);
+    EXPECT_EQ(&dialog, TestGUIWindowManagerHelper::GetOccludingDialog(manager));
+
+    // replacing the window waits for its close animation, which has to end while it's hidden
+    window.StartClosing();
+    ASSERT_TRUE(window.IsCloseAnimationRunning());
+    for (int frame = 0; frame < 100 && window.IsCloseAnimationRunning(); frame++)
+      TestGUIWindowManagerHelper::Process(manager, time += 20);
+    EXPECT_FALSE(window.IsCloseAnimationRunning());
+    EXPECT_EQ(&dialog, TestGUIWindowManagerHelper::GetOccludingDialog(manager));
+  }
+  CServiceBroker::UnregisterWinSystem();
+}
@@ -375,6 +375,16 @@ static int ToggleDirty(const std::vector<std::string>&)
   return 0;
 }
 
+/*! \brief Toggle the frame time overlay.
+ *  \param params Ignored.
+ */
+static int ToggleFrameStats(const std::vector<std::string>&)
+{
+  CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->ToggleFrameStats();
+
+  return 0;
+}
+
 // Note: For new Texts with comma add a "\" before!!! Is used for table text.
 //
 /// \page page_List_of_built_in_functions
@@ -543,6 +553,11 @@ static int ToggleDirty(const std::vector<std::string>&)
 ///     ,
 ///     makes dirty regions visible for debugging proposes.
 ///   }
+///   \table_row2_l{
+///     <b>`ToggleFrameStats`</b>
+///     ,
+///     shows how long the GUI takes for each frame and its stages.
+///   }
 ///  \table_end
 ///
 
@@ -564,6 +579,7 @@ CBuiltins::CommandMap CGUIBuiltins::GetOperations() const
            {"setproperty",                    {"Sets a window property for the current focused window/dialog (key,value)", 2, SetProperty}},
            {"setstereomode",                  {"Changes the stereo mode of the GUI. Params can be: toggle, next, previous, select, tomono or any of the supported stereomodes (off, split_vertical, split_horizontal, row_interleaved, hardware_based, anaglyph_cyan_red, anaglyph_green_magenta, anaglyph_yellow_blue, monoscopic)", 1, SetStereoMode}},
            {"takescreenshot",                 {"Takes a Screenshot", 0, Screenshot}},
-           {"toggledirtyregionvisualization", {"Enables/disables dirty-region visualization", 0, ToggleDirty}}
+           {"toggledirtyregionvisualization", {"Enables/disables dirty-region visualization", 0, ToggleDirty}},
+           {"toggleframestats",               {"Shows/hides the frame time overlay", 0, ToggleFrameStats}}
          };
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -15,6 +16,56 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief Sources of information that info bools depend on.
+ Info bools are only updated once one of the sources they depend on changed,
+ see CGUIInfoManager::PublishChange.
+ */
+enum InfoSource
+{
+  INFO_SOURCE_NONE   = 0,      ///< constant
+  INFO_SOURCE_FRAME  = 1 << 0, ///< may change at any time, changes every frame
+  INFO_SOURCE_SKIN   = 1 << 1, ///< skin settings
+  INFO_SOURCE_PLAYER = 1 << 2, ///< player state
+  INFO_SOURCE_ALL    = (1 << 3) - 1,
+  INFO_SOURCE_COUNT  = 3
+};
+
+/*!
+ \ingroup info
+ \brief Counts the changes of each info source. Changes may be published from any thread.
+ */
+class InfoChanges
+{
+public:
+  /*! \brief Get a number that changes whenever one of the given sources changed
+   \param sources the InfoSource flags
+   */
+  inline unsigned int Get(unsigned int sources) const
+  {
+    unsigned int changes = 0;
+    for (unsigned int i = 0; sources; ++i, sources >>= 1)
+    {
+      if (sources & 1)
+        changes += m_changes[i];
+    }
+    return changes;
+  }
+
+  void Set(unsigned int sources)
+  {
+    for (unsigned int i = 0; sources; ++i, sources >>= 1)
+    {
+      if (sources & 1)
+        ++m_changes[i];
+    }
+  }
+
+private:
+  std::atomic<unsigned int> m_changes[INFO_SOURCE_COUNT] = {};
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -22,7 +73,7 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, const InfoChanges &changes);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {};
@@ -35,10 +86,15 @@ public:
   {
     if (item && m_listItemDependent)
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      const unsigned int changes = m_parentChanges.Get(m_sources);
+      if (changes != m_changes || !m_updated)
+      {
+        Update(NULL);
+        m_changes = changes;
+        m_updated = true;
+      }
     }
     return m_value;
   }
@@ -66,16 +122,19 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  unsigned int GetSources() const { return m_sources; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  unsigned int m_sources;      ///< InfoSource flags of what the value depends on
   std::string  m_expression;   ///< original expression
 
 private:
-  unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  bool m_updated;
+  unsigned int m_changes;
+  const InfoChanges &m_parentChanges;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
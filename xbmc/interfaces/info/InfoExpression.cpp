@@ -11,7 +11,10 @@
 #include "utils/log.h"
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIControlProfiler.h"
+#include "guilib/GUIFrameStats.h"
 #include "ServiceBroker.h"
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -19,26 +22,44 @@ using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  m_sources = infoMgr.GetInfoSources(m_condition);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
 {
+  GUIPROFILER_INFOBOOL_UPDATE();
+  CGUIFrameStats::InfoBoolUpdated();
   m_value = CServiceBroker::GetGUI()->GetInfoManager().GetBool(m_condition, m_context, item);
 }
 
 void InfoExpression::Initialize()
 {
-  if (!Parse(m_expression))
+  // the sources of the leaves are added while parsing
+  m_sources = INFO_SOURCE_NONE;
+  InfoSubexpressionPtr tree;
+  if (!Parse(m_expression, tree))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    tree = std::make_shared<InfoLeaf>(RegisterOperand("false"), false);
+    m_sources = INFO_SOURCE_NONE;
   }
+
+  // the tree is only needed while parsing, it's evaluated in its compiled form
+  m_program.clear();
+  m_operands.clear();
+  tree->Compile(m_program, m_operands);
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  m_value = Evaluate(0, item);
+}
+
+InfoPtr InfoExpression::RegisterOperand(const std::string &operand)
+{
+  return CServiceBroker::GetGUI()->GetInfoManager().Register(operand, m_context);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -59,9 +80,10 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoLeaf::Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &operands) const
 {
-  return m_invert ^ m_info->Get(item);
+  program.push_back({ m_info.get(), 1, NODE_LEAF, m_invert });
+  operands.push_back(m_info);
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -84,27 +106,39 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoAssociativeGroup::Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &operands) const
 {
+  const size_t pos = program.size();
+  program.push_back({ nullptr, 0, m_type, false });
+  for (const auto &child : m_children)
+    child->Compile(program, operands);
+  program[pos].size = static_cast<unsigned int>(program.size() - pos);
+}
+
+bool InfoExpression::Evaluate(size_t pos, const CGUIListItem *item)
+{
+  const Instruction &node = m_program[pos];
+  if (node.type == NODE_LEAF)
+    return node.invert ^ node.info->Get(item);
+
   /* Handle either AND or OR by using the relation
    * A AND B == !(!A OR !B)
    * to convert ANDs into ORs
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  const bool use_and = (node.type == NODE_AND);
+  const size_t first = pos + 1;
+  const size_t last = pos + node.size;
+  for (size_t child = first; child < last; child += m_program[child].size)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    if (use_and ^ Evaluate(child, item))
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      /* Move this child to the head of the group so we evaluate faster next time */
+      if (child != first)
+        std::rotate(m_program.begin() + first, m_program.begin() + child, m_program.begin() + child + m_program[child].size);
+      return !use_and;
     }
   }
-  return use_and ^ result;
+  return use_and;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -195,7 +229,7 @@ void InfoExpression::OperatorPop(std::stack<operator_t> &operator_stack, bool &i
   }
 }
 
-bool InfoExpression::Parse(const std::string &expression)
+bool InfoExpression::Parse(const std::string &expression, InfoSubexpressionPtr &tree)
 {
   const char *s = expression.c_str();
   std::string operand;
@@ -206,8 +240,6 @@ bool InfoExpression::Parse(const std::string &expression)
   bool after_binaryoperator = true;
   int bracket_count = 0;
 
-  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
-
   char c;
   // Skip leading whitespace - don't want it to count as an operand if that's all there is
   while (isspace((unsigned char)(c=*s)))
@@ -234,7 +266,7 @@ bool InfoExpression::Parse(const std::string &expression)
       }
       if (!operand.empty())
       {
-        InfoPtr info = infoMgr.Register(operand, m_context);
+        InfoPtr info = RegisterOperand(operand);
         if (!info)
         {
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
@@ -242,6 +274,7 @@ bool InfoExpression::Parse(const std::string &expression)
         }
         /* Propagate any listItem dependency from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_sources |= info->GetSources();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -285,7 +318,7 @@ bool InfoExpression::Parse(const std::string &expression)
   }
   if (!operand.empty())
   {
-    InfoPtr info = infoMgr.Register(operand, m_context);
+    InfoPtr info = RegisterOperand(operand);
     if (!info)
     {
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
@@ -293,11 +326,12 @@ bool InfoExpression::Parse(const std::string &expression)
     }
     /* Propagate any listItem dependency from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_sources |= info->GetSources();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  tree = nodes.top();
   return true;
 }
@@ -22,8 +22,8 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoSingle(const std::string &expression, int context, const InfoChanges &changes)
+    : InfoBool(expression, context, changes) {};
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
@@ -36,13 +36,21 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoExpression(const std::string &expression, int context, const InfoChanges &changes)
+    : InfoBool(expression, context, changes) {};
   ~InfoExpression() override = default;
 
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+
+protected:
+  /*! \brief Register an operand of the expression
+   \param operand the condition of the operand
+   \return the info bool of the operand
+   */
+  virtual InfoPtr RegisterOperand(const std::string &operand);
+
 private:
   typedef enum
   {
@@ -61,12 +69,24 @@ private:
     NODE_OR,
   } node_type_t;
 
-  // An abstract base class for nodes in the expression tree
+  /*! \brief A node of the compiled expression.
+   The nodes of a subexpression are stored in sequence, the group nodes are
+   followed by the nodes of their children.
+   */
+  struct Instruction
+  {
+    InfoBool *info;     ///< operand of leaf nodes, kept alive by m_operands
+    unsigned int size;  ///< number of nodes of this subexpression, including this one
+    node_type_t type;
+    bool invert;        ///< whether the value of leaf nodes is inverted
+  };
+
+  // An abstract base class for nodes in the expression tree, used while parsing
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
+    virtual void Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &operands) const = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -77,7 +97,7 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
+    void Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &operands) const override;
     node_type_t Type() const override { return NODE_LEAF; };
   private:
     InfoPtr m_info;
@@ -91,7 +111,7 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
+    void Compile(std::vector<Instruction> &program, std::vector<InfoPtr> &operands) const override;
     node_type_t Type() const override { return m_type; };
   private:
     node_type_t m_type;
@@ -100,8 +120,11 @@ private:
 
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
-  bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  bool Parse(const std::string &expression, InfoSubexpressionPtr &tree);
+  bool Evaluate(size_t pos, const CGUIListItem *item);
+
+  std::vector<Instruction> m_program; ///< the compiled expression
+  std::vector<InfoPtr> m_operands;
 };
 
 };
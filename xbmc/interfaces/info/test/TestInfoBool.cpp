@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/info/InfoBool.h"
+
+#include "gtest/gtest.h"
+
+using namespace INFO;
+
+namespace
+{
+class CTestInfoBool : public InfoBool
+{
+public:
+  CTestInfoBool(unsigned int sources, const InfoChanges &changes)
+    : InfoBool("test", 0, changes)
+  {
+    m_sources = sources;
+  }
+
+  void Update(const CGUIListItem *item) override
+  {
+    m_updates++;
+    m_value = !m_value;
+  }
+
+  int m_updates = 0;
+};
+}
+
+TEST(TestInfoBool, UpdatedOnChange)
+{
+  InfoChanges changes;
+  CTestInfoBool skin(INFO_SOURCE_SKIN, changes);
+  CTestInfoBool frame(INFO_SOURCE_FRAME, changes);
+
+  // always updated the first time
+  skin.Get();
+  frame.Get();
+  EXPECT_EQ(1, skin.m_updates);
+  EXPECT_EQ(1, frame.m_updates);
+
+  changes.Set(INFO_SOURCE_FRAME);
+  skin.Get();
+  frame.Get();
+  EXPECT_EQ(1, skin.m_updates);
+  EXPECT_EQ(2, frame.m_updates);
+
+  changes.Set(INFO_SOURCE_SKIN);
+  skin.Get();
+  skin.Get();
+  frame.Get();
+  EXPECT_EQ(2, skin.m_updates);
+  EXPECT_EQ(2, frame.m_updates);
+
+  changes.Set(INFO_SOURCE_ALL);
+  skin.Get();
+  frame.Get();
+  EXPECT_EQ(3, skin.m_updates);
+  EXPECT_EQ(3, frame.m_updates);
+}
+
+TEST(TestInfoBool, Constant)
+{
+  InfoChanges changes;
+  CTestInfoBool constant(INFO_SOURCE_NONE, changes);
+
+  EXPECT_TRUE(constant.Get());
+  changes.Set(INFO_SOURCE_ALL);
+  EXPECT_TRUE(constant.Get());
+  EXPECT_EQ(1, constant.m_updates);
+}
+
+TEST(TestInfoBool, MultipleSources)
+{
+  InfoChanges changes;
+  CTestInfoBool info(INFO_SOURCE_SKIN | INFO_SOURCE_PLAYER, changes);
+
+  info.Get();
+  changes.Set(INFO_SOURCE_PLAYER);
+  info.Get();
+  changes.Set(INFO_SOURCE_FRAME);
+  info.Get();
+  EXPECT_EQ(2, info.m_updates);
+}
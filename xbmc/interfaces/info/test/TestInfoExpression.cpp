@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "interfaces/info/InfoExpression.h"
+#include "test/TestUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+
+using namespace INFO;
+
+namespace
+{
+typedef std::map<std::string, bool> OperandValues;
+
+class CTestOperand : public InfoBool
+{
+public:
+  CTestOperand(const std::string &operand, const InfoChanges &changes, const OperandValues &values, int &updates)
+    : InfoBool(operand, 0, changes),
+      m_values(values),
+      m_updates(updates)
+  {
+    m_sources = INFO_SOURCE_FRAME;
+  }
+
+  void Update(const CGUIListItem *item) override
+  {
+    m_updates++;
+    auto it = m_values.find(m_expression);
+    m_value = it != m_values.end() && it->second;
+  }
+
+private:
+  const OperandValues &m_values;
+  int &m_updates;
+};
+
+// operands are looked up in a map instead of the info manager
+class CTestInfoExpression : public InfoExpression
+{
+public:
+  CTestInfoExpression(const std::string &expression, const InfoChanges &changes, const OperandValues &values)
+    : InfoExpression(expression, 0, changes),
+      m_changes(changes),
+      m_values(values)
+  {
+  }
+
+  int m_updates = 0;
+
+protected:
+  InfoPtr RegisterOperand(const std::string &operand) override
+  {
+    return std::make_shared<CTestOperand>(operand, m_changes, m_values, m_updates);
+  }
+
+private:
+  const InfoChanges &m_changes;
+  const OperandValues &m_values;
+};
+
+void AddConditions(const TiXmlElement *element, std::vector<std::string> &conditions)
+{
+  for (; element; element = element->NextSiblingElement())
+  {
+    const std::string name = element->ValueStr();
+    if ((name == "visible" || name == "enable" || name == "selected") &&
+        element->FirstChild() && element->FirstChild()->Type() == TiXmlNode::TINYXML_TEXT)
+      conditions.emplace_back(element->FirstChild()->ValueStr());
+    const char *condition = element->Attribute("condition");
+    if (condition)
+      conditions.emplace_back(condition);
+    AddConditions(element->FirstChildElement(), conditions);
+  }
+}
+}
+
+TEST(TestInfoExpression, Evaluate)
+{
+  const std::vector<std::pair<std::string, std::function<bool(bool, bool, bool, bool)>>> expressions =
+  {
+    { "a+b", [](bool a, bool b, bool c, bool d) { return a && b; } },
+    { "a|b", [](bool a, bool b, bool c, bool d) { return a || b; } },
+    { "!a", [](bool a, bool b, bool c, bool d) { return !a; } },
+    { "![a|b]+c", [](bool a, bool b, bool c, bool d) { return !(a || b) && c; } },
+    { "[a+!b]|[c+d]", [](bool a, bool b, bool c, bool d) { return (a && !b) || (c && d); } },
+    { "a|b+c|!d", [](bool a, bool b, bool c, bool d) { return a || (b && c) || !d; } },
+    { "!![a+[b|!c]]+d", [](bool a, bool b, bool c, bool d) { return a && (b || !c) && d; } },
+    { "![[a|b]+[c|!d]]", [](bool a, bool b, bool c, bool d) { return !((a || b) && (c || !d)); } },
+  };
+
+  InfoChanges changes;
+  OperandValues values;
+  for (const auto &expression : expressions)
+  {
+    CTestInfoExpression info(expression.first, changes, values);
+    info.Initialize();
+
+    // evaluated twice, the second time after the groups were reordered
+    for (int i = 0; i < 32; i++)
+    {
+      const bool a = i & 1, b = i & 2, c = i & 4, d = i & 8;
+      values = { { "a", a }, { "b", b }, { "c", c }, { "d", d } };
+      changes.Set(INFO_SOURCE_FRAME);
+      EXPECT_EQ(expression.second(a, b, c, d), info.Get()) << expression.first << " with " << (i % 16);
+    }
+  }
+}
+
+TEST(TestInfoExpression, ShortCircuit)
+{
+  InfoChanges changes;
+  OperandValues values = { { "a", true }, { "b", false }, { "c", false } };
+  CTestInfoExpression info("b|c|a", changes, values);
+  info.Initialize();
+
+  EXPECT_TRUE(info.Get());
+  const int updates = info.m_updates;
+  EXPECT_LE(updates, 3);
+
+  // the operand that decided the value is evaluated first from now on
+  changes.Set(INFO_SOURCE_FRAME);
+  EXPECT_TRUE(info.Get());
+  EXPECT_EQ(updates + 1, info.m_updates);
+}
+
+TEST(TestInfoExpression, DISABLED_Benchmark_Estuary)
+{
+  CFileItemList files;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory(XBMC_REF_FILE_PATH("addons/skin.estuary/xml/"), files, ".xml", XFILE::DIR_FLAG_DEFAULTS));
+
+  std::vector<std::string> conditions;
+  for (const auto &file : files)
+  {
+    CXBMCTinyXML doc;
+    if (doc.LoadFile(file->GetPath()))
+      AddConditions(doc.RootElement(), conditions);
+  }
+
+  // all operands are false, conditions using include parameters can't be resolved here
+  InfoChanges changes;
+  OperandValues values;
+  std::vector<std::unique_ptr<CTestInfoExpression>> expressions;
+  for (const auto &condition : conditions)
+  {
+    if (condition.find('$') != std::string::npos)
+      continue;
+    expressions.emplace_back(new CTestInfoExpression(condition, changes, values));
+    expressions.back()->Initialize();
+  }
+
+  const int frames = 1000;
+  int updates = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; frame++)
+  {
+    changes.Set(INFO_SOURCE_FRAME);
+    for (const auto &expression : expressions)
+    {
+      expression->Get();
+      updates += expression->m_updates;
+      expression->m_updates = 0;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << "evaluated " << expressions.size() << " of " << conditions.size()
+            << " Estuary conditions " << frames << " times in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " ms, " << updates / frames << " operands per frame" << std::endl;
+  EXPECT_FALSE(expressions.empty());
+}
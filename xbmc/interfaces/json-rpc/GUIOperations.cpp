@@ -12,6 +12,8 @@
 #include "messaging/ApplicationMessenger.h"
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIFrameStats.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/Key.h"
 #include "input/WindowTranslator.h"
@@ -122,6 +124,64 @@ JSONRPC_STATUS CGUIOperations::GetStereoscopicModes(const std::string &method, I
   return OK;
 }
 
+static CVariant GetFrameSummaryObject(const CGUIFrameStats::Summary &summary)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  result["average"] = summary.average;
+  result["p50"] = summary.p50;
+  result["p95"] = summary.p95;
+  result["p99"] = summary.p99;
+  result["max"] = summary.max;
+  return result;
+}
+
+JSONRPC_STATUS CGUIOperations::GetFrameStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CGUIFrameStats &frameStats = CGUIFrameStats::GetInstance();
+  const CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  if (parameterObject["reset"].asBoolean())
+    frameStats.Reset();
+
+  result["frames"] = stats.frames;
+  result["window"] = stats.window;
+  result["frametime"] = GetFrameSummaryObject(stats.frameTime);
+  result["stages"] = CVariant(CVariant::VariantTypeObject);
+  for (unsigned int i = 0; i < CGUIFrameStats::STAGE_COUNT; i++)
+  {
+    CGUIFrameStats::Stage stage = static_cast<CGUIFrameStats::Stage>(i);
+    result["stages"][CGUIFrameStats::GetStageName(stage)] = GetFrameSummaryObject(stats.stages[i]);
+  }
+  result["infoupdates"] = stats.infoUpdates;
+  result["hitches"] = stats.hitches;
+  result["uploadhitches"] = stats.uploadHitches;
+  result["histogram"] = CVariant(CVariant::VariantTypeArray);
+  for (unsigned int frames : stats.histogram)
+    result["histogram"].push_back(frames);
+
+  return OK;
+}
+
+JSONRPC_STATUS CGUIOperations::GetTextureStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  const CGUITextureBudget::Statistics stats = CGUITextureBudget::GetInstance().GetStatistics();
+
+  result["budget"] = stats.budget;
+  result["used"] = stats.used;
+  result["peak"] = stats.peak;
+  result["categories"] = CVariant(CVariant::VariantTypeObject);
+  for (unsigned int i = 0; i < CGUITextureBudget::CATEGORY_COUNT; i++)
+  {
+    CVariant category(CVariant::VariantTypeObject);
+    category["used"] = stats.categoryUsed[i];
+    category["evictions"] = stats.evictions[i];
+    result["categories"][CGUITextureBudget::GetCategoryName(static_cast<CGUITextureBudget::Category>(i))] = category;
+  }
+  result["evictedbytes"] = stats.evictedBytes;
+  result["overbudgetframes"] = stats.overBudgetFrames;
+
+  return OK;
+}
+
 JSONRPC_STATUS CGUIOperations::GetPropertyValue(const std::string &property, CVariant &result)
 {
   if (property == "currentwindow")
@@ -1084,9 +1084,9 @@ int CMusicDatabase::AddGenre(std::string& strGenre)
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
-    auto it = m_genreCache.find(strGenre);
-    if (it != m_genreCache.end())
-      return it->second;
+    int idGenre;
+    if (m_genreCache.Get(strGenre, idGenre))
+      return idGenre;
 
 
     strSQL=PrepareSQL("SELECT idGenre, strGenre FROM genre WHERE strGenre LIKE '%s'", strGenre.c_str());
@@ -1098,15 +1098,17 @@ int CMusicDatabase::AddGenre(std::string& strGenre)
       strSQL=PrepareSQL("INSERT INTO genre (idGenre, strGenre) values( NULL, '%s' )", strGenre.c_str());
       m_pDS->exec(strSQL);
 
-      int idGenre = (int)m_pDS->lastinsertid();
-      m_genreCache.insert(std::pair<std::string, int>(strGenre, idGenre));
+      idGenre = (int)m_pDS->lastinsertid();
+      m_genreCache.Set(strGenre, idGenre, InTransaction());
       return idGenre;
     }
     else
     {
-      int idGenre = m_pDS->fv("idGenre").get_asInt();
+      idGenre = m_pDS->fv("idGenre").get_asInt();
+      // the genre is found by the name it's given next time too, not only by its stored name
+      m_genreCache.Set(strGenre, idGenre, InTransaction());
       strGenre = m_pDS->fv("strGenre").get_asString();
-      m_genreCache.insert(std::pair<std::string, int>(strGenre, idGenre));
+      m_genreCache.Set(strGenre, idGenre, InTransaction());
       m_pDS->close();
       return idGenre;
     }
@@ -1209,6 +1211,11 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
+    int idArtist;
+    if (strMusicBrainzArtistID.empty() ? m_artistCache.Get(strArtist, idArtist)
+                                       : m_artistMBIDCache.Get(strMusicBrainzArtistID, idArtist))
+      return idArtist;
+
     // 1) MusicBrainz
     if (!strMusicBrainzArtistID.empty())
     {
@@ -1218,7 +1225,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
       m_pDS->query(strSQL);
       if (m_pDS->num_rows() > 0)
       {
-        int idArtist = m_pDS->fv("idArtist").get_asInt();
+        idArtist = m_pDS->fv("idArtist").get_asInt();
         bool update = m_pDS->fv("strArtist").get_asString().compare(strMusicBrainzArtistID) == 0;
         m_pDS->close();
         if (update)
@@ -1227,6 +1234,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
           m_pDS->exec(strSQL);
           m_pDS->close();
         }
+        m_artistMBIDCache.Set(strMusicBrainzArtistID, idArtist, InTransaction());
         return idArtist;
       }
       m_pDS->close();
@@ -1238,7 +1246,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
       m_pDS->query(strSQL);
       if (m_pDS->num_rows() > 0)
       {
-        int idArtist = m_pDS->fv("idArtist").get_asInt();
+        idArtist = m_pDS->fv("idArtist").get_asInt();
         m_pDS->close();
         // 1.b.a) We found an artist by name but with no MusicBrainz ID set, update it and assume it is our artist, flag when mbid scraped
         strSQL = PrepareSQL("UPDATE artist SET strArtist = '%s', strMusicBrainzArtistID = '%s', bScrapedMBID = %i WHERE idArtist = %i",
@@ -1247,6 +1255,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
           bScrapedMBID,
           idArtist);
         m_pDS->exec(strSQL);
+        m_artistMBIDCache.Set(strMusicBrainzArtistID, idArtist, InTransaction());
         return idArtist;
       }
 
@@ -1262,8 +1271,9 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
       m_pDS->query(strSQL);
       if (m_pDS->num_rows() > 0)
       {
-        int idArtist = m_pDS->fv("idArtist").get_asInt();
+        idArtist = m_pDS->fv("idArtist").get_asInt();
         m_pDS->close();
+        m_artistCache.Set(strArtist, idArtist, InTransaction());
         return idArtist;
       }
       m_pDS->close();
@@ -1280,7 +1290,11 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
         bScrapedMBID);
 
     m_pDS->exec(strSQL);
-    int idArtist = (int)m_pDS->lastinsertid();
+    idArtist = (int)m_pDS->lastinsertid();
+    if (strMusicBrainzArtistID.empty())
+      m_artistCache.Set(strArtist, idArtist, InTransaction());
+    else
+      m_artistMBIDCache.Set(strMusicBrainzArtistID, idArtist, InTransaction());
     return idArtist;
   }
   catch (...)
@@ -1338,6 +1352,10 @@ int  CMusicDatabase::UpdateArtist(int idArtist,
 
   strSQL += PrepareSQL(" WHERE idArtist = %i", idArtist);
 
+  // the name and MusicBrainz ID may change
+  m_artistCache.Clear();
+  m_artistMBIDCache.Clear();
+
   bool status = ExecuteQuery(strSQL);
   if (status)
     AnnounceUpdate(MediaTypeArtist, idArtist);
@@ -1569,6 +1587,9 @@ int CMusicDatabase::AddRole(const std::string &strRole)
   {
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
+    if (m_roleCache.Get(strRole, idRole))
+      return idRole;
+
     strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() > 0)
@@ -1582,6 +1603,7 @@ int CMusicDatabase::AddRole(const std::string &strRole)
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
+    m_roleCache.Set(strRole, idRole, InTransaction());
   }
   catch (...)
   {
@@ -2077,9 +2099,9 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
-    auto it = m_pathCache.find(strPath);
-    if (it != m_pathCache.end())
-      return it->second;
+    int idPath;
+    if (m_pathCache.Get(strPath, idPath))
+      return idPath;
 
     strSQL=PrepareSQL( "select * from path where strPath='%s'", strPath.c_str());
     m_pDS->query(strSQL);
@@ -2090,14 +2112,14 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
       strSQL=PrepareSQL("insert into path (idPath, strPath) values( NULL, '%s' )", strPath.c_str());
       m_pDS->exec(strSQL);
 
-      int idPath = (int)m_pDS->lastinsertid();
-      m_pathCache.insert(std::pair<std::string, int>(strPath, idPath));
+      idPath = (int)m_pDS->lastinsertid();
+      m_pathCache.Set(strPath, idPath, InTransaction());
       return idPath;
     }
     else
     {
-      int idPath = m_pDS->fv("idPath").get_asInt();
-      m_pathCache.insert(std::pair<std::string, int>(strPath, idPath));
+      idPath = m_pDS->fv("idPath").get_asInt();
+      m_pathCache.Set(strPath, idPath, InTransaction());
       m_pDS->close();
       return idPath;
     }
@@ -2957,8 +2979,43 @@ bool CMusicDatabase::GetSongsByPath(const std::string& strPath1, MAPSONGS& songs
 
 void CMusicDatabase::EmptyCache()
 {
-  m_genreCache.erase(m_genreCache.begin(), m_genreCache.end());
-  m_pathCache.erase(m_pathCache.begin(), m_pathCache.end());
+  m_genreCache.Clear();
+  m_pathCache.Clear();
+  m_artistCache.Clear();
+  m_artistMBIDCache.Clear();
+  m_roleCache.Clear();
+}
+
+bool CMusicDatabase::CIdCache::Get(const std::string& key, int& id) const
+{
+  auto it = m_ids.find(key);
+  if (it == m_ids.end())
+    return false;
+
+  id = it->second;
+  return true;
+}
+
+void CMusicDatabase::CIdCache::Set(const std::string& key, int id, bool inTransaction)
+{
+  if (id < 0)
+    return;
+
+  if (m_ids.insert(std::make_pair(key, id)).second && inTransaction)
+    m_added.push_back(key);
+}
+
+void CMusicDatabase::CIdCache::Rollback()
+{
+  for (const auto& key : m_added)
+    m_ids.erase(key);
+  m_added.clear();
+}
+
+void CMusicDatabase::CIdCache::Clear()
+{
+  m_ids.clear();
+  m_added.clear();
 }
 
 bool CMusicDatabase::Search(const std::string& search, CFileItemList &items)
@@ -3250,6 +3307,7 @@ bool CMusicDatabase::CleanupPaths()
       // do the deletion, and drop our temp table
       std::string deleteSQL = "DELETE FROM path WHERE idPath IN (" + StringUtils::Join(pathIds, ",") + ")";
       m_pDS->exec(deleteSQL);
+      m_pathCache.Clear();
     }
     m_pDS->exec("drop table songpaths");
     return true;
@@ -3285,6 +3343,8 @@ bool CMusicDatabase::CleanupArtists()
     m_pDS->exec("CREATE TEMPORARY TABLE tmp_keep (idArtist INTEGER PRIMARY KEY)");
     m_pDS->exec("INSERT INTO tmp_keep SELECT DISTINCT idArtist from tmp_delartists");
     m_pDS->exec("DELETE FROM artist WHERE idArtist NOT IN (SELECT idArtist FROM tmp_keep)");
+    m_artistCache.Clear();
+    m_artistMBIDCache.Clear();
     // Tidy up temp tables
     m_pDS->exec("DROP TABLE tmp_delartists");
     m_pDS->exec("DROP TABLE tmp_keep");
@@ -3307,6 +3367,7 @@ bool CMusicDatabase::CleanupGenres()
     // Must be executed AFTER the song, and song_genre have been cleaned.
     std::string strSQL = "DELETE FROM genre WHERE idGenre NOT IN (SELECT idGenre FROM song_genre)";
     m_pDS->exec(strSQL);
+    m_genreCache.Clear();
     return true;
   }
   catch (...)
@@ -3343,6 +3404,7 @@ bool CMusicDatabase::CleanupRoles()
     // Do not remove default role (ROLE_ARTIST)
     std::string strSQL = "DELETE FROM role WHERE idRole > 1 AND idRole NOT IN (SELECT idRole FROM song_artist)";
     m_pDS->exec(strSQL);
+    m_roleCache.Clear();
     return true;
   }
   catch (...)
@@ -9055,6 +9117,7 @@ bool CMusicDatabase::RemoveSongsFromPath(const std::string &path1, MAPSONGS& son
     // and remove the path as well (it'll be re-added later on with the new hash if it's non-empty)
     sql = "delete from path" + where;
     m_pDS->exec(sql);
+    m_pathCache.Clear();
     return iRowsFound > 0;
   }
   catch (...)
@@ -9219,7 +9282,14 @@ int CMusicDatabase::GetSongIDFromPath(const std::string &filePath)
 bool CMusicDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
-  { // number of items in the db has likely changed, so reset the infomanager cache
+  {
+    m_genreCache.Commit();
+    m_pathCache.Commit();
+    m_artistCache.Commit();
+    m_artistMBIDCache.Commit();
+    m_roleCache.Commit();
+
+    // number of items in the db has likely changed, so reset the infomanager cache
     CGUIComponent* gui = CServiceBroker::GetGUI();
     if (gui)
     {
@@ -9230,6 +9300,18 @@ bool CMusicDatabase::CommitTransaction()
   return false;
 }
 
+void CMusicDatabase::RollbackTransaction()
+{
+  CDatabase::RollbackTransaction();
+
+  // the rows added by the transaction are gone
+  m_genreCache.Rollback();
+  m_pathCache.Rollback();
+  m_artistCache.Rollback();
+  m_artistMBIDCache.Rollback();
+  m_roleCache.Rollback();
+}
+
 bool CMusicDatabase::SetScraperAll(const std::string & strBaseDir, const ADDON::ScraperPtr scraper)
 {
   if (NULL == m_pDB.get()) return false;
@@ -105,6 +105,7 @@ public:
 
   bool Open() override;
   bool CommitTransaction() override;
+  void RollbackTransaction() override;
   void EmptyCache();
   void Clean();
   int  Cleanup(CGUIDialogProgress* progressDialog = nullptr);
@@ -630,8 +631,28 @@ std::string GetLibraryLastUpdated();
 void SetLibraryLastUpdated();
 
 protected:
-  std::map<std::string, int> m_genreCache;
-  std::map<std::string, int> m_pathCache;
+  /*! \brief Ids of the rows of a lookup table, by name
+   Ids added while a transaction is open are dropped again if it's rolled back.
+   */
+  class CIdCache
+  {
+  public:
+    bool Get(const std::string& key, int& id) const;
+    void Set(const std::string& key, int id, bool inTransaction);
+    void Commit() { m_added.clear(); }
+    void Rollback();
+    void Clear();
+
+  private:
+    std::map<std::string, int> m_ids;
+    std::vector<std::string> m_added; //!< keys added by the open transaction
+  };
+
+  CIdCache m_genreCache;
+  CIdCache m_pathCache;
+  CIdCache m_artistCache; //!< artists added without MusicBrainz ID, by name
+  CIdCache m_artistMBIDCache; //!< artists by MusicBrainz ID
+  CIdCache m_roleCache;
 
   void CreateTables() override;
   void CreateAnalytics() override;
@@ -9,6 +9,9 @@
 #include "MusicInfoScanner.h"
 
 #include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
 #include <utility>
 
 #include "ServiceBroker.h"
@@ -23,6 +26,7 @@
 #include "events/MediaLibraryEvent.h"
 #include "FileItem.h"
 #include "filesystem/Directory.h"
+#include "filesystem/DirectoryManifest.h"
 #include "filesystem/File.h"
 #include "filesystem/MusicDatabaseDirectory.h"
 #include "filesystem/MusicDatabaseDirectory/DirectoryNode.h"
@@ -46,10 +50,14 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "TextureCache.h"
+#include "URL.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "Util.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -62,6 +70,31 @@ using namespace MUSIC_GRABBER;
 using namespace ADDON;
 using KODI::UTILITY::CDigest;
 
+namespace
+{
+// tag reader jobs queued or running per source. Jobs of a stopped scan may still be queued when
+// the next one starts, they count until they ran
+CCriticalSection tagReaderSection;
+std::map<std::string, unsigned int> tagReaderJobs;
+
+unsigned int AcquireTagReaders(const std::string& source, unsigned int wanted, unsigned int limit)
+{
+  CSingleLock lock(tagReaderSection);
+  unsigned int& jobs = tagReaderJobs[source];
+  const unsigned int granted = jobs < limit ? std::min(wanted, limit - jobs) : 0;
+  jobs += granted;
+  return granted;
+}
+
+void ReleaseTagReader(const std::string& source)
+{
+  CSingleLock lock(tagReaderSection);
+  auto it = tagReaderJobs.find(source);
+  if (it != tagReaderJobs.end() && --it->second == 0)
+    tagReaderJobs.erase(it);
+}
+}
+
 CMusicInfoScanner::CMusicInfoScanner()
 : m_fileCountReader(this, "MusicFileCounter")
 {
@@ -111,6 +144,8 @@ void CMusicInfoScanner::Process()
       // Reset progress vars
       m_currentItem=0;
       m_itemCount=-1;
+      m_tagFilesRead = 0;
+      m_tagReadTime = 0;
 
       // Create the thread to count all files to be scanned
       if (m_handle)
@@ -186,9 +221,13 @@ void CMusicInfoScanner::Process()
       m_fileCountReader.StopThread();
 
       m_musicDatabase.EmptyCache();
+      GetDirectoryManifest().Save();
 
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      if (m_tagReadTime > 0)
+        CLog::Log(LOGNOTICE, "My Music: Read tags of %u files in %s (%.1f files/s)", m_tagFilesRead,
+                  StringUtils::SecondsToTimeString(m_tagReadTime / 1000).c_str(), m_tagFilesRead * 1000.0f / m_tagReadTime);
     }
     if (m_scanType == 1) // load album info
     {
@@ -478,6 +517,33 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   if (HasNoMedia(strDirectory))
     return true;
 
+  const bool incremental = IsIncremental(strDirectory);
+  const std::string manifestSettings = incremental ? StringUtils::Join(regexps, "|") : "";
+  std::vector<std::string> subDirectories;
+  if (incremental && GetDirectoryManifest().IsUnchanged(strDirectory, manifestSettings, subDirectories))
+  { // unchanged since the last scan - only look at the subfolders
+    CLog::Log(LOGDEBUG, "%s Skipping dir '%s' due to no change (manifest)", __FUNCTION__, CURL::GetRedacted(strDirectory).c_str());
+    if (m_handle)
+    {
+      std::vector<std::string> files;
+      std::vector<std::string> recordedSubDirectories;
+      if (GetDirectoryManifest().GetRecorded(strDirectory, files, recordedSubDirectories))
+        m_currentItem += CountFiles(files);
+      if (m_itemCount>0)
+        m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+      OnDirectoryScanned(strDirectory);
+    }
+
+    for (const auto& subDirectory : subDirectories)
+    {
+      if (m_bStop)
+        break;
+      if (!DoScan(subDirectory))
+        m_bStop = true;
+    }
+    return !m_bStop;
+  }
+
   // load subfolder
   CFileItemList items;
   CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
@@ -546,6 +612,15 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
       }
     }
   }
+
+  // record the directory once it and its subfolders are done, an interrupted scan lists it again
+  if (incremental && !m_bStop)
+  {
+    if (hash.empty())
+      GetDirectoryManifest().Remove(strDirectory);
+    else
+      GetDirectoryManifest().Update(strDirectory, manifestSettings, items);
+  }
   return !m_bStop;
 }
 
@@ -554,11 +629,10 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> files;
+  files.reserve(items.Size());
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -567,19 +641,16 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
-
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (NULL != pLoader.get())
-        pLoader->Load(pItem->GetPath(), tag);
-    }
+    files.push_back(pItem);
+  }
 
-    if (m_handle && m_itemCount>0)
-      m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+  if (!LoadTags(files, items.GetPath()))
+    return INFO_CANCELLED;
 
+  // merge back in the order of the directory listing
+  for (const auto& pItem : files)
+  {
+    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
     if (!tag.Loaded() && !pItem->HasCueDocument())
     {
       CLog::Log(LOGDEBUG, "%s - No tag found for: %s", __FUNCTION__, pItem->GetPath().c_str());
@@ -599,6 +670,152 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
   return INFO_ADDED;
 }
 
+bool CMusicInfoScanner::LoadTags(const std::vector<CFileItemPtr>& items, const std::string& directory)
+{
+  if (items.empty())
+    return !m_bStop;
+
+  unsigned int tick = XbmcThreads::SystemClockMillis();
+
+  // shared with the workers, which may start or still be finishing when we stop waiting
+  struct SState
+  {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<unsigned int> pending{0}; //!< workers not finished yet, started or not
+    CEvent finished{true};
+
+    CCriticalSection section;
+    unsigned int active = 0; //!< workers using the scanner and the items
+    bool abandoned = false; //!< workers starting now must not touch the scanner or the items
+  };
+  auto state = std::make_shared<SState>();
+  const std::string source = GetTagReaderSource(directory);
+  const unsigned int limit = GetTagReaderThreads(directory);
+  const unsigned int workers = AcquireTagReaders(source, static_cast<unsigned int>(std::min<size_t>(items.size(), limit)), limit);
+  // the scanner reads the tags itself if the jobs of the source are all taken
+  state->pending = std::max(workers, 1u);
+
+  auto work = [this, &items, state]()
+  {
+    bool abandoned;
+    {
+      CSingleLock lock(state->section);
+      abandoned = state->abandoned;
+      if (!abandoned)
+        state->active++;
+    }
+
+    if (!abandoned)
+    {
+      size_t i;
+      while (!m_bStop && (i = state->next++) < items.size())
+      {
+        CFileItem& item = *items[i];
+        CMusicInfoTag& tag = *item.GetMusicInfoTag();
+        if (!tag.Loaded())
+        {
+          std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+          if (NULL != pLoader.get())
+            pLoader->Load(item.GetPath(), tag);
+        }
+        state->done++;
+      }
+
+      CSingleLock lock(state->section);
+      state->active--;
+    }
+
+    if (--state->pending == 0)
+      state->finished.Set();
+  };
+
+  // reading a tag mostly waits on the (network) file system, so several files are read at once
+  for (unsigned int worker = workers; worker > 0; worker--)
+  {
+    auto job = [work, source]()
+    {
+      work();
+      ReleaseTagReader(source);
+    };
+    // the job manager drops jobs once it's cancelling them, e.g. while shutting down
+    if (!CJobManager::GetInstance().Submit(job, CJob::PRIORITY_NORMAL))
+      job();
+  }
+  if (workers == 0)
+    work();
+
+  const int currentItem = m_currentItem;
+  bool completed = false;
+  while (!completed)
+  {
+    completed = state->finished.WaitMSec(200);
+    if (!completed && m_bStop)
+    {
+      // workers that didn't start yet may never run, only wait for those reading tags
+      CSingleLock lock(state->section);
+      state->abandoned = true;
+      completed = state->active == 0;
+    }
+
+    const size_t done = state->done;
+    m_currentItem = currentItem + static_cast<int>(done);
+    if (m_handle)
+    {
+      if (m_itemCount > 0)
+        m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+
+      unsigned int elapsed = m_tagReadTime + XbmcThreads::SystemClockMillis() - tick;
+      if (elapsed > 0)
+        m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(508).c_str(),
+                                               (m_tagFilesRead + done) * 1000.0f / elapsed));
+    }
+  }
+
+  m_tagFilesRead += state->done;
+  m_tagReadTime += XbmcThreads::SystemClockMillis() - tick;
+
+  return !m_bStop;
+}
+
+unsigned int CMusicInfoScanner::GetTagReaderThreads(const std::string& path)
+{
+  // optical drives only get slower when seeking between files
+  if (URIUtils::IsOnDVD(path))
+    return 1;
+
+  // a second reader hides the parsing on local disks, more mostly add seeks
+  const unsigned int threads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagReaderThreads;
+  if (URIUtils::IsHD(path))
+    return std::min(threads, 2u);
+
+  return threads;
+}
+
+std::string CMusicInfoScanner::GetTagReaderSource(const std::string& path)
+{
+  if (URIUtils::IsOnDVD(path))
+    return "optical";
+  if (URIUtils::IsHD(path))
+    return "local";
+
+  // the files of a network share are all read from the same server
+  const CURL url(path);
+  return url.GetProtocol() + "://" + url.GetHostName();
+}
+
+CDirectoryManifest& CMusicInfoScanner::GetDirectoryManifest()
+{
+  return CServiceBroker::GetMusicScanManifest();
+}
+
+bool CMusicInfoScanner::IsIncremental(const std::string& directory) const
+{
+  // a forced rescan lists every directory again
+  return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bMusicLibraryIncrementalScan &&
+         !(m_flags & SCAN_RESCAN) && CDirectoryManifest::IsSupported(directory);
+}
+
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
 {
   return song.iTrack < song2.iTrack;
@@ -2220,6 +2437,21 @@ void CMusicInfoScanner::Run()
 // Recurse through all folders we scan and count files
 int CMusicInfoScanner::CountFilesRecursively(const std::string& strPath)
 {
+  // an incremental scan doesn't list the directories it recorded, neither does counting
+  std::vector<std::string> files;
+  std::vector<std::string> subDirectories;
+  if (IsIncremental(strPath) && GetDirectoryManifest().GetRecorded(strPath, files, subDirectories))
+  {
+    int count = CountFiles(files);
+    for (const auto& subDirectory : subDirectories)
+    {
+      if (m_bStop)
+        return 0;
+      count += CountFilesRecursively(subDirectory);
+    }
+    return count;
+  }
+
   // load subfolder
   CFileItemList items;
   CDirectory::GetDirectory(strPath, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions(), DIR_FLAG_NO_FILE_DIRS);
@@ -2246,3 +2478,15 @@ int CMusicInfoScanner::CountFiles(const CFileItemList &items, bool recursive)
   }
   return count;
 }
+
+int CMusicInfoScanner::CountFiles(const std::vector<std::string>& files)
+{
+  int count = 0;
+  for (const auto& file : files)
+  {
+    CFileItem item(file, false);
+    if (item.IsAudio() && !item.IsPlayList() && !item.IsNFO())
+      count++;
+  }
+  return count;
+}
@@ -19,6 +19,11 @@ class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
 
+namespace XFILE
+{
+  class CDirectoryManifest;
+}
+
 namespace MUSIC_INFO
 {
 
@@ -207,12 +212,40 @@ protected:
    \param scannedItems [in] list to populate with the scannedItems
    */
   INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Load the tags of the items that don't have them loaded yet
+   Tags are read by jobs, at most GetTagReaderThreads() of them queued or running per source.
+   Progress is reported while waiting.
+   \param items [in] the items to load the tags of
+   \param directory [in] the directory of the items
+   \return false if the scan was stopped
+   */
+  bool LoadTags(const std::vector<CFileItemPtr>& items, const std::string& directory);
+
+  /*! \brief Number of files of the source at path whose tags are read at once
+   */
+  static unsigned int GetTagReaderThreads(const std::string& path);
+
+  /*! \brief The source the files at path are read from, e.g. the server of a network share
+   */
+  static std::string GetTagReaderSource(const std::string& path);
+
+  /*! \brief Manifest of the music directories seen by incremental scans
+   */
+  static XFILE::CDirectoryManifest& GetDirectoryManifest();
+
+  /*! \brief Whether directory is scanned incrementally, i.e. only listed if changed
+   */
+  bool IsIncremental(const std::string& directory) const;
   int GetPathHash(const CFileItemList &items, std::string &hash);
   void GetAlbumArtwork(long id, const CAlbum &artist);
 
   void Run() override;
   int CountFiles(const CFileItemList& items, bool recursive);
   int CountFilesRecursively(const std::string& strPath);
+  /*! \brief Count the music files among the paths of files, as CountFiles() does for a listing
+   */
+  static int CountFiles(const std::vector<std::string>& files);
 
   /*! \brief Resolve a MusicBrainzID to a URL
    If we have a MusicBrainz ID for an artist or album,
@@ -227,6 +260,8 @@ protected:
 
   int m_currentItem;
   int m_itemCount;
+  unsigned int m_tagFilesRead = 0;
+  unsigned int m_tagReadTime = 0; //!< time spent reading tags in ms
   bool m_bStop;
   bool m_needsCleanup = false;
   int m_scanType = 0; // 0 - load from files, 1 - albums, 2 - artists
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "music/MusicDatabase.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+
+class TestMusicDatabase : public ::testing::Test
+{
+protected:
+  DatabaseSettings settings;
+  CMusicDatabase database;
+
+  void SetUp() override
+  {
+    XFILE::CFile::Delete("special://temp/TestMusicDatabase.db");
+
+    settings.type = "sqlite3";
+    settings.name = "TestMusicDatabase";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+
+    ASSERT_TRUE(database.Connect("TestMusicDatabase", settings, true));
+  }
+
+  void TearDown() override
+  {
+    database.Close();
+    XFILE::CFile::Delete("special://temp/TestMusicDatabase.db");
+  }
+
+  static CAlbum CreateAlbum(int index, int tracks)
+  {
+    CAlbum album;
+    album.strAlbum = StringUtils::Format("Album %i", index);
+    album.strPath = StringUtils::Format("/music/%i/album %i/", index / 100, index);
+    album.iYear = 1950 + index % 70;
+    album.genre = { StringUtils::Format("Genre %i", index % 30) };
+    album.artistCredits.emplace_back(StringUtils::Format("Artist %i", index % 2000));
+
+    for (int i = 0; i < tracks; i++)
+    {
+      CSong song;
+      song.strTitle = StringUtils::Format("Track %i", i + 1);
+      song.strFileName = StringUtils::Format("%strack %02i.flac", album.strPath.c_str(), i + 1);
+      song.iTrack = i + 1;
+      song.iDuration = 240;
+      song.genre = album.genre;
+      song.artistCredits = album.artistCredits;
+      if (i % 3 == 0)
+        song.artistCredits.emplace_back(StringUtils::Format("Artist %i", (index * 7 + i) % 20000));
+      song.AppendArtistRole(CMusicRole("Composer", StringUtils::Format("Composer %i", index % 500)));
+      album.songs.push_back(song);
+    }
+    return album;
+  }
+};
+
+TEST_F(TestMusicDatabase, LookupCacheRollback)
+{
+  std::string rock = "Rock";
+  database.BeginTransaction();
+  int idGenre = database.AddGenre(rock);
+  EXPECT_EQ(idGenre, database.AddGenre(rock));
+  database.RollbackTransaction();
+
+  // the cached id went with the transaction
+  idGenre = database.AddGenre(rock);
+  ASSERT_GT(idGenre, 0);
+  EXPECT_EQ("Rock", database.GetSingleValue("genre", "strGenre", StringUtils::Format("idGenre=%i", idGenre)));
+
+  // ids added outside of a transaction stay cached
+  database.BeginTransaction();
+  database.RollbackTransaction();
+  EXPECT_EQ(idGenre, database.AddGenre(rock));
+}
+
+TEST_F(TestMusicDatabase, LookupCacheCleanup)
+{
+  int idArtist = database.AddArtist("Artist", "");
+  ASSERT_GT(idArtist, 0);
+  EXPECT_EQ(idArtist, database.AddArtist("Artist", ""));
+
+  // the artist isn't linked to anything and is removed
+  EXPECT_TRUE(database.CleanupOrphanedItems());
+  EXPECT_EQ("", database.GetSingleValue("artist", "strArtist", StringUtils::Format("idArtist=%i", idArtist)));
+
+  idArtist = database.AddArtist("Artist", "");
+  ASSERT_GT(idArtist, 0);
+  EXPECT_EQ("Artist", database.GetSingleValue("artist", "strArtist", StringUtils::Format("idArtist=%i", idArtist)));
+}
+
+TEST_F(TestMusicDatabase, DISABLED_Benchmark_AddAlbum)
+{
+  // 100k tracks
+  const int albums = 10000;
+  const int tracks = 10;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < albums; i++)
+  {
+    CAlbum album = CreateAlbum(i, tracks);
+    database.EmptyCache();
+    database.AddAlbum(album, -1);
+  }
+  auto uncached = std::chrono::steady_clock::now() - start;
+
+  database.Close();
+  XFILE::CFile::Delete("special://temp/TestMusicDatabase.db");
+  ASSERT_TRUE(database.Connect("TestMusicDatabase", settings, true));
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < albums; i++)
+  {
+    CAlbum album = CreateAlbum(i, tracks);
+    database.AddAlbum(album, -1);
+  }
+  auto cached = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(albums * tracks, database.GetSongsCount());
+  std::cout << albums * tracks << " tracks: lookups cached per album "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(uncached).count() << " ms, for the import "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(cached).count() << " ms" << std::endl;
+}
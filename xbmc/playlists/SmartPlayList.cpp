@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "SmartPlayList.h"
+#include "SmartPlaylistCache.h"
 #include "Util.h"
 #include "dbwrappers/Database.h"
 #include "filesystem/File.h"
@@ -21,6 +22,7 @@
 #include "utils/DatabaseUtils.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/JSONVariantWriter.h"
+#include "XBDateTime.h"
 #include "utils/log.h"
 #include "utils/StreamDetails.h"
 #include "utils/StringUtils.h"
@@ -1428,7 +1430,22 @@ bool CSmartPlaylist::IsMusicType(const std::string &type)
 
 std::string CSmartPlaylist::GetWhereClause(const CDatabase &db, std::set<std::string> &referencedPlaylists) const
 {
-  return m_ruleCombination.GetWhereClause(db, GetType(), referencedPlaylists);
+  // the playlists already referenced are left out, so only the clauses of top level playlists are kept
+  CVariant rules;
+  std::string key;
+  if (!referencedPlaylists.empty() || !m_ruleCombination.Save(rules) || !CJSONVariantWriter::Write(rules, key, true))
+    return m_ruleCombination.GetWhereClause(db, GetType(), referencedPlaylists);
+
+  // rules relative to the current date are compiled again the next day
+  key = GetType() + "|" + CDateTime::GetCurrentDateTime().GetAsDBDate() + "|" + key;
+
+  std::string where;
+  if (CSmartPlaylistCache::GetInstance().GetWhereClause(key, where, referencedPlaylists))
+    return where;
+
+  where = m_ruleCombination.GetWhereClause(db, GetType(), referencedPlaylists);
+  CSmartPlaylistCache::GetInstance().SetWhereClause(key, where, referencedPlaylists);
+  return where;
 }
 
 void CSmartPlaylist::GetVirtualFolders(std::vector<std::string> &virtualFolders) const
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SmartPlaylistCache.h"
+#include "FileItem.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/SingleLock.h"
+
+namespace
+{
+const size_t MAX_WHERE_CLAUSES = 64;
+const size_t MAX_ITEM_LISTS = 16;
+const int MAX_CACHED_ITEMS = 1000; //!< bigger listings aren't kept
+}
+
+CSmartPlaylistCache& CSmartPlaylistCache::GetInstance()
+{
+  static CSmartPlaylistCache sSmartPlaylistCache;
+  return sSmartPlaylistCache;
+}
+
+void CSmartPlaylistCache::OnSettingsLoaded()
+{
+  Clear();
+}
+
+void CSmartPlaylistCache::OnSettingsSaved() const
+{
+  // the settings affect how the library is listed
+  Clear();
+}
+
+void CSmartPlaylistCache::OnSettingsUnloaded()
+{
+  Clear();
+}
+
+CSmartPlaylistCache::Sources CSmartPlaylistCache::GetSources(const std::set<std::string> &playlists)
+{
+  // playlists are referred to by name, so new ones in the folders may match too
+  std::set<std::string> paths(playlists);
+  paths.insert("special://musicplaylists/");
+  paths.insert("special://videoplaylists/");
+
+  Sources sources;
+  for (const auto &path : paths)
+  {
+    struct __stat64 buffer;
+    int64_t mtime = XFILE::CFile::Stat(path, &buffer) == 0 ? static_cast<int64_t>(buffer.st_mtime) : -1;
+    sources.emplace_back(CSpecialProtocol::TranslatePath(path), mtime);
+  }
+  return sources;
+}
+
+bool CSmartPlaylistCache::GetWhereClause(const std::string &key, std::string &where, std::set<std::string> &referencedPlaylists) const
+{
+  SWhereClause whereClause;
+  {
+    CSingleLock lock(m_section);
+    auto it = m_whereClauses.find(key);
+    if (it == m_whereClauses.end())
+      return false;
+    whereClause = it->second;
+  }
+
+  if (GetSources(whereClause.playlists) != whereClause.sources)
+    return false;
+
+  where = whereClause.where;
+  referencedPlaylists.insert(whereClause.playlists.begin(), whereClause.playlists.end());
+  return true;
+}
+
+void CSmartPlaylistCache::SetWhereClause(const std::string &key, const std::string &where, const std::set<std::string> &referencedPlaylists)
+{
+  SWhereClause whereClause;
+  whereClause.where = where;
+  whereClause.playlists = referencedPlaylists;
+  whereClause.sources = GetSources(referencedPlaylists);
+
+  CSingleLock lock(m_section);
+  if (m_whereClauses.size() >= MAX_WHERE_CLAUSES && m_whereClauses.find(key) == m_whereClauses.end())
+    m_whereClauses.clear();
+  m_whereClauses[key] = std::move(whereClause);
+}
+
+bool CSmartPlaylistCache::GetItems(const std::string &key, unsigned int changes, CFileItemList &items, bool &result) const
+{
+  std::shared_ptr<const CFileItemList> cachedItems;
+  {
+    CSingleLock lock(m_section);
+    for (auto it = m_items.begin(); it != m_items.end(); ++it)
+    {
+      if (it->first != key)
+        continue;
+
+      if (it->second.changes != changes)
+      {
+        m_items.erase(it);
+        return false;
+      }
+
+      m_items.splice(m_items.begin(), m_items, it);
+      cachedItems = it->second.items;
+      result = it->second.result;
+      break;
+    }
+  }
+
+  if (!cachedItems)
+    return false;
+
+  // the items are changed by whoever lists them, hand out a copy
+  items.Copy(*cachedItems);
+  return true;
+}
+
+void CSmartPlaylistCache::SetItems(const std::string &key, unsigned int changes, const CFileItemList &items, bool result)
+{
+  if (items.Size() > MAX_CACHED_ITEMS)
+    return;
+
+  std::shared_ptr<CFileItemList> cachedItems = std::make_shared<CFileItemList>();
+  cachedItems->Copy(items);
+
+  CSingleLock lock(m_section);
+  for (auto it = m_items.begin(); it != m_items.end(); ++it)
+  {
+    if (it->first == key)
+    {
+      m_items.erase(it);
+      break;
+    }
+  }
+
+  SItems entry;
+  entry.changes = changes;
+  entry.result = result;
+  entry.items = cachedItems;
+  m_items.emplace_front(key, entry);
+  if (m_items.size() > MAX_ITEM_LISTS)
+    m_items.pop_back();
+}
+
+void CSmartPlaylistCache::Clear() const
+{
+  CSingleLock lock(m_section);
+  m_whereClauses.clear();
+  m_items.clear();
+}
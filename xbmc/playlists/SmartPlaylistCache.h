@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "settings/lib/ISettingsHandler.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CFileItemList;
+
+/*!
+ \brief Keeps the WHERE clauses compiled from smart playlist rules and the items
+ of smart playlists listed from the library, so unchanged playlists (e.g. the
+ ones behind skin widgets) don't have to be compiled and queried again.
+
+ A WHERE clause is valid as long as the playlists it refers to are unchanged,
+ the items as long as the databases they come from are. Everything is dropped
+ when the settings change.
+ */
+class CSmartPlaylistCache : public ISettingsHandler
+{
+public:
+  static CSmartPlaylistCache& GetInstance();
+
+  void OnSettingsLoaded() override;
+  void OnSettingsSaved() const override;
+  void OnSettingsUnloaded() override;
+
+  /*! \brief Get a WHERE clause compiled before
+   \param key the type of the playlist and its rules
+   \param where [out] the WHERE clause
+   \param referencedPlaylists [out] the playlists referred to by the rules
+   \return true if the WHERE clause is still valid, false if the rules need to be compiled
+   */
+  bool GetWhereClause(const std::string &key, std::string &where, std::set<std::string> &referencedPlaylists) const;
+  void SetWhereClause(const std::string &key, const std::string &where, const std::set<std::string> &referencedPlaylists);
+
+  /*! \brief Get the items of a smart playlist listed before
+   \param key the playlist and how it was listed
+   \param changes the changes of the databases the items come from, \sa CDatabase::GetChanges
+   \param items [out] a copy of the items
+   \param result [out] whether listing the playlist succeeded
+   \return true if the items are still valid, false if the playlist needs to be listed
+   */
+  bool GetItems(const std::string &key, unsigned int changes, CFileItemList &items, bool &result) const;
+  void SetItems(const std::string &key, unsigned int changes, const CFileItemList &items, bool result);
+
+  void Clear() const;
+
+private:
+  CSmartPlaylistCache() = default;
+  CSmartPlaylistCache(const CSmartPlaylistCache&) = delete;
+  CSmartPlaylistCache& operator=(const CSmartPlaylistCache&) = delete;
+  ~CSmartPlaylistCache() override = default;
+
+  typedef std::vector<std::pair<std::string, int64_t>> Sources;
+
+  struct SWhereClause
+  {
+    std::string where;
+    std::set<std::string> playlists;
+    Sources sources; //!< modification times of the playlists and the folders they're looked up in
+  };
+
+  struct SItems
+  {
+    unsigned int changes;
+    bool result;
+    std::shared_ptr<const CFileItemList> items;
+  };
+
+  static Sources GetSources(const std::set<std::string> &playlists);
+
+  mutable CCriticalSection m_section;
+  mutable std::map<std::string, SWhereClause> m_whereClauses;
+  mutable std::list<std::pair<std::string, SItems>> m_items; //!< most recently used first
+};
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "playlists/SmartPlaylistCache.h"
+
+#include "FileItem.h"
+
+#include "gtest/gtest.h"
+
+class TestSmartPlaylistCache : public ::testing::Test
+{
+protected:
+  TestSmartPlaylistCache() { CSmartPlaylistCache::GetInstance().Clear(); }
+  ~TestSmartPlaylistCache() override { CSmartPlaylistCache::GetInstance().Clear(); }
+};
+
+TEST_F(TestSmartPlaylistCache, WhereClause)
+{
+  CSmartPlaylistCache& cache = CSmartPlaylistCache::GetInstance();
+  std::string where;
+  std::set<std::string> playlists;
+  EXPECT_FALSE(cache.GetWhereClause("movies|rules", where, playlists));
+
+  cache.SetWhereClause("movies|rules", "(movie_view.c00 LIKE '%foo%')", { "special://temp/missing.xsp" });
+  ASSERT_TRUE(cache.GetWhereClause("movies|rules", where, playlists));
+  EXPECT_EQ("(movie_view.c00 LIKE '%foo%')", where);
+  EXPECT_EQ(1U, playlists.count("special://temp/missing.xsp"));
+
+  cache.OnSettingsSaved();
+  EXPECT_FALSE(cache.GetWhereClause("movies|rules", where, playlists));
+}
+
+TEST_F(TestSmartPlaylistCache, Items)
+{
+  CSmartPlaylistCache& cache = CSmartPlaylistCache::GetInstance();
+
+  CFileItemList items;
+  items.Add(std::make_shared<CFileItem>("Movie"));
+  items.SetContent("movies");
+  cache.SetItems("recent", 1, items, true);
+
+  CFileItemList cachedItems;
+  bool result = false;
+  ASSERT_TRUE(cache.GetItems("recent", 1, cachedItems, result));
+  EXPECT_TRUE(result);
+  ASSERT_EQ(1, cachedItems.Size());
+  EXPECT_EQ("Movie", cachedItems[0]->GetLabel());
+  EXPECT_EQ("movies", cachedItems.GetContent());
+
+  // the items are copies
+  cachedItems[0]->SetLabel("Changed");
+  CFileItemList cachedItems2;
+  ASSERT_TRUE(cache.GetItems("recent", 1, cachedItems2, result));
+  EXPECT_EQ("Movie", cachedItems2[0]->GetLabel());
+
+  // the database changed
+  CFileItemList cachedItems3;
+  EXPECT_FALSE(cache.GetItems("recent", 2, cachedItems3, result));
+  EXPECT_FALSE(cache.GetItems("recent", 1, cachedItems3, result));
+  EXPECT_TRUE(cachedItems3.IsEmpty());
+}
@@ -65,6 +65,22 @@ public:
 
   virtual std::string GetShaderPath(const std::string &filename) { return ""; }
 
+  /*!
+   \brief Measure the time the GPU takes for the commands issued until EndTimeQuery().
+   The results come in a few frames later, in the order the queries were begun.
+   \return true if the query was begun, false if not supported or too many are pending.
+   \sa GetTimeQueryResult
+   */
+  virtual bool BeginTimeQuery() { return false; }
+  virtual void EndTimeQuery() {}
+
+  /*!
+   \brief Get the result of the oldest pending time query, once the GPU is done with it.
+   \param time [out] the time in ms.
+   \return true if a result was available, false otherwise.
+   */
+  virtual bool GetTimeQueryResult(float &time) { return false; }
+
   void GetRenderVersion(unsigned int& major, unsigned int& minor) const;
   const std::string& GetRenderVendor() const { return m_RenderVendor; }
   const std::string& GetRenderRenderer() const { return m_RenderRenderer; }
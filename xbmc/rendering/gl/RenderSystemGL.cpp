@@ -105,6 +105,14 @@ bool CRenderSystemGL::InitRenderSystem()
 
   InitialiseShaders();
 
+  m_supportsTimeQueries = m_RenderVersionMajor > 3 ||
+                          (m_RenderVersionMajor == 3 && m_RenderVersionMinor >= 3) ||
+                          IsExtSupported("GL_ARB_timer_query");
+  if (m_supportsTimeQueries)
+    glGenQueries(m_timeQueries.size(), m_timeQueries.data());
+  m_firstTimeQuery = 0;
+  m_pendingTimeQueries = 0;
+
   if (IsExtSupported("GL_ARB_texture_non_power_of_two"))
     m_supportsNPOT = true;
   else
@@ -199,12 +207,52 @@ bool CRenderSystemGL::DestroyRenderSystem()
     glDeleteVertexArrays(1, &m_vertexArray);
   }
 
+  if (m_supportsTimeQueries)
+  {
+    glDeleteQueries(m_timeQueries.size(), m_timeQueries.data());
+    m_supportsTimeQueries = false;
+  }
+
   ReleaseShaders();
   m_bRenderCreated = false;
 
   return true;
 }
 
+bool CRenderSystemGL::BeginTimeQuery()
+{
+  if (!m_supportsTimeQueries || m_pendingTimeQueries == m_timeQueries.size())
+    return false;
+
+  glBeginQuery(GL_TIME_ELAPSED, m_timeQueries[(m_firstTimeQuery + m_pendingTimeQueries) % m_timeQueries.size()]);
+  return true;
+}
+
+void CRenderSystemGL::EndTimeQuery()
+{
+  glEndQuery(GL_TIME_ELAPSED);
+  m_pendingTimeQueries++;
+}
+
+bool CRenderSystemGL::GetTimeQueryResult(float &time)
+{
+  if (m_pendingTimeQueries == 0)
+    return false;
+
+  GLuint query = m_timeQueries[m_firstTimeQuery];
+  GLint available = 0;
+  glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return false;
+
+  GLuint64 elapsed = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+  m_firstTimeQuery = (m_firstTimeQuery + 1) % m_timeQueries.size();
+  m_pendingTimeQueries--;
+  time = elapsed / 1000000.0f;
+  return true;
+}
+
 bool CRenderSystemGL::BeginRender()
 {
   if (!m_bRenderCreated)
@@ -67,6 +67,10 @@ public:
 
   std::string GetShaderPath(const std::string &filename) override;
 
+  bool BeginTimeQuery() override;
+  void EndTimeQuery() override;
+  bool GetTimeQueryResult(float &time) override;
+
   void GetGLVersion(int& major, int& minor);
   void GetGLSLVersion(int& major, int& minor);
 
@@ -104,4 +108,10 @@ protected:
   std::array<std::unique_ptr<CGLShader>, SM_MAX> m_pShader;
   ESHADERMETHOD m_method = SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  // time queries in flight, oldest first from m_firstTimeQuery
+  bool m_supportsTimeQueries = false;
+  std::array<GLuint, 4> m_timeQueries;
+  unsigned int m_firstTimeQuery = 0;
+  unsigned int m_pendingTimeQueries = 0;
 };
@@ -176,6 +176,10 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoDecoderMaxThreads = 16;
+  m_videoDecoderThreadingRules.clear();
+  m_videoSeekIndexCache = true;
+  m_videoFastStart = false;
 
   m_mediacodecForceSoftwareRendering = false;
 
@@ -305,15 +309,22 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReaderThreads = 4; // per source, local disks use at most 2
+  m_bMusicLibraryIncrementalScan = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
+  m_bVideoLibraryIncrementalScan = false;
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
+  m_iVideoLibraryPlaceholderItems = 1000;
   m_bVideoScannerIgnoreErrors = false;
+  m_iVideoScannerLocalThreads = 2;
+  m_iVideoScannerScraperThreads = 4;
+  m_iVideoScannerQueueSize = 32;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
   m_videoEpisodeExtraArt = {};
@@ -421,6 +432,12 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiParallelSkinLoad = true;
+  m_guiShowFrameStats = false;
+  m_guiRecordDirtyRegions = false;
+  m_guiOcclusionCulling = true;
+  m_guiTextureUploadBudget = 4096;
+  m_guiTextureMemoryBudget = 0;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -740,6 +757,39 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    XMLUtils::GetBoolean(pElement, "seekindexcache", m_videoSeekIndexCache);
+    XMLUtils::GetBoolean(pElement, "faststart", m_videoFastStart);
+
+    TiXmlElement* pDecoderThreading = pElement->FirstChildElement("decoderthreading");
+    if (pDecoderThreading)
+    {
+      XMLUtils::GetInt(pDecoderThreading, "maxthreads", m_videoDecoderMaxThreads, 0, 256);
+
+      m_videoDecoderThreadingRules.clear();
+      TiXmlElement* pRule = pDecoderThreading->FirstChildElement("rule");
+      while (pRule)
+      {
+        VideoDecoderThreadingRule rule;
+        std::string source;
+
+        XMLUtils::GetString(pRule, "codec", rule.codec);
+        XMLUtils::GetInt(pRule, "minheight", rule.minHeight, 0, 16384);
+        XMLUtils::GetInt(pRule, "maxheight", rule.maxHeight, 0, 16384);
+        if (XMLUtils::GetString(pRule, "source", source))
+        {
+          if (StringUtils::EqualsNoCase(source, "live"))
+            rule.source = VideoDecoderThreadingRule::SOURCE_LIVE;
+          else if (StringUtils::EqualsNoCase(source, "file"))
+            rule.source = VideoDecoderThreadingRule::SOURCE_FILE;
+        }
+        XMLUtils::GetString(pRule, "type", rule.type);
+        XMLUtils::GetInt(pRule, "threads", rule.threads, 0, 256);
+        XMLUtils::GetInt(pRule, "maxthreads", rule.maxThreads, 0, 256);
+
+        m_videoDecoderThreadingRules.push_back(rule);
+        pRule = pRule->NextSiblingElement("rule");
+      }
+    }
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -790,6 +840,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "tagreaderthreads", m_iMusicLibraryTagReaderThreads, 1, 16);
+    XMLUtils::GetBoolean(pElement, "incrementalscan", m_bMusicLibraryIncrementalScan);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -815,10 +867,12 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "recentlyaddeditems", m_iVideoLibraryRecentlyAddedItems, 1, INT_MAX);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bVideoLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "usefasthash", m_bVideoLibraryUseFastHash);
+    XMLUtils::GetBoolean(pElement, "incrementalscan", m_bVideoLibraryIncrementalScan);
     XMLUtils::GetString(pElement, "itemseparator", m_videoItemSeparator);
     XMLUtils::GetBoolean(pElement, "exportautothumbs", m_bVideoLibraryExportAutoThumbs);
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
     XMLUtils::GetBoolean(pElement, "importresumepoint", m_bVideoLibraryImportResumePoint);
+    XMLUtils::GetInt(pElement, "placeholderitems", m_iVideoLibraryPlaceholderItems, 0, INT_MAX);
     XMLUtils::GetInt(pElement, "dateadded", m_iVideoLibraryDateAdded);
 
     SetExtraArtwork(pElement->FirstChildElement("episodeextraart"), m_videoEpisodeExtraArt);
@@ -833,6 +887,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetInt(pElement, "localthreads", m_iVideoScannerLocalThreads, 1, 16);
+    XMLUtils::GetInt(pElement, "scraperthreads", m_iVideoScannerScraperThreads, 1, 16);
+    XMLUtils::GetInt(pElement, "queuesize", m_iVideoScannerQueueSize, 1, 1000);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -1242,6 +1299,12 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "parallelskinload", m_guiParallelSkinLoad);
+    XMLUtils::GetBoolean(pElement, "showframestats", m_guiShowFrameStats);
+    XMLUtils::GetBoolean(pElement, "recorddirtyregions", m_guiRecordDirtyRegions);
+    XMLUtils::GetBoolean(pElement, "occlusionculling", m_guiOcclusionCulling);
+    XMLUtils::GetUInt(pElement, "textureuploadbudget", m_guiTextureUploadBudget);
+    XMLUtils::GetUInt(pElement, "texturememorybudget", m_guiTextureMemoryBudget);
   }
 
   std::string seekSteps;
@@ -100,6 +100,24 @@ struct RefreshVideoLatency
   float delay;
 };
 
+struct VideoDecoderThreadingRule
+{
+  enum Source
+  {
+    SOURCE_ANY = 0,
+    SOURCE_FILE,
+    SOURCE_LIVE
+  };
+
+  std::string codec;     ///< ffmpeg decoder name, empty matches any decoder
+  int minHeight = 0;     ///< minimum coded height, 0 for no lower bound
+  int maxHeight = 0;     ///< maximum coded height, 0 for no upper bound
+  Source source = SOURCE_ANY;
+  std::string type;      ///< auto, frame, slice or none
+  int threads = 0;       ///< thread count, 0 for the cpu count based default
+  int maxThreads = 0;    ///< cap applied to the thread count, 0 for no cap
+};
+
 typedef std::vector<TVShowRegexp> SETTINGS_TVSHOWLIST;
 
 class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
@@ -183,6 +201,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_mediacodecForceSoftwareRendering;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    int m_videoDecoderMaxThreads;
+    std::vector<VideoDecoderThreadingRule> m_videoDecoderThreadingRules;
+    bool m_videoSeekIndexCache;
+    bool m_videoFastStart;
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -249,6 +271,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReaderThreads;
+    bool m_bMusicLibraryIncrementalScan;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
@@ -263,9 +287,11 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iVideoLibraryRecentlyAddedItems;
     bool m_bVideoLibraryCleanOnUpdate;
     bool m_bVideoLibraryUseFastHash;
+    bool m_bVideoLibraryIncrementalScan;
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
     bool m_bVideoLibraryImportResumePoint;
+    int m_iVideoLibraryPlaceholderItems;
     std::vector<std::string> m_videoEpisodeExtraArt;
     std::vector<std::string> m_videoTvShowExtraArt;
     std::vector<std::string> m_videoTvSeasonExtraArt;
@@ -274,6 +300,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::vector<std::string> m_videoMusicVideoExtraArt;
 
     bool m_bVideoScannerIgnoreErrors;
+    int m_iVideoScannerLocalThreads;
+    int m_iVideoScannerScraperThreads;
+    int m_iVideoScannerQueueSize;
     int m_iVideoLibraryDateAdded;
 
     std::set<std::string> m_vecTokens;
@@ -343,6 +372,12 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiParallelSkinLoad;
+    bool m_guiShowFrameStats;
+    bool m_guiRecordDirtyRegions;
+    bool m_guiOcclusionCulling;
+    unsigned int m_guiTextureUploadBudget; //!< KB of background loaded textures uploaded per frame, 0 for no limit
+    unsigned int m_guiTextureMemoryBudget; //!< MB of GUI textures kept, 0 to size it by the physical memory
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
@@ -364,6 +399,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     //! \brief Toggles dirty-region visualization
     void ToggleDirtyRegionVisualization() { m_guiVisualizeDirtyRegions = !m_guiVisualizeDirtyRegions; };
 
+    //! \brief Toggles the frame time overlay
+    void ToggleFrameStats() { m_guiShowFrameStats = !m_guiShowFrameStats; };
+
     // runtime settings which cannot be set from advancedsettings.xml
     std::string m_videoExtensions;
     std::string m_discStubExtensions;
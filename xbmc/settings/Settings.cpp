@@ -39,6 +39,7 @@
 #if defined(HAS_LIBAMCODEC)
 #include "utils/AMLUtils.h"
 #endif // defined(HAS_LIBAMCODEC)
+#include "playlists/SmartPlaylistCache.h"
 #include "powermanagement/PowerTypes.h"
 #include "profiles/ProfileManager.h"
 #include "ServiceBroker.h"
@@ -780,11 +781,13 @@ void CSettings::InitializeISettingsHandlers()
   GetSettingsManager()->RegisterSettingsHandler(&g_timezone);
 #endif
   GetSettingsManager()->RegisterSettingsHandler(&CMediaSettings::GetInstance());
+  GetSettingsManager()->RegisterSettingsHandler(&CSmartPlaylistCache::GetInstance());
 }
 
 void CSettings::UninitializeISettingsHandlers()
 {
   // unregister ISettingsHandler implementations
+  GetSettingsManager()->UnregisterSettingsHandler(&CSmartPlaylistCache::GetInstance());
   GetSettingsManager()->UnregisterSettingsHandler(&CMediaSettings::GetInstance());
 #if defined(TARGET_LINUX)
   GetSettingsManager()->UnregisterSettingsHandler(&g_timezone);
@@ -25,6 +25,7 @@
 #include "profiles/ProfileManager.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #ifdef TARGET_WINDOWS
 #include "win32util.h"
@@ -44,6 +45,8 @@ CSettingsComponent::~CSettingsComponent()
 
 void CSettingsComponent::Init(const CAppParamParser &params)
 {
+  KODI_TRACE_SCOPE("CSettingsComponent::Init");
+
   if (m_state == State::DEINITED)
   {
     // only the InitDirectories* for the current platform should return true
@@ -68,6 +71,8 @@ void CSettingsComponent::Init(const CAppParamParser &params)
 
 bool CSettingsComponent::Load()
 {
+  KODI_TRACE_SCOPE("CSettingsComponent::Load");
+
   if (m_state == State::INITED)
   {
     if (!m_profileManager->Load())
@@ -49,6 +49,7 @@ const std::string& CSkinSettings::GetString(int setting) const
 void CSkinSettings::SetString(int setting, const std::string &label)
 {
   g_SkinInfo->SetString(setting, label);
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_SKIN);
 }
 
 int CSkinSettings::TranslateBool(const std::string &setting)
@@ -64,11 +65,13 @@ bool CSkinSettings::GetBool(int setting) const
 void CSkinSettings::SetBool(int setting, bool set)
 {
   g_SkinInfo->SetBool(setting, set);
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_SKIN);
 }
 
 void CSkinSettings::Reset(const std::string &setting)
 {
   g_SkinInfo->Reset(setting);
+  CServiceBroker::GetGUI()->GetInfoManager().PublishChange(INFO::INFO_SOURCE_SKIN);
 }
 
 void CSkinSettings::Reset()
@@ -14,9 +14,17 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
 
 #include "gtest/gtest.h"
 
+#include <iostream>
+
+#if defined(TARGET_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 using ::testing::Test;
 using ::testing::WithParamInterface;
 using ::testing::ValuesIn;
@@ -131,3 +139,93 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_CASE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+TEST(TestFileItem, Properties)
+{
+  CFileItem item;
+  item.SetProperty("b", 2);
+  item.SetProperty("a", "one");
+  item.SetProperty("C", 3.0);
+  EXPECT_TRUE(item.HasProperties());
+
+  // keys are case insensitive
+  EXPECT_TRUE(item.HasProperty("c"));
+  EXPECT_EQ("one", item.GetProperty("A").asString());
+  item.SetProperty("B", 4);
+  EXPECT_EQ(4, item.GetProperty("b").asInteger());
+
+  item.IncrementProperty("d", 1);
+  EXPECT_EQ(1, item.GetProperty("d").asInteger());
+  EXPECT_TRUE(item.GetProperty("e").isNull());
+
+  CFileItem copy(item);
+  item.ClearProperty("a");
+  EXPECT_FALSE(item.HasProperty("a"));
+  EXPECT_TRUE(copy.HasProperty("a"));
+
+  CVariant value;
+  static_cast<CGUIListItem&>(copy).Serialize(value);
+  EXPECT_EQ(4u, value["properties"].size());
+  EXPECT_EQ(3.0, value["properties"]["C"].asDouble());
+
+  item.ClearProperties();
+  EXPECT_FALSE(item.HasProperties());
+}
+
+TEST(TestFileItem, ArtFallback)
+{
+  CFileItem item;
+  item.SetArt("thumb", "thumb.jpg");
+  EXPECT_EQ("", item.GetArt("icon"));
+
+  item.SetArtFallback("icon", "thumb");
+  EXPECT_EQ("thumb.jpg", item.GetArt("icon"));
+
+  CFileItem copy(item);
+  item.ClearArt();
+  EXPECT_EQ("", item.GetArt("icon"));
+  EXPECT_EQ("thumb.jpg", copy.GetArt("icon"));
+  EXPECT_FALSE(copy.HasPVRRecordingInfoTag());
+  EXPECT_FALSE(copy.HasAddonInfo());
+}
+
+TEST(TestFileItem, DISABLED_Benchmark_VideoItemMemory)
+{
+  const int count = 50000;
+  const char* genres[] = { "Action", "Comedy", "Drama", "Science Fiction", "Thriller" };
+  const char* studios[] = { "Universal Pictures", "Warner Bros. Pictures", "Paramount Pictures" };
+
+#if defined(TARGET_LINUX) && defined(__GLIBC__)
+  size_t before = mallinfo().uordblks;
+#endif
+
+  CFileItemList items;
+  for (int i = 0; i < count; i++)
+  {
+    CVideoInfoTag tag;
+    tag.m_iDbId = i;
+    tag.m_type = MediaTypeMovie;
+    tag.SetTitle("Movie " + std::to_string(i));
+    tag.SetPlot("A long enough plot to not fit into the small string buffer of movie " + std::to_string(i));
+    tag.SetGenre({ genres[i % 5], genres[(i + 1) % 5] });
+    tag.SetStudio({ studios[i % 3] });
+    tag.SetCountry({ "United States of America" });
+    tag.SetDirector({ "Director " + std::to_string(i % 1000) });
+    tag.m_strFileNameAndPath = "/movies/Movie " + std::to_string(i) + "/movie.mkv";
+
+    CFileItemPtr item = std::make_shared<CFileItem>(tag);
+    item->SetProperty("original_listitem_url", tag.m_strFileNameAndPath);
+    item->SetProperty("dbid", i);
+    item->SetArt("poster", "/movies/Movie " + std::to_string(i) + "/poster.jpg");
+    items.Add(item);
+  }
+
+  std::cout << "sizeof(CFileItem) " << sizeof(CFileItem)
+            << ", sizeof(CVideoInfoTag) " << sizeof(CVideoInfoTag) << std::endl;
+#if defined(TARGET_LINUX) && defined(__GLIBC__)
+  size_t after = mallinfo().uordblks;
+  std::cout << count << " video items use " << (after - before) / 1024 << " kB, "
+            << (after - before) / count << " bytes per item" << std::endl;
+#endif
+  EXPECT_EQ(count, items.Size());
+}
@@ -0,0 +1,238 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BackgroundInfoLoader.h"
+#include "FileItem.h"
+#include "PlaceholderLoader.h"
+#include "threads/SystemClock.h"
+#include "video/VideoInfoTag.h"
+#include "video/VideoPlaceholderLoader.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XTimeUtils.h"
+#endif
+
+namespace
+{
+class CTestPlaceholderLoader : public CPlaceholderLoader
+{
+protected:
+  bool LoadItems(const std::vector<CFileItemPtr>& placeholders, std::vector<CFileItemPtr>& loaded) override
+  {
+    for (const auto& item : placeholders)
+      loaded.push_back(std::make_shared<CFileItem>(item->GetPath() + " loaded"));
+    return true;
+  }
+
+  void FillItem(CFileItem& item, const CFileItem& loaded) override
+  {
+    item.SetLabel(loaded.GetLabel());
+  }
+
+  void UnloadItem(CFileItem& item) override
+  {
+    item.SetLabel(item.GetPath());
+  }
+};
+
+class CTestVideoPlaceholderLoader : public CVideoPlaceholderLoader
+{
+protected:
+  bool LoadItems(const std::vector<CFileItemPtr>& placeholders, std::vector<CFileItemPtr>& loaded) override
+  {
+    for (const auto& item : placeholders)
+    {
+      CFileItemPtr movie = std::make_shared<CFileItem>(*item->GetVideoInfoTag());
+      CVideoInfoTag* tag = movie->GetVideoInfoTag();
+      tag->m_genre = { "Drama", "Comedy" };
+      tag->m_strPlot = "The plot of " + item->GetPath();
+      loaded.push_back(movie);
+    }
+    return true;
+  }
+};
+
+// reads the details of the items like CVideoThumbLoader
+class CTestInfoLoader : public CBackgroundInfoLoader
+{
+public:
+  bool LoadItemCached(CFileItem* item) override
+  {
+    const CVideoInfoTag* tag = item->GetVideoInfoTag();
+    for (int i = 0; i < 100; i++)
+    {
+      const std::string plot = tag->m_strPlot;
+      if (!tag->m_genre.empty() && (tag->m_genre.size() != 2 || tag->m_genre[0] != "Drama"))
+        m_invalid++;
+      if (!plot.empty() && plot != "The plot of " + item->GetPath())
+        m_invalid++;
+    }
+    return false;
+  }
+
+  std::atomic<int> m_invalid{0};
+};
+
+std::vector<CGUIListItemPtr> GetPlaceholders(int count)
+{
+  std::vector<CGUIListItemPtr> items;
+  for (int i = 0; i < count; i++)
+  {
+    CFileItemPtr item = std::make_shared<CFileItem>(std::to_string(i));
+    item->SetPath(std::to_string(i));
+    item->SetPlaceholder(true);
+    items.push_back(item);
+  }
+  return items;
+}
+
+void Load(CPlaceholderLoader& loader, const std::vector<CGUIListItemPtr>& items, int first, int last)
+{
+  // the first call starts loading, later ones fill in the loaded items
+  XbmcThreads::EndTime timeout(5000);
+  loader.Load(items, first, last);
+  while (static_cast<const CFileItem&>(*items[first]).IsPlaceholder() && !timeout.IsTimePast())
+  {
+    Sleep(10);
+    loader.Load(items, first, last);
+  }
+}
+
+bool IsFilled(const CGUIListItemPtr& item)
+{
+  const CFileItem& fileItem = static_cast<const CFileItem&>(*item);
+  return !fileItem.IsPlaceholder() && fileItem.GetLabel() == fileItem.GetPath() + " loaded";
+}
+}
+
+TEST(TestPlaceholderLoader, Range)
+{
+  std::shared_ptr<CPlaceholderLoader> loader = std::make_shared<CTestPlaceholderLoader>();
+  std::vector<CGUIListItemPtr> items = GetPlaceholders(10);
+
+  Load(*loader, items, 2, 4);
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(i >= 2 && i <= 4, IsFilled(items[i])) << "item " << i;
+}
+
+TEST(TestPlaceholderLoader, WrappingRange)
+{
+  std::shared_ptr<CPlaceholderLoader> loader = std::make_shared<CTestPlaceholderLoader>();
+  std::vector<CGUIListItemPtr> items = GetPlaceholders(10);
+
+  Load(*loader, items, 8, 1);
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(i >= 8 || i <= 1, IsFilled(items[i])) << "item " << i;
+}
+
+TEST(TestPlaceholderLoader, Unload)
+{
+  std::shared_ptr<CPlaceholderLoader> loader = std::make_shared<CTestPlaceholderLoader>();
+  std::vector<CGUIListItemPtr> items = GetPlaceholders(2000);
+
+  // only the most recently filled in items keep their details
+  for (int first = 0; first < 2000; first += 100)
+    Load(*loader, items, first, first + 99);
+
+  int filled = 0;
+  for (const auto& item : items)
+  {
+    if (IsFilled(item))
+      filled++;
+  }
+  EXPECT_LT(filled, 2000);
+  EXPECT_TRUE(IsFilled(items[1999]));
+  EXPECT_TRUE(static_cast<const CFileItem&>(*items[0]).IsPlaceholder());
+  EXPECT_EQ("0", items[0]->GetLabel());
+}
+
+TEST(TestPlaceholderLoader, LockedItem)
+{
+  std::shared_ptr<CPlaceholderLoader> loader = std::make_shared<CTestPlaceholderLoader>();
+  std::vector<CGUIListItemPtr> items = GetPlaceholders(10);
+  const CFileItem* locked = static_cast<const CFileItem*>(items[1].get());
+
+  // filled in once no other thread reads it
+  {
+    CPlaceholderLoader::CItemLock lock(loader, locked);
+    Load(*loader, items, 0, 2);
+    EXPECT_TRUE(IsFilled(items[0]));
+    EXPECT_TRUE(locked->IsPlaceholder());
+  }
+  Load(*loader, items, 1, 2);
+  EXPECT_TRUE(IsFilled(items[1]));
+}
+
+TEST(TestPlaceholderLoader, BackgroundInfoLoader)
+{
+  CFileItemList list;
+  list.SetPlaceholderLoader(std::make_shared<CTestVideoPlaceholderLoader>());
+  std::vector<CGUIListItemPtr> items;
+  for (int i = 0; i < 2000; i++)
+  {
+    CFileItemPtr item = std::make_shared<CFileItem>(std::to_string(i));
+    item->SetPath(std::to_string(i));
+    item->GetVideoInfoTag()->m_iDbId = i + 1;
+    item->GetVideoInfoTag()->m_type = MediaTypeMovie;
+    item->SetPlaceholder(true);
+    list.Add(item);
+    items.push_back(item);
+  }
+
+  // scroll through the list while the items are read, filling in and dropping details
+  CTestInfoLoader infoLoader;
+  for (int pass = 0; pass < 3; pass++)
+  {
+    for (int first = 0; first < 2000; first += 100)
+    {
+      if (!infoLoader.IsLoading())
+        infoLoader.Load(list);
+      Load(*list.GetPlaceholderLoader(), items, first, first + 99);
+    }
+  }
+  infoLoader.StopThread();
+  // items that were read when they finished loading are filled in now
+  Load(*list.GetPlaceholderLoader(), items, 1999, 1999);
+
+  EXPECT_EQ(0, infoLoader.m_invalid);
+  EXPECT_FALSE(static_cast<const CFileItem&>(*items[1999]).IsPlaceholder());
+  EXPECT_EQ(2u, static_cast<const CFileItem&>(*items[1999]).GetVideoInfoTag()->m_genre.size());
+  EXPECT_TRUE(static_cast<const CFileItem&>(*items[0]).GetVideoInfoTag()->m_genre.empty());
+}
+
+TEST(TestPlaceholderLoader, FileItemList)
+{
+  CFileItemList items;
+  items.SetAllowPlaceholders(true);
+  items.SetPlaceholderLoader(std::make_shared<CTestPlaceholderLoader>());
+
+  CFileItemPtr item = std::make_shared<CFileItem>("movie");
+  item->SetPlaceholder(true);
+  items.Add(item);
+
+  CFileItemList copy;
+  copy.Copy(items);
+  EXPECT_TRUE(copy.AllowPlaceholders());
+  EXPECT_EQ(items.GetPlaceholderLoader(), copy.GetPlaceholderLoader());
+  EXPECT_TRUE(copy[0]->IsPlaceholder());
+
+  CFileItemList assigned;
+  assigned.Assign(items);
+  EXPECT_EQ(items.GetPlaceholderLoader(), assigned.GetPlaceholderLoader());
+
+  // the items can't be filled in once they're saved
+  EXPECT_FALSE(items.Save());
+
+  items.Clear();
+  EXPECT_FALSE(items.AllowPlaceholders());
+  EXPECT_FALSE(items.GetPlaceholderLoader());
+}
@@ -396,13 +396,14 @@ void CArchive::FlushBuffer()
 {
   if (m_iMode == store && m_BufferPos != m_pBuffer.get())
   {
-    if (m_pFile->Write(m_pBuffer.get(), m_BufferPos - m_pBuffer.get()) != m_BufferPos - m_pBuffer.get())
-      CLog::Log(LOGERROR, "%s: Error flushing buffer", __FUNCTION__);
-    else
+    if (!m_writeError && m_pFile->Write(m_pBuffer.get(), m_BufferPos - m_pBuffer.get()) != m_BufferPos - m_pBuffer.get())
     {
-      m_BufferPos = m_pBuffer.get();
-      m_BufferRemain = CARCHIVE_BUFFER_MAX;
+      CLog::Log(LOGERROR, "%s: Error flushing buffer", __FUNCTION__);
+      m_writeError = true;
     }
+    // the buffer is reused either way, a full one would never take more data
+    m_BufferPos = m_pBuffer.get();
+    m_BufferRemain = CARCHIVE_BUFFER_MAX;
   }
 }
 
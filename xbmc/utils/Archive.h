@@ -131,6 +131,10 @@ public:
   bool IsLoading() const;
   bool IsStoring() const;
 
+  /*! \brief Whether writing to the file failed. Data stored after a failed write is dropped.
+   */
+  bool HasWriteError() const { return m_writeError; }
+
   void Close();
 
   enum Mode {load = 0, store};
@@ -172,6 +176,7 @@ protected:
   std::unique_ptr<uint8_t[]> m_pBuffer;
   uint8_t *m_BufferPos;
   size_t m_BufferRemain;
+  bool m_writeError = false;
 
 private:
   void FlushBuffer();
@@ -314,7 +314,8 @@ bool CEGLContextUtils::ChooseConfig(EGLint renderableType, EGLint visualId)
   // for the non-trivial dirty region modes, we need the EGL buffer to be preserved across updates
   int guiAlgorithmDirtyRegions = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions;
   if (guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_COST_REDUCTION ||
-      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION)
+      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION ||
+      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_CLUSTER)
     surfaceType |= EGL_SWAP_BEHAVIOR_PRESERVED_BIT;
 
   CEGLAttributes<10> attribs;
@@ -464,7 +465,8 @@ void CEGLContextUtils::SurfaceAttrib()
   // for the non-trivial dirty region modes, we need the EGL buffer to be preserved across updates
   int guiAlgorithmDirtyRegions = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions;
   if (guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_COST_REDUCTION ||
-      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION)
+      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION ||
+      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_CLUSTER)
   {
     if (eglSurfaceAttrib(m_eglDisplay, m_eglSurface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_PRESERVED) != EGL_TRUE)
     {
@@ -242,20 +242,26 @@ public:
 
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
+   \return the id of the job, 0 if the job manager no longer runs jobs and f was dropped
    */
   template<typename F>
-  void Submit(F&& f, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  unsigned int Submit(F&& f, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
   {
-    AddJob(new CLambdaJob<F>(std::forward<F>(f)), nullptr, priority);
+    return Submit(std::forward<F>(f), nullptr, priority);
   }
 
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
+   \return the id of the job, 0 if the job manager no longer runs jobs and f was dropped
    */
   template<typename F>
-  void Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  unsigned int Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
   {
-    AddJob(new CLambdaJob<F>(std::forward<F>(f)), callback, priority);
+    CJob *job = new CLambdaJob<F>(std::forward<F>(f));
+    unsigned int id = AddJob(job, callback, priority);
+    if (!id)
+      delete job;
+    return id;
   }
 
   /*!
@@ -289,9 +289,23 @@ bool CScraperUrl::Get(const SUrlEntry& scrURL, std::string& strHTML, XFILE::CCur
   {
     std::string strCachePath = URIUtils::AddFileToFolder(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cachePath,
                               "scrapers", cacheContext, scrURL.m_cache);
+    // lookups may run concurrently, so the cache file is replaced at once rather than rewritten
+    std::string strTempPath = strCachePath + "." + StringUtils::CreateUUID();
     XFILE::CFile file;
-    if (!file.OpenForWrite(strCachePath, true) || file.Write(strHTML.data(), strHTML.size()) != static_cast<ssize_t>(strHTML.size()))
+    if (!file.OpenForWrite(strTempPath, true) || file.Write(strHTML.data(), strHTML.size()) != static_cast<ssize_t>(strHTML.size()))
+    {
+      file.Close();
+      XFILE::CFile::Delete(strTempPath);
       return false;
+    }
+    file.Close();
+    if (!XFILE::CFile::Rename(strTempPath, strCachePath))
+    {
+      XFILE::CFile::Delete(strTempPath);
+      // fine if another lookup cached it first
+      if (!XFILE::CFile::Exists(strCachePath))
+        return false;
+    }
   }
   return true;
 }
@@ -422,130 +422,39 @@ std::string ByLastUsed(SortAttribute attributes, const SortItem &values)
   return values.at(FieldLastUsed).asString();
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
+int64_t NumericBySize(SortAttribute attributes, const SortItem &values)
 {
-  // make sure both items have the necessary data to do the sorting
-  SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
-  {
-    result = false;
-    return true;
-  }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
-  {
-    result = true;
-    return true;
-  }
-
-  // look at special sorting behaviour
-  SortItem::const_iterator itLeft, itRight;
-  SortSpecial leftSortSpecial = SortSpecialNone;
-  SortSpecial rightSortSpecial = SortSpecialNone;
-  if ((itLeft = left.find(FieldSortSpecial)) != left.end() && itLeft->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    leftSortSpecial = (SortSpecial)itLeft->second.asInteger();
-  if ((itRight = right.find(FieldSortSpecial)) != right.end() && itRight->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    rightSortSpecial = (SortSpecial)itRight->second.asInteger();
-
-  // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
-  {
-    // left should be sorted on top
-    // or right should be sorted on bottom
-    // => left is sorted above right
-    if (leftSortSpecial == SortSpecialOnTop ||
-        rightSortSpecial == SortSpecialOnBottom)
-    {
-      result = true;
-      return true;
-    }
-
-    // otherwise right is sorted above left
-    result = false;
-    return true;
-  }
-  // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecialNone && leftSortSpecial == rightSortSpecial)
-  {
-    result = false;
-    return true;
-  }
-
-  if (handleFolder)
-  {
-    itLeft = left.find(FieldFolder);
-    itRight = right.find(FieldFolder);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
-    {
-      result = itLeft->second.asBoolean();
-      return true;
-    }
-  }
-
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
-
-  return false;
+  return values.at(FieldSize).asInteger();
 }
 
-bool SorterAscending(const SortItem &left, const SortItem &right)
+int64_t NumericByTrackNumber(SortAttribute attributes, const SortItem &values)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return (int)values.at(FieldTrackNumber).asInteger();
 }
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
+int64_t NumericByProgramCount(SortAttribute attributes, const SortItem &values)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  return (int)values.at(FieldProgramCount).asInteger();
 }
 
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
+int64_t NumericByBitrate(SortAttribute attributes, const SortItem &values)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return values.at(FieldBitrate).asInteger();
 }
 
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
+int64_t NumericByListeners(SortAttribute attributes, const SortItem &values)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
-
-bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterAscending(*left, *right);
+  return values.at(FieldListeners).asInteger();
 }
 
-bool SorterIndirectDescending(const SortItemPtr &left, const SortItemPtr &right)
+int64_t NumericByRandom(SortAttribute attributes, const SortItem &values)
 {
-  return SorterDescending(*left, *right);
+  return CUtil::GetRandomNumber();
 }
 
-bool SorterIndirectIgnoreFoldersAscending(const SortItemPtr &left, const SortItemPtr &right)
+int64_t NumericByRelevance(SortAttribute attributes, const SortItem &values)
 {
-  return SorterIgnoreFoldersAscending(*left, *right);
-}
-
-bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterIgnoreFoldersDescending(*left, *right);
+  return (int)values.at(FieldRelevance).asInteger();
 }
 
 std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
@@ -609,6 +518,23 @@ std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
   return preparators;
 }
 
+std::map<SortBy, SortUtils::NumericPreparator> fillNumericPreparators()
+{
+  std::map<SortBy, SortUtils::NumericPreparator> preparators;
+
+  // sort methods whose label is a single number are compared natively
+  preparators[SortBySize]                     = NumericBySize;
+  preparators[SortByTrackNumber]              = NumericByTrackNumber;
+  preparators[SortByProgramCount]             = NumericByProgramCount;
+  preparators[SortByPlaylistOrder]            = NumericByProgramCount;
+  preparators[SortByListeners]                = NumericByListeners;
+  preparators[SortByBitrate]                  = NumericByBitrate;
+  preparators[SortByRandom]                   = NumericByRandom;
+  preparators[SortByRelevance]                = NumericByRelevance;
+
+  return preparators;
+}
+
 std::map<SortBy, Fields> fillSortingFields()
 {
   std::map<SortBy, Fields> sortingFields;
@@ -696,94 +622,189 @@ std::map<SortBy, Fields> fillSortingFields()
 }
 
 std::map<SortBy, SortUtils::SortPreparator> SortUtils::m_preparators = fillPreparators();
+std::map<SortBy, SortUtils::NumericPreparator> SortUtils::m_numericPreparators = fillNumericPreparators();
 std::map<SortBy, Fields> SortUtils::m_sortingFields = fillSortingFields();
 
-void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, DatabaseResults& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
+CSortColumns::CSortColumns(const SortDescription &sortDescription, bool keepLabels)
+  : m_description(sortDescription),
+    m_fields(SortUtils::GetFieldsForSorting(sortDescription.sortBy)),
+    m_keepLabels(keepLabels)
 {
-  if (sortBy != SortByNone)
+  if (m_description.sortBy != SortByNone)
   {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator != NULL)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
+    m_preparator = SortUtils::getPreparator(m_description.sortBy);
+    if (m_preparator != NULL)
+      m_numericPreparator = SortUtils::getNumericPreparator(m_description.sortBy);
+  }
+}
 
-      // Prepare the string used for sorting and store it under FieldSort
-      for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
-      {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if (item->find(*field) == item->end())
-            item->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-        item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
-      }
+void CSortColumns::Reserve(size_t size)
+{
+  m_special.reserve(size);
+  m_folder.reserve(size);
+  if (m_numericPreparator != NULL)
+    m_numbers.reserve(size);
+  if (m_numericPreparator == NULL || m_keepLabels)
+    m_labels.reserve(size);
+}
 
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
-    }
+void CSortColumns::Add(SortItem &item)
+{
+  m_size++;
+  if (!IsSorting())
+    return;
+
+  // add all fields to the item that are required for sorting if they are currently missing
+  for (Fields::const_iterator field = m_fields.begin(); field != m_fields.end(); ++field)
+  {
+    if (item.find(*field) == item.end())
+      item.insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
   }
 
-  if (limitStart > 0 && (size_t)limitStart < items.size())
+  SortItem::const_iterator it = item.find(FieldSortSpecial);
+  if (it != item.end() && it->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    m_special.push_back(static_cast<uint8_t>(it->second.asInteger()));
+  else
+    m_special.push_back(SortSpecialNone);
+
+  it = item.find(FieldFolder);
+  if (it != item.end())
+    m_folder.push_back(it->second.asBoolean() ? 1 : 0);
+  else
+    m_folder.push_back(-1);
+
+  if (m_numericPreparator != NULL)
+    m_numbers.push_back(m_numericPreparator(m_description.sortAttributes, item));
+
+  if (m_numericPreparator == NULL || m_keepLabels)
   {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
+    m_labels.emplace_back();
+    g_charsetConverter.utf8ToW(m_preparator(m_description.sortAttributes, item), m_labels.back(), false);
   }
-  if (limitEnd > 0 && (size_t)limitEnd < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
 }
 
-void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, SortItems& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
+std::vector<size_t> CSortColumns::Sort() const
 {
-  if (sortBy != SortByNone)
+  std::vector<size_t> order(m_size);
+  for (size_t i = 0; i < m_size; i++)
+    order[i] = i;
+
+  if (IsSorting())
   {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator != NULL)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
+    // compare labels bytewise on keys built once for all items
+    std::vector<std::string> keys;
+    if (m_numericPreparator == NULL)
+      StringUtils::AlphaNumericSortKeys(m_labels, keys);
+
+    const bool descending = m_description.sortOrder == SortOrderDescending;
+    const bool handleFolders = !(m_description.sortAttributes & SortAttributeIgnoreFolders);
 
-      // Prepare the string used for sorting and store it under FieldSort
-      for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
+    std::stable_sort(order.begin(), order.end(), [&](size_t left, size_t right)
+    {
+      // one has a special sort: on top sorts above everything else, on bottom below
+      const uint8_t leftSpecial = m_special[left];
+      const uint8_t rightSpecial = m_special[right];
+      if (leftSpecial != rightSpecial)
+        return leftSpecial == SortSpecialOnTop || rightSpecial == SortSpecialOnBottom;
+      // both have either sort on top or sort on bottom -> leave as-is
+      if (leftSpecial != SortSpecialNone)
+        return false;
+
+      if (handleFolders)
       {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if ((*item)->find(*field) == (*item)->end())
-            (*item)->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
-        (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        const int8_t leftFolder = m_folder[left];
+        const int8_t rightFolder = m_folder[right];
+        if (leftFolder >= 0 && rightFolder >= 0 && leftFolder != rightFolder)
+          return leftFolder == 1;
       }
 
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
-    }
+      int result;
+      if (m_numericPreparator != NULL)
+        result = m_numbers[left] < m_numbers[right] ? -1 : (m_numbers[left] > m_numbers[right] ? 1 : 0);
+      else
+        result = keys[left].compare(keys[right]);
+
+      return descending ? result > 0 : result < 0;
+    });
   }
 
-  if (limitStart > 0 && (size_t)limitStart < items.size())
+  int limitEnd = m_description.limitEnd;
+  if (m_description.limitStart > 0 && (size_t)m_description.limitStart < order.size())
   {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
+    order.erase(order.begin(), order.begin() + m_description.limitStart);
+    limitEnd -= m_description.limitStart;
   }
-  if (limitEnd > 0 && (size_t)limitEnd < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
+  if (limitEnd > 0 && (size_t)limitEnd < order.size())
+    order.erase(order.begin() + limitEnd, order.end());
+
+  return order;
+}
+
+const std::wstring& CSortColumns::GetLabel(size_t index) const
+{
+  static const std::wstring empty;
+  if (index >= m_labels.size())
+    return empty;
+
+  return m_labels[index];
+}
+
+void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, DatabaseResults& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
+{
+  SortDescription sortDescription;
+  sortDescription.sortBy = sortBy;
+  sortDescription.sortOrder = sortOrder;
+  sortDescription.sortAttributes = attributes;
+  sortDescription.limitStart = limitStart;
+  sortDescription.limitEnd = limitEnd;
+
+  Sort(sortDescription, items);
+}
+
+void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, SortItems& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
+{
+  SortDescription sortDescription;
+  sortDescription.sortBy = sortBy;
+  sortDescription.sortOrder = sortOrder;
+  sortDescription.sortAttributes = attributes;
+  sortDescription.limitStart = limitStart;
+  sortDescription.limitEnd = limitEnd;
+
+  Sort(sortDescription, items);
 }
 
 void SortUtils::Sort(const SortDescription &sortDescription, DatabaseResults& items)
 {
-  Sort(sortDescription.sortBy, sortDescription.sortOrder, sortDescription.sortAttributes, items, sortDescription.limitEnd, sortDescription.limitStart);
+  CSortColumns columns(sortDescription, false);
+  columns.Reserve(items.size());
+  for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
+    columns.Add(*item);
+
+  const std::vector<size_t> order = columns.Sort();
+
+  DatabaseResults sortedItems;
+  sortedItems.reserve(order.size());
+  for (std::vector<size_t>::const_iterator index = order.begin(); index != order.end(); ++index)
+    sortedItems.push_back(std::move(items[*index]));
+
+  items = std::move(sortedItems);
 }
 
 void SortUtils::Sort(const SortDescription &sortDescription, SortItems& items)
 {
-  Sort(sortDescription.sortBy, sortDescription.sortOrder, sortDescription.sortAttributes, items, sortDescription.limitEnd, sortDescription.limitStart);
+  CSortColumns columns(sortDescription, false);
+  columns.Reserve(items.size());
+  for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
+    columns.Add(**item);
+
+  const std::vector<size_t> order = columns.Sort();
+
+  SortItems sortedItems;
+  sortedItems.reserve(order.size());
+  for (std::vector<size_t>::const_iterator index = order.begin(); index != order.end(); ++index)
+    sortedItems.push_back(std::move(items[*index]));
+
+  items = std::move(sortedItems);
 }
 
 bool SortUtils::SortFromDataset(const SortDescription &sortDescription, const MediaType &mediaType, const std::unique_ptr<dbiplus::Dataset> &dataset, DatabaseResults &results)
@@ -816,20 +837,13 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
+SortUtils::NumericPreparator SortUtils::getNumericPreparator(SortBy sortBy)
 {
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIgnoreFoldersDescending : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIndirectIgnoreFoldersDescending : SorterIndirectIgnoreFoldersAscending;
+  std::map<SortBy, NumericPreparator>::const_iterator it = m_numericPreparators.find(sortBy);
+  if (it != m_numericPreparators.end())
+    return it->second;
 
-  return sortOrder == SortOrderDescending ? SorterIndirectDescending : SorterIndirectAscending;
+  return NULL;
 }
 
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -202,14 +203,69 @@ public:
   static std::string RemoveArticles(const std::string &label);
 
   typedef std::string (*SortPreparator) (SortAttribute, const SortItem&);
-  typedef bool (*Sorter) (const DatabaseResult &, const DatabaseResult &);
-  typedef bool (*SorterIndirect) (const SortItemPtr &, const SortItemPtr &);
+  typedef int64_t (*NumericPreparator) (SortAttribute, const SortItem&);
 
 private:
+  friend class CSortColumns;
+
   static const SortPreparator& getPreparator(SortBy sortBy);
-  static Sorter getSorter(SortOrder sortOrder, SortAttribute attributes);
-  static SorterIndirect getSorterIndirect(SortOrder sortOrder, SortAttribute attributes);
+  static NumericPreparator getNumericPreparator(SortBy sortBy);
 
   static std::map<SortBy, SortPreparator> m_preparators;
+  static std::map<SortBy, NumericPreparator> m_numericPreparators;
   static std::map<SortBy, Fields> m_sortingFields;
 };
+
+/*!
+ \brief Sort keys of a list of items, stored column by column.
+
+ Every item is turned into its sort key exactly once by Add(). Sorting then
+ permutes an array of item indexes and only touches the contiguous key columns,
+ instead of looking up the key, folder and special flags in each SortItem map
+ on every comparison. Labels are turned into byte comparable keys (see
+ StringUtils::AlphaNumericSortKeys) and sort methods whose key is a single
+ number are compared natively without creating a label.
+ */
+class CSortColumns
+{
+public:
+  /*!
+   \param sortDescription how to sort, including the limits to apply
+   \param keepLabels whether GetLabel() is needed, otherwise numeric sort methods skip the label
+   */
+  CSortColumns(const SortDescription &sortDescription, bool keepLabels);
+
+  bool IsSorting() const { return m_preparator != NULL; }
+  void Reserve(size_t size);
+
+  /*!
+   \brief Extract the sort keys of the next item
+   Fields required for sorting that are missing in the item are added as null.
+   */
+  void Add(SortItem &item);
+
+  /*!
+   \brief Sort the added items and apply the limits of the sort description
+   \return the indexes (in order of Add()) of the resulting items, in sorted order
+   */
+  std::vector<size_t> Sort() const;
+
+  /*!
+   \brief The label used for sorting the item at index (in order of Add())
+   Only available if the columns were created with keepLabels.
+   */
+  const std::wstring& GetLabel(size_t index) const;
+
+private:
+  SortDescription m_description;
+  const Fields &m_fields;
+  bool m_keepLabels;
+  SortUtils::SortPreparator m_preparator = NULL;
+  SortUtils::NumericPreparator m_numericPreparator = NULL;
+
+  size_t m_size = 0;
+  std::vector<std::wstring> m_labels;
+  std::vector<int64_t> m_numbers;
+  std::vector<uint8_t> m_special;
+  std::vector<int8_t> m_folder; //!< -1 if the item has no FieldFolder
+};
@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <unordered_map>
 #include "utils/RegExp.h" // don't move or std functions end up in PCRE namespace
 
 #define FORMAT_BLOCK_SIZE 512 // # of bytes for initial allocation for printf
@@ -818,6 +819,84 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t *left, const wchar_t *rig
   return 0; // files are the same
 }
 
+void StringUtils::AlphaNumericSortKeys(const std::vector<std::wstring> &strings, std::vector<std::string> &keys)
+{
+  auto fold = [](wchar_t c)
+  {
+    return c >= L'A' && c <= L'Z' ? static_cast<wchar_t>(c + L'a' - L'A') : c;
+  };
+  auto isDigit = [](wchar_t c)
+  {
+    return c >= L'0' && c <= L'9';
+  };
+
+  // rank every distinct character by the collation of the current locale,
+  // characters comparing equal share a rank
+  std::unordered_map<wchar_t, uint16_t> ranks;
+  for (const auto &str : strings)
+  {
+    for (wchar_t c : str)
+      ranks.emplace(isDigit(c) ? L'0' : fold(c), 0);
+  }
+
+  std::vector<wchar_t> chars;
+  chars.reserve(ranks.size());
+  for (const auto &rank : ranks)
+    chars.push_back(rank.first);
+
+  const std::collate<wchar_t>& coll = std::use_facet<std::collate<wchar_t> >(g_langInfo.GetSystemLocale());
+  auto compare = [&coll](const wchar_t &left, const wchar_t &right)
+  {
+    return coll.compare(&left, &left + 1, &right, &right + 1);
+  };
+  std::sort(chars.begin(), chars.end(), [&compare](wchar_t left, wchar_t right)
+  {
+    return compare(left, right) < 0;
+  });
+
+  uint16_t rank = 1;
+  for (size_t i = 0; i < chars.size(); i++)
+  {
+    if (i > 0 && compare(chars[i - 1], chars[i]) != 0 && rank < 0xFFFF)
+      rank++;
+    ranks[chars[i]] = rank;
+  }
+
+  keys.resize(strings.size());
+  for (size_t i = 0; i < strings.size(); i++)
+  {
+    std::string &key = keys[i];
+    key.clear();
+    key.reserve(strings[i].size() * 2);
+
+    const wchar_t *c = strings[i].c_str();
+    while (*c != 0)
+    {
+      const wchar_t ch = isDigit(*c) ? L'0' : fold(*c);
+      const uint16_t r = ranks[ch];
+      key.push_back(static_cast<char>(r >> 8));
+      key.push_back(static_cast<char>(r & 0xFF));
+
+      if (ch != L'0')
+      {
+        c++;
+        continue;
+      }
+
+      // numbers compare by value, up to 15 digits at once like AlphaNumericCompare:
+      // number of significant digits followed by the digits
+      const wchar_t *end = c;
+      while (isDigit(*end) && end < c + 15)
+        end++;
+      while (c < end && *c == L'0')
+        c++;
+      key.push_back(static_cast<char>(end - c));
+      for (; c < end; c++)
+        key.push_back(static_cast<char>(*c));
+    }
+  }
+}
+
 int StringUtils::DateStringToYYYYMMDD(const std::string &dateString)
 {
   std::vector<std::string> days = StringUtils::Split(dateString, '-');
@@ -229,6 +229,14 @@ public:
   static std::vector<std::string> SplitMulti(const std::vector<std::string> &input, const std::vector<std::string> &delimiters, unsigned int iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*! \brief Build sort keys that compare bytewise in the order of AlphaNumericCompare
+   The collation of the system locale is evaluated once per distinct character of
+   all strings instead of on every comparison. All digits sort where '0' does when
+   compared with other characters.
+   \param strings the strings to build the keys for
+   \param keys [out] the keys, in the order of strings
+   */
+  static void AlphaNumericSortKeys(const std::vector<std::wstring> &strings, std::vector<std::string> &keys);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
 
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TraceRecorder.h"
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+// about 200 KB for each thread that records events
+const size_t EVENTS_PER_THREAD = 8192;
+// events of threads started once this many threads recorded are dropped
+const size_t MAX_THREADS = 128;
+
+struct Event
+{
+  const char* name;
+  int64_t start;
+  int64_t duration;
+};
+
+struct ThreadEvents
+{
+  CCriticalSection section;
+  uint64_t threadId;
+  std::string threadName;
+  std::vector<Event> events;
+  size_t next = 0; //!< where the next event goes once the buffer is full
+};
+
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+std::atomic<bool> enabled(false);
+
+CCriticalSection threadsSection;
+std::vector<std::unique_ptr<ThreadEvents>> threads;
+
+thread_local ThreadEvents* currentThread = nullptr;
+
+ThreadEvents* GetThreadEvents()
+{
+  if (currentThread)
+    return currentThread;
+
+  CSingleLock lock(threadsSection);
+  if (threads.size() >= MAX_THREADS)
+    return nullptr;
+
+  std::unique_ptr<ThreadEvents> events(new ThreadEvents);
+  events->threadId = static_cast<uint64_t>(CThread::GetDisplayThreadId(CThread::GetCurrentThreadId()));
+  CThread* thread = CThread::GetCurrentThread();
+  if (thread)
+    events->threadName = thread->GetThreadName();
+  else
+    events->threadName = "thread " + std::to_string(events->threadId);
+  events->events.reserve(EVENTS_PER_THREAD);
+
+  currentThread = events.get();
+  threads.push_back(std::move(events));
+  return currentThread;
+}
+
+std::string Escape(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+}
+
+void CTraceRecorder::Start()
+{
+  enabled = true;
+}
+
+void CTraceRecorder::Stop()
+{
+  enabled = false;
+}
+
+bool CTraceRecorder::IsEnabled()
+{
+  return enabled;
+}
+
+int64_t CTraceRecorder::Now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - processStart).count();
+}
+
+void CTraceRecorder::Add(const char* name, int64_t start, int64_t duration)
+{
+  if (!enabled)
+    return;
+
+  ThreadEvents* thread = GetThreadEvents();
+  if (!thread)
+    return;
+
+  // only contended while the events are saved
+  CSingleLock lock(thread->section);
+  Event event = { name, start, duration };
+  if (thread->events.size() < EVENTS_PER_THREAD)
+    thread->events.push_back(event);
+  else
+  {
+    thread->events[thread->next] = event;
+    thread->next = (thread->next + 1) % EVENTS_PER_THREAD;
+  }
+}
+
+void CTraceRecorder::SetThreadName(const std::string& name)
+{
+  ThreadEvents* thread = GetThreadEvents();
+  if (!thread)
+    return;
+
+  CSingleLock lock(thread->section);
+  thread->threadName = name;
+}
+
+bool CTraceRecorder::Save(const std::string& file)
+{
+  std::string json = "{\"traceEvents\":[";
+  size_t count = 0;
+  bool first = true;
+  {
+    CSingleLock lock(threadsSection);
+    for (const auto& thread : threads)
+    {
+      CSingleLock threadLock(thread->section);
+      const std::string tid = std::to_string(thread->threadId);
+      json += first ? "\n" : ",\n";
+      json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid +
+              ",\"args\":{\"name\":\"" + Escape(thread->threadName) + "\"}}";
+
+      // oldest first
+      const std::vector<Event>& events = thread->events;
+      for (size_t i = 0; i < events.size(); i++)
+      {
+        const Event& event = events[(thread->next + i) % events.size()];
+        json += ",\n{\"name\":\"" + Escape(event.name) + "\",\"ph\":\"X\",\"ts\":" + std::to_string(event.start) +
+                ",\"dur\":" + std::to_string(event.duration) + ",\"pid\":1,\"tid\":" + tid + "}";
+      }
+      count += events.size();
+      first = false;
+    }
+  }
+  json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  XFILE::CFile traceFile;
+  if (!traceFile.OpenForWrite(file, true) || traceFile.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTraceRecorder: unable to save trace to %s", file.c_str());
+    return false;
+  }
+
+  CLog::Log(LOGNOTICE, "CTraceRecorder: saved %u events to %s", static_cast<unsigned int>(count), file.c_str());
+  return true;
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+/*!
+ \brief Records how long scopes of the application take, to find out where the time
+ goes during startup and in each frame.
+
+ Every thread records into its own ring buffer, which keeps the latest events. The
+ events are saved in the Chrome trace event format, which chrome://tracing and
+ https://ui.perfetto.dev can show. Recording is started with the --trace argument.
+
+ Scopes are recorded with KODI_TRACE_SCOPE, which is compiled out unless HAS_TRACE
+ is defined (cmake option ENABLE_TRACE).
+ */
+class CTraceRecorder
+{
+public:
+  /*!
+   \brief Start recording. Events recorded before are kept.
+   */
+  static void Start();
+
+  /*!
+   \brief Stop recording.
+   */
+  static void Stop();
+
+  /*!
+   \return true if events are recorded, false otherwise.
+   */
+  static bool IsEnabled();
+
+  /*!
+   \return the time in microseconds since the process started.
+   */
+  static int64_t Now();
+
+  /*!
+   \brief Record an event of the calling thread.
+   \param name the name of the event. Must stay valid, usually a string literal.
+   \param start the start of the event, see Now().
+   \param duration the duration of the event in microseconds.
+   */
+  static void Add(const char* name, int64_t start, int64_t duration);
+
+  /*!
+   \brief Set the name the calling thread is shown with. Threads created with CThread
+   are shown with their own name.
+   */
+  static void SetThreadName(const std::string& name);
+
+  /*!
+   \brief Save the recorded events.
+   \param file the file to save the events to, usually in special://temp.
+   \return true if the events were saved, false otherwise.
+   */
+  static bool Save(const std::string& file);
+};
+
+/*!
+ \brief Records the time from its construction to its destruction, see KODI_TRACE_SCOPE.
+ */
+class CTraceScope
+{
+public:
+  explicit CTraceScope(const char* name)
+    : m_name(name),
+      m_start(CTraceRecorder::IsEnabled() ? CTraceRecorder::Now() : -1)
+  {
+  }
+
+  ~CTraceScope()
+  {
+    if (m_start >= 0)
+      CTraceRecorder::Add(m_name, m_start, CTraceRecorder::Now() - m_start);
+  }
+
+  CTraceScope(const CTraceScope&) = delete;
+  CTraceScope& operator=(const CTraceScope&) = delete;
+
+private:
+  const char* m_name;
+  int64_t m_start;
+};
+
+#ifdef HAS_TRACE
+#define KODI_TRACE_CONCAT_(a, b) a##b
+#define KODI_TRACE_CONCAT(a, b) KODI_TRACE_CONCAT_(a, b)
+#define KODI_TRACE_SCOPE(name) CTraceScope KODI_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define KODI_TRACE_SCOPE(name)
+#endif
@@ -409,3 +409,14 @@ TEST_F(TestArchive, MultiTypeArchive)
   EXPECT_EQ(2, iArray_var.at(2));
   EXPECT_EQ(3, iArray_var.at(3));
 }
+
+TEST(TestArchiveStore, WriteError)
+{
+  // nothing can be written to a file that isn't open
+  XFILE::CFile file;
+  CArchive arstore(&file, CArchive::store);
+  arstore << std::string(100000, 'x');
+  arstore << 1;
+  arstore.Close();
+  EXPECT_TRUE(arstore.HasWriteError());
+}
@@ -63,6 +63,17 @@ TEST_F(TestJobManager, CancelJob)
   EXPECT_TRUE(cancelled);
 }
 
+TEST_F(TestJobManager, SubmitAfterCancelJobs)
+{
+  CJobManager::GetInstance().CancelJobs();
+  bool ran = false;
+  EXPECT_EQ(0u, CJobManager::GetInstance().Submit([&ran]() { ran = true; }));
+  EXPECT_FALSE(ran);
+
+  CJobManager::GetInstance().Restart();
+  EXPECT_NE(0u, CJobManager::GetInstance().Submit([]() {}));
+}
+
 namespace
 {
 struct JobControlPackage
@@ -9,6 +9,9 @@
 #include "utils/SortUtils.h"
 #include "utils/Variant.h"
 
+#include <chrono>
+#include <iostream>
+
 #include "gtest/gtest.h"
 
 TEST(TestSortUtils, Sort_SortBy)
@@ -121,3 +124,116 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)5, fields.size());
 }
+
+TEST(TestSortUtils, Sort_FoldersAndSpecial)
+{
+  SortItems items;
+  const char* labels[] = { "b file", "top", "a folder", "bottom", "a file", "c folder" };
+  for (const char* label : labels)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = label;
+    (*item)[FieldFolder] = std::string(label).find("folder") != std::string::npos;
+    items.push_back(item);
+  }
+  (*items[1])[FieldSortSpecial] = SortSpecialOnTop;
+  (*items[3])[FieldSortSpecial] = SortSpecialOnBottom;
+
+  SortUtils::Sort(SortByLabel, SortOrderDescending, SortAttributeNone, items);
+
+  EXPECT_STREQ("top", (*items.at(0))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("c folder", (*items.at(1))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("a folder", (*items.at(2))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("b file", (*items.at(3))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("a file", (*items.at(4))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("bottom", (*items.at(5))[FieldLabel].asString().c_str());
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeIgnoreFolders, items);
+
+  EXPECT_STREQ("top", (*items.at(0))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("a file", (*items.at(1))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("a folder", (*items.at(2))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("b file", (*items.at(3))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("c folder", (*items.at(4))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("bottom", (*items.at(5))[FieldLabel].asString().c_str());
+}
+
+TEST(TestSortUtils, Sort_NumericAndLimits)
+{
+  DatabaseResults items;
+  const int64_t sizes[] = { 100, 9, 1000, 20, 5 };
+  for (int64_t size : sizes)
+  {
+    DatabaseResult item;
+    item[FieldSize] = size;
+    items.push_back(item);
+  }
+
+  SortDescription sorting;
+  sorting.sortBy = SortBySize;
+  sorting.limitStart = 1;
+  sorting.limitEnd = 4;
+  SortUtils::Sort(sorting, items);
+
+  ASSERT_EQ(3u, items.size());
+  EXPECT_EQ(9, items[0][FieldSize].asInteger());
+  EXPECT_EQ(20, items[1][FieldSize].asInteger());
+  EXPECT_EQ(100, items[2][FieldSize].asInteger());
+}
+
+TEST(TestSortUtils, SortColumns_Labels)
+{
+  SortDescription sorting;
+  sorting.sortBy = SortByTrackNumber;
+  CSortColumns columns(sorting, true);
+
+  SortItem item;
+  item[FieldTrackNumber] = 12;
+  columns.Add(item);
+  item.clear();
+  columns.Add(item);
+
+  std::vector<size_t> order = columns.Sort();
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(1u, order[0]);
+  EXPECT_EQ(0u, order[1]);
+  EXPECT_TRUE(columns.GetLabel(0) == L"12");
+  EXPECT_TRUE(columns.GetLabel(1) == L"0");
+}
+
+TEST(TestSortUtils, DISABLED_Benchmark_SortByArtist)
+{
+  const size_t count = 50000;
+  uint32_t seed = 1;
+  auto random = [&seed]()
+  {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % 10000;
+  };
+
+  SortItems items;
+  items.reserve(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldArtist] = "Artist " + std::to_string(random());
+    (*item)[FieldYear] = static_cast<int>(1950 + random() % 70);
+    (*item)[FieldAlbum] = "Album " + std::to_string(random());
+    (*item)[FieldTrackNumber] = static_cast<int>(random() % 20);
+    (*item)[FieldFolder] = false;
+    items.push_back(item);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  SortUtils::Sort(SortByArtist, SortOrderAscending, SortAttributeNone, items);
+  auto artist = std::chrono::steady_clock::now();
+  SortUtils::Sort(SortByTrackNumber, SortOrderDescending, SortAttributeNone, items);
+  auto track = std::chrono::steady_clock::now();
+
+  std::cout << "sorted " << count << " items by artist in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(artist - start).count()
+            << " ms, by track number in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(track - artist).count()
+            << " ms" << std::endl;
+  EXPECT_EQ(count, items.size());
+}
@@ -301,6 +301,24 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+TEST(TestStringUtils, AlphaNumericSortKeys)
+{
+  std::vector<std::wstring> strings = { L"abc123", L"123abc", L"ABC12", L"abc 9", L"abc 10",
+                                        L"file2", L"file02", L"file10", L"", L"b", L"Ba",
+                                        L"x0000000000000001", L"x000000000000002" };
+  std::vector<std::string> keys;
+  StringUtils::AlphaNumericSortKeys(strings, keys);
+  ASSERT_EQ(strings.size(), keys.size());
+
+  auto sign = [](int64_t value) { return value < 0 ? -1 : (value > 0 ? 1 : 0); };
+  for (size_t i = 0; i < strings.size(); i++)
+  {
+    for (size_t j = 0; j < strings.size(); j++)
+      EXPECT_EQ(sign(StringUtils::AlphaNumericCompare(strings[i].c_str(), strings[j].c_str())),
+                sign(keys[i].compare(keys[j])));
+  }
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/TraceRecorder.h"
+#include "utils/Variant.h"
+
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class TestTraceRecorder : public testing::Test
+{
+protected:
+  TestTraceRecorder()
+  {
+    file = XBMC_CREATETEMPFILE(".json");
+  }
+  ~TestTraceRecorder() override
+  {
+    CTraceRecorder::Stop();
+    EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+  }
+
+  CVariant Save()
+  {
+    CVariant trace;
+    std::string path = XBMC_TEMPFILEPATH(file);
+    EXPECT_TRUE(CTraceRecorder::Save(path));
+
+    XFILE::CFile traceFile;
+    XUTILS::auto_buffer buffer;
+    EXPECT_GT(traceFile.LoadFile(path, buffer), 0);
+    EXPECT_TRUE(CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), trace));
+    return trace;
+  }
+
+  std::vector<CVariant> GetEvents(const CVariant& trace, const std::string& name)
+  {
+    std::vector<CVariant> events;
+    for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+    {
+      if ((*it)["name"].asString() == name)
+        events.push_back(*it);
+    }
+    return events;
+  }
+
+  XFILE::CFile *file;
+};
+
+TEST_F(TestTraceRecorder, Scopes)
+{
+  CTraceRecorder::Start();
+  {
+    CTraceScope outer("TestTraceRecorder.Outer");
+    CTraceScope inner("TestTraceRecorder.Inner");
+  }
+
+  CVariant trace = Save();
+  std::vector<CVariant> outer = GetEvents(trace, "TestTraceRecorder.Outer");
+  std::vector<CVariant> inner = GetEvents(trace, "TestTraceRecorder.Inner");
+  ASSERT_EQ(1u, outer.size());
+  ASSERT_EQ(1u, inner.size());
+
+  EXPECT_EQ("X", outer[0]["ph"].asString());
+  EXPECT_EQ(outer[0]["tid"].asUnsignedInteger(), inner[0]["tid"].asUnsignedInteger());
+  EXPECT_GE(inner[0]["ts"].asInteger(), outer[0]["ts"].asInteger());
+  EXPECT_LE(inner[0]["ts"].asInteger() + inner[0]["dur"].asInteger(),
+            outer[0]["ts"].asInteger() + outer[0]["dur"].asInteger());
+}
+
+TEST_F(TestTraceRecorder, Stopped)
+{
+  CTraceRecorder::Stop();
+  {
+    CTraceScope scope("TestTraceRecorder.Stopped");
+  }
+  CTraceRecorder::Add("TestTraceRecorder.Stopped", CTraceRecorder::Now(), 0);
+
+  EXPECT_TRUE(GetEvents(Save(), "TestTraceRecorder.Stopped").empty());
+}
+
+TEST_F(TestTraceRecorder, LatestEvents)
+{
+  CTraceRecorder::Start();
+  std::thread thread([]()
+  {
+    CTraceRecorder::SetThreadName("TestTraceRecorder");
+    for (int i = 0; i < 10; i++)
+      CTraceRecorder::Add("TestTraceRecorder.Old", CTraceRecorder::Now(), 0);
+    for (int i = 0; i < 100000; i++)
+      CTraceRecorder::Add("TestTraceRecorder.New", CTraceRecorder::Now(), 0);
+  });
+  thread.join();
+
+  CVariant trace = Save();
+  std::vector<CVariant> names = GetEvents(trace, "thread_name");
+  auto name = std::find_if(names.begin(), names.end(), [](const CVariant& event)
+  {
+    return event["args"]["name"].asString() == "TestTraceRecorder";
+  });
+  ASSERT_NE(names.end(), name);
+
+  // only the latest events of the thread are kept, oldest first
+  EXPECT_TRUE(GetEvents(trace, "TestTraceRecorder.Old").empty());
+  std::vector<CVariant> events = GetEvents(trace, "TestTraceRecorder.New");
+  ASSERT_FALSE(events.empty());
+  EXPECT_LT(events.size(), 100000u);
+  for (size_t i = 1; i < events.size(); i++)
+  {
+    EXPECT_EQ((*name)["tid"].asUnsignedInteger(), events[i]["tid"].asUnsignedInteger());
+    EXPECT_LE(events[i - 1]["ts"].asInteger(), events[i]["ts"].asInteger());
+  }
+}
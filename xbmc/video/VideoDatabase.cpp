@@ -58,6 +58,7 @@
 #include "utils/Variant.h"
 #include "utils/XMLUtils.h"
 #include "video/VideoDbUrl.h"
+#include "video/VideoPlaceholderLoader.h"
 #include "video/windows/GUIWindowVideoBase.h"
 #include "VideoInfoScanner.h"
 #include "XBDateTime.h"
@@ -98,6 +99,9 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create stacktimes table");
   m_pDS->exec("CREATE TABLE stacktimes (idFile integer, times text)\n");
 
+  CLog::Log(LOGINFO, "create seekindex table");
+  m_pDS->exec("CREATE TABLE seekindex (idFile integer primary key, data text)\n");
+
   CLog::Log(LOGINFO, "create genre table");
   m_pDS->exec("CREATE TABLE genre ( genre_id integer primary key, name TEXT)\n");
   m_pDS->exec("CREATE TABLE genre_link (genre_id integer, media_id integer, media_type TEXT)");
@@ -331,6 +335,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
+              "DELETE FROM seekindex WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
@@ -1434,23 +1439,35 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
-    std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
+    const std::string name = value.substr(0, 255);
+    if (InBatch())
+    {
+      const auto& ids = m_lookupIds[table];
+      const auto it = ids.find(name);
+      if (it != ids.end())
+        return it->second;
+    }
+
+    int id;
+    std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), name.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
+      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), name.c_str());
       m_pDS->exec(strSQL);
-      int id = (int)m_pDS->lastinsertid();
-      return id;
+      id = (int)m_pDS->lastinsertid();
     }
     else
     {
-      int id = m_pDS->fv(firstField.c_str()).get_asInt();
+      id = m_pDS->fv(firstField.c_str()).get_asInt();
       m_pDS->close();
-      return id;
     }
+
+    if (InBatch())
+      m_lookupIds[table][name] = id;
+    return id;
   }
   catch (...)
   {
@@ -1637,26 +1654,40 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
     std::string trimmedName = name.c_str();
     StringUtils::Trim(trimmedName);
 
-    std::string strSQL=PrepareSQL("select actor_id from actor where name like '%s'", trimmedName.substr(0, 255).c_str());
-    m_pDS->query(strSQL);
-    if (m_pDS->num_rows() == 0)
-    {
-      m_pDS->close();
-      // doesnt exists, add it
-      strSQL=PrepareSQL("insert into actor (actor_id, name, art_urls) values(NULL, '%s', '%s')", trimmedName.substr(0,255).c_str(), thumbURLs.c_str());
-      m_pDS->exec(strSQL);
-      idActor = (int)m_pDS->lastinsertid();
-    }
+    trimmedName = trimmedName.substr(0, 255);
+
+    bool added = false;
+    std::map<std::string, int>* cachedIds = InBatch() ? &m_lookupIds["actor"] : nullptr;
+    std::map<std::string, int>::const_iterator cached;
+    if (cachedIds && (cached = cachedIds->find(trimmedName)) != cachedIds->end())
+      idActor = cached->second;
     else
     {
-      idActor = m_pDS->fv(0).get_asInt();
-      m_pDS->close();
-      // update the thumb url's
-      if (!thumbURLs.empty())
+      std::string strSQL=PrepareSQL("select actor_id from actor where name like '%s'", trimmedName.c_str());
+      m_pDS->query(strSQL);
+      if (m_pDS->num_rows() == 0)
       {
-        strSQL=PrepareSQL("update actor set art_urls = '%s' where actor_id = %i", thumbURLs.c_str(), idActor);
+        m_pDS->close();
+        // doesnt exists, add it
+        strSQL=PrepareSQL("insert into actor (actor_id, name, art_urls) values(NULL, '%s', '%s')", trimmedName.c_str(), thumbURLs.c_str());
         m_pDS->exec(strSQL);
+        idActor = (int)m_pDS->lastinsertid();
+        added = true;
+      }
+      else
+      {
+        idActor = m_pDS->fv(0).get_asInt();
+        m_pDS->close();
       }
+      if (cachedIds)
+        (*cachedIds)[trimmedName] = idActor;
+    }
+
+    // update the thumb url's
+    if (!added && !thumbURLs.empty())
+    {
+      std::string strSQL=PrepareSQL("update actor set art_urls = '%s' where actor_id = %i", thumbURLs.c_str(), idActor);
+      m_pDS->exec(strSQL);
     }
     // add artwork
     if (!thumb.empty())
@@ -2451,6 +2482,104 @@ int CVideoDatabase::SetDetailsForMovie(const std::string& strFilenameAndPath, CV
   return -1;
 }
 
+int CVideoDatabase::SetDetailsForMovies(std::vector<CVideoInfoTag> &movies, const std::vector<std::map<std::string, std::string>> &artwork)
+{
+  if (NULL == m_pDB.get() || NULL == m_pDS.get())
+    return 0;
+
+  BeginBatch();
+
+  // look up the ids shared between the movies once
+  std::map<std::string, std::set<std::string>> names;
+  for (const auto& details : movies)
+  {
+    for (const auto& actor : details.m_cast)
+    {
+      std::string name = actor.strName;
+      names["actor"].insert(StringUtils::Trim(name).substr(0, 255));
+    }
+    for (const auto& director : details.m_director)
+      names["actor"].insert(director.substr(0, 255));
+    for (const auto& writer : details.m_writingCredits)
+      names["actor"].insert(writer.substr(0, 255));
+    for (const auto& genre : details.m_genre)
+      names["genre"].insert(genre.substr(0, 255));
+    for (const auto& studio : details.m_studio)
+      names["studio"].insert(studio.substr(0, 255));
+    for (const auto& country : details.m_country)
+      names["country"].insert(country.substr(0, 255));
+    for (const auto& tag : details.m_tags)
+      names["tag"].insert(tag.substr(0, 255));
+  }
+  for (const auto& table : names)
+    LoadLookupIds(table.first, table.first + "_id", table.second);
+
+  int added = 0;
+  static const std::map<std::string, std::string> noArtwork;
+  for (size_t i = 0; i < movies.size(); i++)
+  {
+    CVideoInfoTag& details = movies[i];
+    // a movie failing only rolls back its own changes
+    details.m_iDbId = SetDetailsForMovie(details.m_strFileNameAndPath, details,
+                                         i < artwork.size() ? artwork[i] : noArtwork);
+    if (details.m_iDbId > -1)
+      added++;
+  }
+
+  if (!CommitBatch())
+  {
+    for (auto& details : movies)
+      details.m_iDbId = -1;
+    return 0;
+  }
+  return added;
+}
+
+void CVideoDatabase::LoadLookupIds(const std::string &table, const std::string &idField, const std::set<std::string> &names)
+{
+  if (!InBatch())
+    return;
+
+  // keep the statements at a size every backend accepts
+  const size_t chunkSize = 500;
+
+  std::map<std::string, int>& ids = m_lookupIds[table];
+  std::string list;
+  size_t count = 0;
+  for (auto it = names.begin(); it != names.end(); )
+  {
+    if (!it->empty() && ids.find(*it) == ids.end())
+    {
+      if (!list.empty())
+        list += ",";
+      list += PrepareSQL("'%s'", it->c_str());
+      count++;
+    }
+
+    ++it;
+    if (list.empty() || (count < chunkSize && it != names.end()))
+      continue;
+
+    try
+    {
+      m_pDS->query(PrepareSQL("SELECT %s, name FROM %s WHERE name IN (", idField.c_str(), table.c_str()) + list + ")");
+      while (!m_pDS->eof())
+      {
+        ids[m_pDS->fv(1).get_asString()] = m_pDS->fv(0).get_asInt();
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
+    catch (...)
+    {
+      // the names are looked up one by one when they're added
+      CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, table.c_str());
+    }
+    list.clear();
+    count = 0;
+  }
+}
+
 int CVideoDatabase::UpdateDetailsForMovie(int idMovie, CVideoInfoTag& details, const std::map<std::string, std::string> &artwork, const std::set<std::string> &updatedDetails)
 {
   if (idMovie < 0)
@@ -3896,24 +4025,29 @@ bool CVideoDatabase::GetResumePoint(CVideoInfoTag& tag)
   return match;
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMovie(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */)
-{
-  return GetDetailsForMovie(pDS->get_sql_record(), getDetails);
-}
-
-CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+CVideoInfoTag CVideoDatabase::GetBasicDetailsForMovie(const dbiplus::sql_record* const record)
 {
   CVideoInfoTag details;
 
-  if (record == NULL)
+  if (record == nullptr)
     return details;
 
-  DWORD time = XbmcThreads::SystemClockMillis();
-  int idMovie = record->at(0).get_asInt();
+  unsigned int time = XbmcThreads::SystemClockMillis();
 
-  GetDetailsFromDB(record, VIDEODB_ID_MIN, VIDEODB_ID_MAX, DbMovieOffsets, details);
+  // only the columns needed to sort, label and group movies, see GetMoviesByWhere()
+  static const int columns[] = { VIDEODB_ID_TITLE, VIDEODB_ID_SORTTITLE, VIDEODB_ID_RUNTIME, VIDEODB_ID_MPAA,
+                                 VIDEODB_ID_TOP250, VIDEODB_ID_ORIGINALTITLE, VIDEODB_ID_BASEPATH, VIDEODB_ID_PARENTPATHID };
+  for (int column : columns)
+    GetDetailsFromDB(record, column - 1, column + 1, DbMovieOffsets, details);
+  GetMovieViewDetails(record, details);
+
+  movieTime += XbmcThreads::SystemClockMillis() - time;
+  return details;
+}
 
-  details.m_iDbId = idMovie;
+void CVideoDatabase::GetMovieViewDetails(const dbiplus::sql_record* const record, CVideoInfoTag &details)
+{
+  details.m_iDbId = record->at(0).get_asInt();
   details.m_type = MediaTypeMovie;
 
   details.m_set.id = record->at(VIDEODB_DETAILS_MOVIE_SET_ID).get_asInt();
@@ -3939,6 +4073,25 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* cons
     details.SetYear(record->at(VIDEODB_DETAILS_MOVIE_PREMIERED).get_asInt());
   else
     details.SetPremieredFromDBDate(premieredString);
+}
+
+CVideoInfoTag CVideoDatabase::GetDetailsForMovie(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */)
+{
+  return GetDetailsForMovie(pDS->get_sql_record(), getDetails);
+}
+
+CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+{
+  CVideoInfoTag details;
+
+  if (record == NULL)
+    return details;
+
+  DWORD time = XbmcThreads::SystemClockMillis();
+  int idMovie = record->at(0).get_asInt();
+
+  GetDetailsFromDB(record, VIDEODB_ID_MIN, VIDEODB_ID_MAX, DbMovieOffsets, details);
+  GetMovieViewDetails(record, details);
   movieTime += XbmcThreads::SystemClockMillis() - time; time = XbmcThreads::SystemClockMillis();
 
   if (getDetails)
@@ -4816,6 +4969,48 @@ bool CVideoDatabase::GetStackTimes(const std::string &filePath, std::vector<uint
   return false;
 }
 
+bool CVideoDatabase::GetSeekIndex(const std::string &filePath, std::string &data)
+{
+  try
+  {
+    int idFile = GetFileId(filePath);
+    if (idFile < 0) return false;
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    m_pDS->query(PrepareSQL("SELECT data FROM seekindex WHERE idFile=%i", idFile));
+    bool found = !m_pDS->eof();
+    if (found)
+      data = m_pDS->fv(0).get_asString();
+    m_pDS->close();
+    return found;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, CURL::GetRedacted(filePath).c_str());
+  }
+  return false;
+}
+
+void CVideoDatabase::SetSeekIndex(const std::string &filePath, const std::string &data)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return;
+    if (NULL == m_pDS.get()) return;
+    int idFile = AddFile(filePath);
+    if (idFile < 0)
+      return;
+
+    m_pDS->exec(PrepareSQL("DELETE FROM seekindex WHERE idFile=%i", idFile));
+    m_pDS->exec(PrepareSQL("INSERT INTO seekindex (idFile, data) VALUES (%i, '%s')", idFile, data.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, CURL::GetRedacted(filePath).c_str());
+  }
+}
+
 /// \brief Sets the stack times for a particular video file
 void CVideoDatabase::SetStackTimes(const std::string& filePath, const std::vector<uint64_t> &times)
 {
@@ -5577,11 +5772,14 @@ void CVideoDatabase::UpdateTables(int iVersion)
     }
     m_pDS->close();
   }
+
+  if (iVersion < 117)
+    m_pDS->exec("CREATE TABLE seekindex (idFile integer primary key, data text)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 116;
+  return 117;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -7151,6 +7349,12 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, m_pDS, results))
       return false;
 
+    // large lists shown in a container only get what's needed to sort, label and group
+    // the movies, the rest is filled in as they're shown
+    const int placeholderItems = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoLibraryPlaceholderItems;
+    const bool placeholders = items.AllowPlaceholders() && getDetails == VideoDbDetailsNone &&
+                              placeholderItems > 0 && results.size() >= static_cast<size_t>(placeholderItems);
+
     // get data from returned rows
     items.Reserve(results.size());
     const query_data &data = m_pDS->get_result_set().records;
@@ -7159,7 +7363,7 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
       const dbiplus::sql_record* const record = data.at(targetRow);
 
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
+      CVideoInfoTag movie = placeholders ? GetBasicDetailsForMovie(record) : GetDetailsForMovie(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
           g_passwordManager.bMasterUser                                   ||
           g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
@@ -7173,10 +7377,14 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
         pItem->SetDynPath(movie.m_strFileNameAndPath);
 
         pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
+        pItem->SetPlaceholder(placeholders);
         items.Add(pItem);
       }
     }
 
+    if (placeholders)
+      items.SetPlaceholderLoader(std::make_shared<CVideoPlaceholderLoader>());
+
     // cleanup
     m_pDS->close();
     return true;
@@ -10008,10 +10216,27 @@ void CVideoDatabase::InvalidatePathHash(const std::string& strPath)
   }
 }
 
+void CVideoDatabase::BeginBatch()
+{
+  // ids looked up outside of the batch may have been removed since
+  if (!InBatch())
+    m_lookupIds.clear();
+  CDatabase::BeginBatch();
+}
+
 bool CVideoDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
-  { // number of items in the db has likely changed, so recalculate
+  {
+    // the batch is recalculated once it's committed
+    if (InBatch())
+      return true;
+
+    m_lookupIds.clear();
+    if (!CServiceBroker::GetGUI())
+      return true;
+
+    // number of items in the db has likely changed, so recalculate
     GUIINFO::CLibraryGUIInfo& guiInfo = CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider();
     guiInfo.SetLibraryBool(LIBRARY_HAS_MOVIES, HasContent(VIDEODB_CONTENT_MOVIES));
     guiInfo.SetLibraryBool(LIBRARY_HAS_TVSHOWS, HasContent(VIDEODB_CONTENT_TVSHOWS));
@@ -10021,6 +10246,13 @@ bool CVideoDatabase::CommitTransaction()
   return false;
 }
 
+void CVideoDatabase::RollbackTransaction()
+{
+  // ids added by the transaction are gone
+  m_lookupIds.clear();
+  CDatabase::RollbackTransaction();
+}
+
 bool CVideoDatabase::SetSingleValue(VIDEODB_CONTENT_TYPE type, int dbId, int dbField, const std::string &strValue)
 {
   std::string strSQL;
@@ -420,7 +420,9 @@ public:
   ~CVideoDatabase(void) override;
 
   bool Open() override;
+  void BeginBatch() override;
   bool CommitTransaction() override;
+  void RollbackTransaction() override;
 
   int AddMovie(const std::string& strFilenameAndPath);
   int AddEpisode(int idShow, const std::string& strFilenameAndPath);
@@ -512,6 +514,16 @@ public:
   int SetDetailsForItem(int id, const MediaType& mediaType, CVideoInfoTag& details, const std::map<std::string, std::string> &artwork);
 
   int SetDetailsForMovie(const std::string& strFilenameAndPath, CVideoInfoTag& details, const std::map<std::string, std::string> &artwork, int idMovie = -1);
+
+  /*! \brief Add or update several movies in a single transaction
+   The ids of the actors, genres, studios, countries and tags of all the movies are
+   looked up at once and cached for the batch rather than queried for each movie.
+   \param movies the metadata of the movies, each file given by m_strFileNameAndPath.
+   m_iDbId is set to the id of the movie, or -1 if it couldn't be added.
+   \param artwork the artwork map of each movie.
+   \return the number of movies added.
+   */
+  int SetDetailsForMovies(std::vector<CVideoInfoTag> &movies, const std::vector<std::map<std::string, std::string>> &artwork);
   int SetDetailsForMovieSet(const CVideoInfoTag& details, const std::map<std::string, std::string> &artwork, int idSet = -1);
 
   /*! \brief add a tvshow to the library, setting metadata detail
@@ -609,6 +621,14 @@ public:
   bool GetStackTimes(const std::string &filePath, std::vector<uint64_t> &times);
   void SetStackTimes(const std::string &filePath, const std::vector<uint64_t> &times);
 
+  /*! \brief Get the serialized keyframe seek index of a file
+   \param filePath path of the file
+   \param data [out] index as produced by CDemuxSeekIndex::Serialize
+   \return true if an index is stored for the file
+   */
+  bool GetSeekIndex(const std::string &filePath, std::string &data);
+  void SetSeekIndex(const std::string &filePath, const std::string &data);
+
   void GetBookMarksForFile(const std::string& strFilenameAndPath, VECBOOKMARKS& bookmarks, CBookmark::EType type = CBookmark::STANDARD, bool bAppend=false, long partNumber=0);
   void AddBookMarkToFile(const std::string& strFilenameAndPath, const CBookmark &bookmark, CBookmark::EType type = CBookmark::STANDARD);
   bool GetResumeBookMark(const std::string& strFilenameAndPath, CBookmark &bookmark);
@@ -930,6 +950,13 @@ protected:
 
   void AddCast(int mediaId, const char *mediaType, const std::vector<SActorInfo> &cast);
 
+  /*! \brief Get the details of a movie needed to sort, label and group it in a list
+   \param record a row of movie_view
+   \return the movie details
+   \sa CVideoPlaceholderLoader
+   */
+  CVideoInfoTag GetBasicDetailsForMovie(const dbiplus::sql_record* const record);
+  void GetMovieViewDetails(const dbiplus::sql_record* const record, CVideoInfoTag &details);
   CVideoInfoTag GetDetailsForMovie(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForTvShow(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone, CFileItem* item = NULL);
@@ -1014,4 +1041,16 @@ private:
 
   static void AnnounceRemove(std::string content, int id, bool scanning = false);
   static void AnnounceUpdate(std::string content, int id);
+
+  /*! \brief Cache the ids of the given names of a lookup table for the open batch
+   Names are matched exactly by a single query, names not found are looked up
+   case insensitively when they are added.
+   \param table the lookup table, e.g. genre or actor.
+   \param idField the id column of the table.
+   \param names the names to look up.
+   */
+  void LoadLookupIds(const std::string &table, const std::string &idField, const std::set<std::string> &names);
+
+  //! ids of the names in the lookup tables, by table, cached while a batch is open
+  std::map<std::string, std::map<std::string, int>> m_lookupIds;
 };
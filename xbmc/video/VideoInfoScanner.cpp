@@ -18,6 +18,7 @@
 #include "events/MediaLibraryEvent.h"
 #include "FileItem.h"
 #include "filesystem/Directory.h"
+#include "filesystem/DirectoryManifest.h"
 #include "filesystem/DirectoryCache.h"
 #include "filesystem/File.h"
 #include "filesystem/MultiPathDirectory.h"
@@ -35,6 +36,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "TextureCache.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "URL.h"
 #include "Util.h"
@@ -48,6 +50,7 @@
 #include "video/VideoLibraryQueue.h"
 #include "video/VideoThumbLoader.h"
 #include "VideoInfoDownloader.h"
+#include "VideoScanPipeline.h"
 #include "tags/VideoInfoTagLoaderFactory.h"
 
 using namespace XFILE;
@@ -72,6 +75,7 @@ namespace VIDEO
   void CVideoInfoScanner::Process()
   {
     m_bStop = false;
+    m_clearedScraperCaches.clear();
 
     try
     {
@@ -112,6 +116,13 @@ namespace VIDEO
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
 
+      // movies and music videos are looked up by a pipeline unless it's restricted to a single thread
+      const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+      if (advancedSettings->m_iVideoScannerLocalThreads > 1 || advancedSettings->m_iVideoScannerScraperThreads > 1)
+        m_pipeline.reset(new CVideoScanPipeline(*this, advancedSettings->m_iVideoScannerLocalThreads,
+                                                advancedSettings->m_iVideoScannerScraperThreads,
+                                                advancedSettings->m_iVideoScannerQueueSize));
+
       bool bCancelled = false;
       while (!bCancelled && !m_pathsToScan.empty())
       {
@@ -140,6 +151,12 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      if (m_pipeline)
+      {
+        m_pipeline->Commit(true);
+        m_pipeline.reset();
+      }
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -154,6 +171,7 @@ namespace VIDEO
 
       CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
       m_database.Close();
+      GetDirectoryManifest().Save();
 
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
@@ -161,6 +179,7 @@ namespace VIDEO
     catch (...)
     {
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
+      m_pipeline.reset();
     }
 
     m_bRunning = false;
@@ -269,6 +288,10 @@ namespace VIDEO
     }
 
     std::string hash, dbHash;
+    const bool incremental = (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS) && IsIncremental(strDirectory);
+    const std::string manifestSettings = incremental ? StringUtils::Format("%s|%s|%s", TranslateContent(content).c_str(),
+                                                                           info->ID().c_str(), StringUtils::Join(regexps, "|").c_str())
+                                                     : "";
     if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
     {
       if (m_handle)
@@ -277,6 +300,23 @@ namespace VIDEO
         m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str).c_str(), info->Name().c_str()));
       }
 
+      std::vector<std::string> subDirectories;
+      if (incremental && GetDirectoryManifest().IsUnchanged(strDirectory, manifestSettings, subDirectories))
+      { // unchanged since the last scan - only look at the subfolders
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change (manifest)", CURL::GetRedacted(strDirectory).c_str());
+        if (m_handle)
+          OnDirectoryScanned(strDirectory);
+
+        for (const auto& subDirectory : subDirectories)
+        {
+          if (m_bStop || settings.recurse <= 0)
+            break;
+          if (!DoScan(subDirectory))
+            m_bStop = true;
+        }
+        return !m_bStop;
+      }
+
       std::string fastHash;
       if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
@@ -348,22 +388,16 @@ namespace VIDEO
 
     if (!bSkip)
     {
-      if (RetrieveVideoInfo(items, settings.parent_name_root, content))
-      {
-        if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
+      if (m_pipeline && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
+      { // the hash is stored once all the items of the directory are added
+        std::shared_ptr<CVideoScanPipeline::SDirectoryResult> result = QueueVideoInfo(items, settings.parent_name_root);
+        m_pipeline->AddCallback([this, strDirectory, hash, content, result]()
         {
-          m_database.SetPathHash(strDirectory, hash);
-          if (m_bClean)
-            m_pathsToClean.insert(m_database.GetPathId(strDirectory));
-          CLog::Log(LOGDEBUG, "VideoInfoScanner: Finished adding information from dir %s", CURL::GetRedacted(strDirectory).c_str());
-        }
+          OnDirectoryRetrieved(strDirectory, hash, content, result->found && !result->failed);
+        });
       }
       else
-      {
-        if (m_bClean)
-          m_pathsToClean.insert(m_database.GetPathId(strDirectory));
-        CLog::Log(LOGDEBUG, "VideoInfoScanner: No (new) information was found in dir %s", CURL::GetRedacted(strDirectory).c_str());
-      }
+        OnDirectoryRetrieved(strDirectory, hash, content, RetrieveVideoInfo(items, settings.parent_name_root, content));
     }
     else if (!StringUtils::EqualsNoCase(hash, dbHash) && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
     { // update the hash either way - we may have changed the hash to a fast version
@@ -390,9 +424,113 @@ namespace VIDEO
         }
       }
     }
+
+    // record the directory once it and its subfolders are done, an interrupted scan lists it again
+    if (incremental && !m_bStop)
+    {
+      if (m_pipeline)
+      {
+        std::shared_ptr<CFileItemList> listing = std::make_shared<CFileItemList>();
+        listing->Append(items);
+        m_pipeline->AddCallback([this, strDirectory, hash, manifestSettings, listing]()
+        {
+          if (m_bStop)
+            return;
+          if (hash.empty())
+            GetDirectoryManifest().Remove(strDirectory);
+          else
+            GetDirectoryManifest().Update(strDirectory, manifestSettings, *listing);
+        });
+      }
+      else if (hash.empty())
+        GetDirectoryManifest().Remove(strDirectory);
+      else
+        GetDirectoryManifest().Update(strDirectory, manifestSettings, items);
+    }
     return !m_bStop;
   }
 
+  void CVideoInfoScanner::OnDirectoryRetrieved(const std::string &directory, const std::string &hash, CONTENT_TYPE content, bool foundSomeInfo)
+  {
+    if (foundSomeInfo)
+    {
+      if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
+      {
+        m_database.SetPathHash(directory, hash);
+        if (m_bClean)
+          m_pathsToClean.insert(m_database.GetPathId(directory));
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Finished adding information from dir %s", CURL::GetRedacted(directory).c_str());
+      }
+    }
+    else
+    {
+      if (m_bClean)
+        m_pathsToClean.insert(m_database.GetPathId(directory));
+      CLog::Log(LOGDEBUG, "VideoInfoScanner: No (new) information was found in dir %s", CURL::GetRedacted(directory).c_str());
+    }
+  }
+
+  std::shared_ptr<CVideoScanPipeline::SDirectoryResult> CVideoInfoScanner::QueueVideoInfo(const CFileItemList& items, bool bDirNames)
+  {
+    std::shared_ptr<CVideoScanPipeline::SDirectoryResult> result = std::make_shared<CVideoScanPipeline::SDirectoryResult>();
+    for (int i = 0; i < items.Size() && !m_bStop; ++i)
+    {
+      CFileItemPtr pItem = items[i];
+
+      // we do this since we may have a override per dir
+      ScraperPtr info2 = m_database.GetScraperForPath(pItem->m_bIsFolder ? pItem->GetPath() : items.GetPath());
+      if (!info2) // skip
+        continue;
+
+      // Discard all .nomedia folders
+      if (pItem->m_bIsFolder && HasNoMedia(pItem->GetPath()))
+        continue;
+
+      // Discard all exclude files defined by regExExclude
+      if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExps))
+        continue;
+
+      const CONTENT_TYPE content = info2->Content();
+      if (content == CONTENT_TVSHOWS)
+      { // a show overriding the content of the directory, looked up on the scanner thread as usual
+        m_pipeline->AddCallback([this, pItem, bDirNames, info2, result]() mutable
+        {
+          if (result->failed || m_bStop)
+            return;
+          info2->ClearCache();
+          INFO_RET ret = RetrieveInfoForTvShow(pItem.get(), bDirNames, info2, true, nullptr, true, nullptr);
+          if (ret == INFO_CANCELLED || ret == INFO_ERROR)
+            result->failed = true;
+          else if (ret == INFO_ADDED || ret == INFO_HAVE_ALREADY)
+            result->found = true;
+          else if (ret == INFO_NOT_FOUND)
+            ReportNotFound(*pItem, CONTENT_TVSHOWS);
+        });
+        continue;
+      }
+      if (content != CONTENT_MOVIES && content != CONTENT_MUSICVIDEOS)
+        continue;
+
+      if (pItem->m_bIsFolder || !pItem->IsVideo() || pItem->IsNFO() ||
+         (pItem->IsPlayList() && !URIUtils::HasExtension(pItem->GetPath(), ".strm")))
+        continue;
+
+      if (content == CONTENT_MOVIES ? m_database.HasMovieInfo(pItem->GetPath()) : m_database.HasMusicVideoInfo(pItem->GetPath()))
+      {
+        result->found = true;
+        continue;
+      }
+
+      // the scraper cache is shared by all lookups in flight, so it's cleared once per scan
+      if (m_clearedScraperCaches.insert(info2->ID()).second)
+        info2->ClearCache();
+
+      // the pipeline owns its copy, the listing is still used for the subfolders
+      m_pipeline->Add(std::make_shared<CFileItem>(*pItem), info2, bDirNames, i * 100.f / items.Size(), result);
+    }
+    return result;
+  }
+
   bool CVideoInfoScanner::RetrieveVideoInfo(CFileItemList& items, bool bDirNames, CONTENT_TYPE content, bool useLocal, CScraperUrl* pURL, bool fetchEpisodes, CGUIDialogProgress* pDlgProgress)
   {
     if (pDlgProgress)
@@ -464,19 +602,7 @@ namespace VIDEO
       if (ret == INFO_ADDED || ret == INFO_HAVE_ALREADY)
         FoundSomeInfo = true;
       else if (ret == INFO_NOT_FOUND)
-      {
-        CLog::Log(LOGWARNING, "No information found for item '%s', it won't be added to the library.", CURL::GetRedacted(pItem->GetPath()).c_str());
-
-        MediaType mediaType = MediaTypeMovie;
-        if (info2->Content() == CONTENT_TVSHOWS)
-          mediaType = MediaTypeTvShow;
-        else if (info2->Content() == CONTENT_MUSICVIDEOS)
-          mediaType = MediaTypeMusicVideo;
-        CServiceBroker::GetEventLog().Add(EventPtr(new CMediaLibraryEvent(
-          mediaType, pItem->GetPath(), 24145,
-          StringUtils::Format(g_localizeStrings.Get(24147).c_str(), mediaType.c_str(), URIUtils::GetFileName(pItem->GetPath()).c_str()),
-          pItem->GetArt("thumb"), CURL::GetRedacted(pItem->GetPath()), EventLevel::Warning)));
-      }
+        ReportNotFound(*pItem, info2->Content());
 
       pURL = NULL;
 
@@ -502,6 +628,21 @@ namespace VIDEO
     return FoundSomeInfo;
   }
 
+  void CVideoInfoScanner::ReportNotFound(const CFileItem &item, CONTENT_TYPE content)
+  {
+    CLog::Log(LOGWARNING, "No information found for item '%s', it won't be added to the library.", CURL::GetRedacted(item.GetPath()).c_str());
+
+    MediaType mediaType = MediaTypeMovie;
+    if (content == CONTENT_TVSHOWS)
+      mediaType = MediaTypeTvShow;
+    else if (content == CONTENT_MUSICVIDEOS)
+      mediaType = MediaTypeMusicVideo;
+    CServiceBroker::GetEventLog().Add(EventPtr(new CMediaLibraryEvent(
+      mediaType, item.GetPath(), 24145,
+      StringUtils::Format(g_localizeStrings.Get(24147).c_str(), mediaType.c_str(), URIUtils::GetFileName(item.GetPath()).c_str()),
+      item.GetArt("thumb"), CURL::GetRedacted(item.GetPath()), EventLevel::Warning)));
+  }
+
   CInfoScanner::INFO_RET
   CVideoInfoScanner::RetrieveInfoForTvShow(CFileItem *pItem,
                                            bool bDirNames,
@@ -637,62 +778,23 @@ namespace VIDEO
     if (m_handle)
       m_handle->SetText(pItem->GetMovieName(bDirNames));
 
-    CInfoScanner::INFO_TYPE result = CInfoScanner::NO_NFO;
-    CScraperUrl scrUrl;
     // handle .nfo files
     std::unique_ptr<IVideoInfoTagLoader> loader;
-    if (useLocal)
-    {
-      loader.reset(CVideoInfoTagLoaderFactory::CreateLoader(*pItem, info2, bDirNames));
-      if (loader)
-      {
-        pItem->GetVideoInfoTag()->Reset();
-        result = loader->Load(*pItem->GetVideoInfoTag(), false);
-      }
-    }
+    CInfoScanner::INFO_TYPE result = useLocal ? LoadLocalInfo(pItem, bDirNames, info2, loader) : CInfoScanner::NO_NFO;
     if (result == CInfoScanner::FULL_NFO)
     {
       if (AddVideo(pItem, info2->Content(), bDirNames, true) < 0)
         return INFO_ERROR;
       return INFO_ADDED;
     }
-    if (result == CInfoScanner::URL_NFO || result == CInfoScanner::COMBINED_NFO)
-    {
-      scrUrl = loader->ScraperUrl();
-      pURL = &scrUrl;
-    }
-
-    CScraperUrl url;
-    int retVal = 0;
-    std::string movieTitle = pItem->GetMovieName(bDirNames);
-    int movieYear = -1; // hint that movie title was not found
-    if (result == CInfoScanner::TITLE_NFO)
-    {
-      CVideoInfoTag* tag = pItem->GetVideoInfoTag();
-      movieTitle = tag->GetTitle();
-      movieYear = tag->GetYear(); // movieYear is expected to be >= 0
-    }
-    if (pURL && !pURL->m_url.empty())
-      url = *pURL;
-    else if ((retVal = FindVideo(movieTitle, movieYear, info2, url, pDlgProgress)) <= 0)
-      return retVal < 0 ? INFO_CANCELLED : INFO_NOT_FOUND;
 
-    CLog::Log(LOGDEBUG,
-              "VideoInfoScanner: Fetching url '%s' using %s scraper (content: '%s')",
-              url.m_url[0].m_url.c_str(), info2->Name().c_str(),
-              TranslateContent(info2->Content()).c_str());
+    INFO_RET ret = ScrapeInfo(pItem, bDirNames, info2, result, loader.get(), pURL, pDlgProgress);
+    if (ret != INFO_ADDED)
+      return ret;
 
-    if (GetDetails(pItem, url, info2,
-                   (result == CInfoScanner::COMBINED_NFO ||
-                    result == CInfoScanner::OVERRIDE_NFO) ? loader.get() : nullptr,
-                   pDlgProgress))
-    {
-      if (AddVideo(pItem, info2->Content(), bDirNames, useLocal) < 0)
-        return INFO_ERROR;
-      return INFO_ADDED;
-    }
-    //! @todo This is not strictly correct as we could fail to download information here or error, or be cancelled
-    return INFO_NOT_FOUND;
+    if (AddVideo(pItem, info2->Content(), bDirNames, useLocal) < 0)
+      return INFO_ERROR;
+    return INFO_ADDED;
   }
 
   CInfoScanner::INFO_RET
@@ -716,25 +818,49 @@ namespace VIDEO
     if (m_handle)
       m_handle->SetText(pItem->GetMovieName(bDirNames));
 
-    CInfoScanner::INFO_TYPE result = CInfoScanner::NO_NFO;
-    CScraperUrl scrUrl;
     // handle .nfo files
     std::unique_ptr<IVideoInfoTagLoader> loader;
-    if (useLocal)
-    {
-      loader.reset(CVideoInfoTagLoaderFactory::CreateLoader(*pItem, info2, bDirNames));
-      if (loader)
-      {
-        pItem->GetVideoInfoTag()->Reset();
-        result = loader->Load(*pItem->GetVideoInfoTag(), false);
-      }
-    }
+    CInfoScanner::INFO_TYPE result = useLocal ? LoadLocalInfo(pItem, bDirNames, info2, loader) : CInfoScanner::NO_NFO;
     if (result == CInfoScanner::FULL_NFO)
     {
       if (AddVideo(pItem, info2->Content(), bDirNames, true) < 0)
         return INFO_ERROR;
       return INFO_ADDED;
     }
+
+    INFO_RET ret = ScrapeInfo(pItem, bDirNames, info2, result, loader.get(), pURL, pDlgProgress);
+    if (ret != INFO_ADDED)
+      return ret;
+
+    if (AddVideo(pItem, info2->Content(), bDirNames, useLocal) < 0)
+      return INFO_ERROR;
+    return INFO_ADDED;
+  }
+
+  CInfoScanner::INFO_TYPE
+  CVideoInfoScanner::LoadLocalInfo(CFileItem *pItem,
+                                   bool bDirNames,
+                                   const ScraperPtr &info2,
+                                   std::unique_ptr<IVideoInfoTagLoader> &loader)
+  {
+    loader.reset(CVideoInfoTagLoaderFactory::CreateLoader(*pItem, info2, bDirNames));
+    if (!loader)
+      return CInfoScanner::NO_NFO;
+
+    pItem->GetVideoInfoTag()->Reset();
+    return loader->Load(*pItem->GetVideoInfoTag(), false);
+  }
+
+  CInfoScanner::INFO_RET
+  CVideoInfoScanner::ScrapeInfo(CFileItem *pItem,
+                                bool bDirNames,
+                                const ScraperPtr &info2,
+                                CInfoScanner::INFO_TYPE result,
+                                IVideoInfoTagLoader *loader,
+                                CScraperUrl* pURL,
+                                CGUIDialogProgress* pDlgProgress)
+  {
+    CScraperUrl scrUrl;
     if (result == CInfoScanner::URL_NFO || result == CInfoScanner::COMBINED_NFO)
     {
       scrUrl = loader->ScraperUrl();
@@ -763,13 +889,10 @@ namespace VIDEO
 
     if (GetDetails(pItem, url, info2,
                    (result == CInfoScanner::COMBINED_NFO ||
-                    result == CInfoScanner::OVERRIDE_NFO) ? loader.get() : nullptr,
+                    result == CInfoScanner::OVERRIDE_NFO) ? loader : nullptr,
                    pDlgProgress))
-    {
-      if (AddVideo(pItem, info2->Content(), bDirNames, useLocal) < 0)
-        return INFO_ERROR;
       return INFO_ADDED;
-    }
+
     //! @todo This is not strictly correct as we could fail to download information here or error, or be cancelled
     return INFO_NOT_FOUND;
   }
@@ -1281,14 +1404,19 @@ namespace VIDEO
   }
 
   long CVideoInfoScanner::AddVideo(CFileItem *pItem, const CONTENT_TYPE &content, bool videoFolder /* = false */, bool useLocal /* = true */, const CVideoInfoTag *showInfo /* = NULL */, bool libraryImport /* = false */)
+  {
+    if (!libraryImport)
+      GetArtwork(pItem, content, videoFolder, useLocal && !pItem->IsPlugin(), showInfo ? showInfo->m_strPath : "");
+
+    return AddToDatabase(pItem, content, videoFolder, useLocal, showInfo, libraryImport);
+  }
+
+  long CVideoInfoScanner::AddToDatabase(CFileItem *pItem, const CONTENT_TYPE &content, bool videoFolder /* = false */, bool useLocal /* = true */, const CVideoInfoTag *showInfo /* = NULL */, bool libraryImport /* = false */)
   {
     // ensure our database is open (this can get called via other classes)
     if (!m_database.Open())
       return -1;
 
-    if (!libraryImport)
-      GetArtwork(pItem, content, videoFolder, useLocal && !pItem->IsPlugin(), showInfo ? showInfo->m_strPath : "");
-
     // ensure the art map isn't completely empty by specifying an empty thumb
     std::map<std::string, std::string> art = pItem->GetArt();
     if (art.empty())
@@ -1869,6 +1997,17 @@ namespace VIDEO
     return "";
   }
 
+  XFILE::CDirectoryManifest& CVideoInfoScanner::GetDirectoryManifest()
+  {
+    return CServiceBroker::GetVideoScanManifest();
+  }
+
+  bool CVideoInfoScanner::IsIncremental(const std::string &directory) const
+  {
+    return CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryIncrementalScan &&
+           XFILE::CDirectoryManifest::IsSupported(directory);
+  }
+
   std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
@@ -2056,10 +2195,15 @@ namespace VIDEO
     MOVIELIST movielist;
     CVideoInfoDownloader imdb(scraper);
     int returncode = imdb.FindMovie(title, year, movielist, progress);
-    if (returncode < 0 || (returncode == 0 && (m_bStop || !DownloadFailed(progress))))
-    { // scraper reported an error, or we had an error and user wants to cancel the scan
-      m_bStop = true;
-      return -1; // cancelled
+    if (returncode <= 0)
+    {
+      // lookups of a pipelined scan may fail at the same time, only ask one at a time
+      CSingleLock lock(m_lookupErrorSection);
+      if (returncode < 0 || m_bStop || !DownloadFailed(progress))
+      { // scraper reported an error, or we had an error and user wants to cancel the scan
+        m_bStop = true;
+        return -1; // cancelled
+      }
     }
     if (returncode > 0 && movielist.size())
     {
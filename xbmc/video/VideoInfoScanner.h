@@ -8,18 +8,27 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "InfoScanner.h"
 #include "VideoDatabase.h"
+#include "VideoScanPipeline.h"
 #include "addons/Scraper.h"
+#include "threads/CriticalSection.h"
 
 class CRegExp;
 class CFileItem;
 class CFileItemList;
 
+namespace XFILE
+{
+  class CDirectoryManifest;
+}
+
 namespace VIDEO
 {
   class IVideoInfoTagLoader;
@@ -36,6 +45,8 @@ namespace VIDEO
 
   class CVideoInfoScanner : public CInfoScanner
   {
+    friend class CVideoScanPipeline;
+
   public:
     CVideoInfoScanner();
     ~CVideoInfoScanner() override;
@@ -110,6 +121,48 @@ namespace VIDEO
     INFO_RET RetrieveInfoForMusicVideo(CFileItem *pItem, bool bDirNames, ADDON::ScraperPtr &scraper, bool useLocal, CScraperUrl* pURL, CGUIDialogProgress* pDlgProgress);
     INFO_RET RetrieveInfoForEpisodes(CFileItem *item, long showID, const ADDON::ScraperPtr &scraper, bool useLocal, CGUIDialogProgress *progress = NULL);
 
+    /*! \brief Load the local information (.nfo file) of a movie or music video
+     \param pItem item to load the information of.
+     \param bDirNames whether to use the folder name for the information.
+     \param scraper scraper the item is looked up with.
+     \param loader [out] the loader of the information, to supplement online details with.
+     \return the kind of information found.
+     */
+    INFO_TYPE LoadLocalInfo(CFileItem *pItem, bool bDirNames, const ADDON::ScraperPtr &scraper, std::unique_ptr<IVideoInfoTagLoader> &loader);
+
+    /*! \brief Look up a movie or music video online, supplemented with its local information
+     \param pItem item to look up, receives the details.
+     \param bDirNames whether to use the folder name for the lookup.
+     \param scraper scraper to look the item up with.
+     \param result the kind of local information found by LoadLocalInfo().
+     \param loader the loader returned by LoadLocalInfo().
+     \param pURL an optional URL to use to retrieve online info.
+     \param pDlgProgress progress dialog to update and check for cancellation during processing.
+     \return INFO_ADDED if the details were retrieved and the item can be added, INFO_NOT_FOUND or INFO_CANCELLED otherwise.
+     */
+    INFO_RET ScrapeInfo(CFileItem *pItem, bool bDirNames, const ADDON::ScraperPtr &scraper, INFO_TYPE result,
+                        IVideoInfoTagLoader *loader, CScraperUrl* pURL, CGUIDialogProgress* pDlgProgress);
+
+    /*! \brief Add an item whose artwork is already retrieved to the database.
+     \sa AddVideo
+     */
+    long AddToDatabase(CFileItem *pItem, const CONTENT_TYPE &content, bool videoFolder = false, bool useLocal = true, const CVideoInfoTag *showInfo = NULL, bool libraryImport = false);
+
+    /*! \brief Queue the movies and music videos of a directory listing on the pipeline
+     \param items the directory listing.
+     \param bDirNames whether to use folder names for lookups.
+     \return the result of the directory, final once the items queued are committed.
+     */
+    std::shared_ptr<CVideoScanPipeline::SDirectoryResult> QueueVideoInfo(const CFileItemList& items, bool bDirNames);
+
+    /*! \brief Store the hash of a directory whose items were retrieved, or mark it for cleaning
+     */
+    void OnDirectoryRetrieved(const std::string &directory, const std::string &hash, CONTENT_TYPE content, bool foundSomeInfo);
+
+    /*! \brief Log and report an item without information, it's not added to the library
+     */
+    void ReportNotFound(const CFileItem &item, CONTENT_TYPE content);
+
     /*! \brief Update the progress bar with the heading and line and check for cancellation
      \param progress CGUIDialogProgress bar
      \param heading string id of heading
@@ -187,6 +240,14 @@ namespace VIDEO
      */
     std::string GetFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
 
+    /*! \brief Manifest of the video directories seen by incremental scans
+     */
+    static XFILE::CDirectoryManifest& GetDirectoryManifest();
+
+    /*! \brief Whether directory is scanned incrementally, i.e. only listed if changed
+     */
+    bool IsIncremental(const std::string &directory) const;
+
     /*! \brief Retrieve a "fast" hash of the given directory recursively (if available)
      Performs a stat() on the directory, and uses modified time to create a "fast"
      hash of each folder. If no modified time is available, the create time is used,
@@ -225,12 +286,15 @@ namespace VIDEO
     bool EnumerateSeriesFolder(CFileItem* item, EPISODELIST& episodeList);
     bool ProcessItemByVideoInfoTag(const CFileItem *item, EPISODELIST &episodeList);
 
-    bool m_bStop;
+    std::atomic<bool> m_bStop; //!< also set by the workers of the pipeline
     bool m_scanAll;
     std::string m_strStartDir;
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::unique_ptr<CVideoScanPipeline> m_pipeline;
+    std::set<std::string> m_clearedScraperCaches;
+    CCriticalSection m_lookupErrorSection;
   };
 }
 
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlaceholderLoader.h"
+#include "FileItem.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+#include <map>
+
+namespace
+{
+template<typename T>
+void Release(T& value)
+{
+  T().swap(value);
+}
+}
+
+bool CVideoPlaceholderLoader::LoadItems(const std::vector<CFileItemPtr>& placeholders, std::vector<CFileItemPtr>& loaded)
+{
+  std::vector<std::string> ids;
+  for (const auto& item : placeholders)
+  {
+    if (item->HasVideoInfoTag() && item->GetVideoInfoTag()->m_type == MediaTypeMovie)
+      ids.push_back(StringUtils::Format("%i", item->GetVideoInfoTag()->m_iDbId));
+  }
+
+  CFileItemList items;
+  if (!ids.empty())
+  {
+    CVideoDatabase db;
+    if (!db.Open())
+      return false;
+
+    CDatabase::Filter filter("movie_view.idMovie IN (" + StringUtils::Join(ids, ",") + ")");
+    if (!db.GetMoviesByWhere("videodb://movies/titles/", filter, items))
+      return false;
+  }
+
+  std::map<int, CFileItemPtr> movies;
+  for (const auto& item : items)
+    movies[item->GetVideoInfoTag()->m_iDbId] = item;
+
+  loaded.clear();
+  loaded.reserve(placeholders.size());
+  for (const auto& item : placeholders)
+  {
+    auto movie = item->HasVideoInfoTag() ? movies.find(item->GetVideoInfoTag()->m_iDbId) : movies.end();
+    loaded.push_back(movie != movies.end() ? movie->second : CFileItemPtr());
+  }
+  return true;
+}
+
+void CVideoPlaceholderLoader::FillItem(CFileItem& item, const CFileItem& loaded)
+{
+  // the thumb loader may have loaded the stream details of the placeholder already
+  CStreamDetails streamDetails;
+  if (item.HasVideoInfoTag())
+    streamDetails = item.GetVideoInfoTag()->m_streamDetails;
+
+  item.UpdateInfo(loaded, false);
+
+  CVideoInfoTag* tag = item.GetVideoInfoTag();
+  if (!tag->HasStreamDetails())
+    tag->m_streamDetails = streamDetails;
+}
+
+void CVideoPlaceholderLoader::UnloadItem(CFileItem& item)
+{
+  if (!item.HasVideoInfoTag())
+    return;
+
+  // drop what CVideoDatabase::GetBasicDetailsForMovie() doesn't get
+  CVideoInfoTag* tag = item.GetVideoInfoTag();
+  Release(tag->m_director);
+  Release(tag->m_writingCredits);
+  Release(tag->m_genre);
+  Release(tag->m_country);
+  Release(tag->m_strTagLine);
+  Release(tag->m_strPlotOutline);
+  Release(tag->m_strTrailer);
+  Release(tag->m_strPlot);
+  Release(tag->m_cast);
+  Release(tag->m_tags);
+  Release(tag->m_studio);
+  Release(tag->m_showLink);
+  tag->m_strPictureURL = CScraperUrl();
+  tag->m_fanart = CFanart();
+}
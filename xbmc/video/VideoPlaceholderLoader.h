@@ -0,0 +1,22 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "PlaceholderLoader.h"
+
+/*!
+ \brief Fills in the movie placeholders added by CVideoDatabase::GetMoviesByWhere()
+ */
+class CVideoPlaceholderLoader : public CPlaceholderLoader
+{
+protected:
+  bool LoadItems(const std::vector<CFileItemPtr>& placeholders, std::vector<CFileItemPtr>& loaded) override;
+  void FillItem(CFileItem& item, const CFileItem& loaded) override;
+  void UnloadItem(CFileItem& item) override;
+};
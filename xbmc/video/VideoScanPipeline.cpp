@@ -0,0 +1,275 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoScanPipeline.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "VideoInfoScanner.h"
+#include "dialogs/GUIDialogExtendedProgressBar.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "video/tags/IVideoInfoTagLoader.h"
+
+#include <algorithm>
+
+using namespace VIDEO;
+
+CVideoScanPipeline::CVideoScanPipeline(CVideoInfoScanner& scanner, unsigned int localThreads, unsigned int scraperThreads, unsigned int maxQueued)
+  : m_scanner(scanner),
+    m_maxQueued(std::max(maxQueued, 1u))
+{
+  // the job manager drops jobs once it's cancelling them, e.g. while shutting down
+  if (StartWorkers(Stage::LOCAL, std::max(localThreads, 1u)) == 0 ||
+      StartWorkers(Stage::SCRAPER, std::max(scraperThreads, 1u)) == 0)
+    m_inline = true;
+}
+
+CVideoScanPipeline::~CVideoScanPipeline()
+{
+  {
+    CSingleLock lock(m_section);
+    m_finishing = true;
+    // anything not committed yet is dropped, the directories are scanned again next time
+    m_local.clear();
+    m_scraper.clear();
+  }
+  m_localQueued.Set();
+  m_scraperQueued.Set();
+  m_stopped.Wait();
+}
+
+unsigned int CVideoScanPipeline::StartWorkers(Stage stage, unsigned int count)
+{
+  unsigned int started = 0;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    {
+      CSingleLock lock(m_section);
+      m_running++;
+      m_stopped.Reset();
+    }
+    if (CJobManager::GetInstance().Submit([this, stage]() { RunWorker(stage); }, CJob::PRIORITY_DEDICATED))
+    {
+      started++;
+      continue;
+    }
+
+    CSingleLock lock(m_section);
+    if (--m_running == 0)
+      m_stopped.Set();
+  }
+  return started;
+}
+
+void CVideoScanPipeline::Add(const std::shared_ptr<CFileItem>& item, const ADDON::ScraperPtr& scraper, bool dirNames, float progress,
+                             const std::shared_ptr<SDirectoryResult>& directory)
+{
+  EntryPtr entry = std::make_shared<SEntry>();
+  entry->item = item;
+  entry->scraper = scraper;
+  entry->dirNames = dirNames;
+  entry->progress = progress;
+  entry->directory = directory;
+
+  if (m_inline)
+  {
+    {
+      CSingleLock lock(m_section);
+      m_entries.push_back(entry);
+    }
+    Process(*entry, Stage::LOCAL);
+    if (entry->stage == Stage::SCRAPER)
+      Process(*entry, Stage::SCRAPER);
+    Commit(false);
+    return;
+  }
+
+  // the queues are bounded, wait for the database to catch up
+  while (true)
+  {
+    Commit(false);
+    {
+      CSingleLock lock(m_section);
+      if (m_entries.size() < m_maxQueued)
+      {
+        m_entries.push_back(entry);
+        m_local.push_back(entry);
+        break;
+      }
+    }
+    m_done.WaitMSec(100);
+  }
+  m_localQueued.Set();
+}
+
+void CVideoScanPipeline::AddCallback(const std::function<void()>& callback)
+{
+  EntryPtr entry = std::make_shared<SEntry>();
+  entry->callback = callback;
+  entry->stage = Stage::DONE;
+
+  CSingleLock lock(m_section);
+  m_entries.push_back(entry);
+}
+
+void CVideoScanPipeline::Commit(bool wait)
+{
+  // the items ready at once are written in a single transaction, callbacks run outside of it
+  bool batch = false;
+  while (true)
+  {
+    EntryPtr entry;
+    {
+      CSingleLock lock(m_section);
+      if (!m_entries.empty() && m_entries.front()->stage == Stage::DONE)
+      {
+        entry = m_entries.front();
+        m_entries.pop_front();
+      }
+    }
+
+    if (batch && (!entry || entry->callback))
+    {
+      m_scanner.m_database.CommitBatch();
+      batch = false;
+    }
+
+    if (entry)
+    {
+      if (!batch && !entry->callback && m_scanner.m_database.Open())
+      {
+        m_scanner.m_database.BeginBatch();
+        m_scanner.m_database.Close();
+        batch = true;
+      }
+      CommitEntry(*entry);
+      continue;
+    }
+
+    {
+      CSingleLock lock(m_section);
+      if (m_entries.empty() || !wait)
+        return;
+    }
+    m_done.WaitMSec(100);
+  }
+}
+
+bool CVideoScanPipeline::IsStopped() const
+{
+  return m_scanner.m_bStop;
+}
+
+void CVideoScanPipeline::RunWorker(Stage stage)
+{
+  std::deque<EntryPtr>& queue = stage == Stage::LOCAL ? m_local : m_scraper;
+  CEvent& queued = stage == Stage::LOCAL ? m_localQueued : m_scraperQueued;
+
+  while (true)
+  {
+    EntryPtr entry;
+    {
+      CSingleLock lock(m_section);
+      if (!queue.empty())
+      {
+        entry = queue.front();
+        queue.pop_front();
+      }
+      else if (m_finishing)
+        break;
+    }
+
+    if (!entry)
+    {
+      queued.WaitMSec(100);
+      continue;
+    }
+
+    Process(*entry, stage);
+
+    CSingleLock lock(m_section);
+    if (entry->stage == Stage::SCRAPER && stage == Stage::LOCAL)
+    {
+      m_scraper.push_back(entry);
+      m_scraperQueued.Set();
+    }
+    else
+      m_done.Set();
+  }
+
+  CSingleLock lock(m_section);
+  if (--m_running == 0)
+    m_stopped.Set();
+}
+
+void CVideoScanPipeline::Process(SEntry& entry, Stage stage)
+{
+  CInfoScanner::INFO_RET result = CInfoScanner::INFO_CANCELLED;
+  Stage next = Stage::DONE;
+  CFileItem* item = entry.item.get();
+
+  if (IsStopped())
+    result = CInfoScanner::INFO_CANCELLED;
+  else if (stage == Stage::LOCAL)
+  {
+    entry.nfo = m_scanner.LoadLocalInfo(item, entry.dirNames, entry.scraper, entry.loader);
+    if (entry.nfo == CInfoScanner::FULL_NFO)
+      result = CInfoScanner::INFO_ADDED;
+    else
+      next = Stage::SCRAPER;
+  }
+  else
+    result = m_scanner.ScrapeInfo(item, entry.dirNames, entry.scraper, entry.nfo, entry.loader.get(), nullptr, nullptr);
+
+  // fetching the artwork may download and cache images, keep it off the scanner thread
+  if (next == Stage::DONE && result == CInfoScanner::INFO_ADDED)
+    m_scanner.GetArtwork(item, entry.scraper->Content(), entry.dirNames, !item->IsPlugin());
+
+  CSingleLock lock(m_section);
+  entry.result = result;
+  entry.stage = next;
+}
+
+void CVideoScanPipeline::CommitEntry(SEntry& entry)
+{
+  if (entry.callback)
+  {
+    entry.callback();
+    return;
+  }
+
+  SDirectoryResult& directory = *entry.directory;
+  if (directory.failed)
+    return;
+
+  CFileItem& item = *entry.item;
+  const CONTENT_TYPE content = entry.scraper->Content();
+  CInfoScanner::INFO_RET ret = entry.result;
+  if (ret == CInfoScanner::INFO_ADDED && m_scanner.AddToDatabase(&item, content, entry.dirNames) < 0)
+    ret = CInfoScanner::INFO_ERROR;
+
+  if (m_scanner.m_handle)
+    m_scanner.m_handle->SetPercentage(entry.progress);
+
+  if (ret == CInfoScanner::INFO_CANCELLED || ret == CInfoScanner::INFO_ERROR)
+  {
+    // everything still queued is cancelled once the scan is stopped
+    if (!IsStopped())
+      CLog::Log(LOGWARNING,
+                "VideoInfoScanner: Error %u occurred while retrieving"
+                "information for %s.", ret,
+                CURL::GetRedacted(item.GetPath()).c_str());
+    directory.found = false;
+    directory.failed = true;
+  }
+  else if (ret == CInfoScanner::INFO_ADDED || ret == CInfoScanner::INFO_HAVE_ALREADY)
+    directory.found = true;
+  else if (ret == CInfoScanner::INFO_NOT_FOUND)
+    m_scanner.ReportNotFound(item, content);
+}
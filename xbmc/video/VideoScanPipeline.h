@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "InfoScanner.h"
+#include "addons/Scraper.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+class CFileItem;
+
+namespace VIDEO
+{
+  class CVideoInfoScanner;
+  class IVideoInfoTagLoader;
+
+  /*!
+   \brief Retrieves the information of movies and music videos in stages
+
+   Items listed by the scanner thread first have their local information
+   (.nfo files) loaded, then are looked up by their scraper if needed, each
+   stage on its own workers. The results are added to the database on the
+   scanner thread, in the order the items were queued. Actions queued in
+   between (e.g. storing the hash of a directory) run once everything queued
+   before them is added.
+   */
+  class CVideoScanPipeline
+  {
+  public:
+    /*! \brief Outcome of the items of a directory, updated as they are added
+     */
+    struct SDirectoryResult
+    {
+      bool found = false;  //!< information was found for some item
+      bool failed = false; //!< an error occurred or the scan was cancelled, the remaining items are skipped
+    };
+
+    /*!
+     \param scanner the scanner whose thread queues and commits the items
+     \param localThreads number of workers loading local information
+     \param scraperThreads number of workers running scraper lookups
+     \param maxQueued number of items in flight before Add() waits for the database
+     */
+    CVideoScanPipeline(CVideoInfoScanner& scanner, unsigned int localThreads, unsigned int scraperThreads, unsigned int maxQueued);
+    ~CVideoScanPipeline();
+
+    /*! \brief Queue a movie or music video file to retrieve the information of
+     \param item the file, owned by the pipeline from now on
+     \param scraper the scraper of the file, not shared with other items
+     \param dirNames whether to use the folder name for lookups
+     \param progress the percentage to show once the item is added
+     \param directory the result of the directory the item belongs to
+     */
+    void Add(const std::shared_ptr<CFileItem>& item, const ADDON::ScraperPtr& scraper, bool dirNames, float progress,
+             const std::shared_ptr<SDirectoryResult>& directory);
+
+    /*! \brief Queue an action to run on the scanner thread after the items queued before it are added
+     */
+    void AddCallback(const std::function<void()>& callback);
+
+    /*! \brief Add the finished items to the database and run the callbacks, in order
+     \param wait whether to wait until everything queued is done
+     */
+    void Commit(bool wait);
+
+  private:
+    CVideoScanPipeline(const CVideoScanPipeline&) = delete;
+    CVideoScanPipeline& operator=(const CVideoScanPipeline&) = delete;
+
+    enum class Stage
+    {
+      LOCAL,
+      SCRAPER,
+      DONE
+    };
+
+    struct SEntry
+    {
+      std::shared_ptr<CFileItem> item;
+      ADDON::ScraperPtr scraper;
+      bool dirNames = false;
+      float progress = 0.0f;
+      std::shared_ptr<SDirectoryResult> directory;
+      std::function<void()> callback;
+      std::unique_ptr<IVideoInfoTagLoader> loader;
+      CInfoScanner::INFO_TYPE nfo = CInfoScanner::NO_NFO;
+      CInfoScanner::INFO_RET result = CInfoScanner::INFO_CANCELLED;
+      Stage stage = Stage::LOCAL;
+    };
+    typedef std::shared_ptr<SEntry> EntryPtr;
+
+    unsigned int StartWorkers(Stage stage, unsigned int count);
+    void RunWorker(Stage stage);
+    void Process(SEntry& entry, Stage stage);
+    void CommitEntry(SEntry& entry);
+    bool IsStopped() const;
+
+    CVideoInfoScanner& m_scanner;
+    size_t m_maxQueued;
+
+    CCriticalSection m_section;
+    std::deque<EntryPtr> m_entries; //!< everything queued, in commit order
+    std::deque<EntryPtr> m_local;
+    std::deque<EntryPtr> m_scraper;
+    bool m_finishing = false;
+    unsigned int m_running = 0;
+    bool m_inline = false; //!< no workers could be started, items are processed by Add()
+
+    CEvent m_localQueued;
+    CEvent m_scraperQueued;
+    CEvent m_done;
+    CEvent m_stopped{true};
+  };
+}
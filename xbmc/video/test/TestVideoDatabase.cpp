@@ -0,0 +1,189 @@
+/*
+ *  Copyright (C) 2005-2019 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+// a fresh database in special://temp/, removed again when done
+class CTestDatabase : public CVideoDatabase
+{
+public:
+  CTestDatabase()
+  {
+    XFILE::CFile::Delete("special://temp/TestVideoDatabase.db");
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.name = "TestVideoDatabase";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    m_connected = Connect("TestVideoDatabase", settings, true);
+  }
+
+  ~CTestDatabase() override
+  {
+    Close();
+    XFILE::CFile::Delete("special://temp/TestVideoDatabase.db");
+  }
+
+  using CVideoDatabase::AddToTable;
+
+  bool m_connected;
+};
+
+typedef struct
+{
+  const char* path;
+  const char* title;
+  const char* genres[3];
+  const char* actors[3];
+} MovieEntry;
+
+static const MovieEntry Movies[] = {
+  { "/movies/alien.mkv",   "Alien",   { "Horror", "Drama" },           { "Sigourney Weaver", "John Hurt" } },
+  { "/movies/aliens.mkv",  "Aliens",  { "Action", "Drama" },           { "Sigourney Weaver", "Michael Biehn" } },
+  // matches the genre of the first movie case insensitively
+  { "/movies/alien3.mkv",  "Alien 3", { "Horror", "Drama", "drama" },  { "Sigourney Weaver" } },
+};
+
+CVideoInfoTag MakeMovie(const MovieEntry& entry)
+{
+  CVideoInfoTag movie;
+  movie.m_strFileNameAndPath = entry.path;
+  movie.m_strTitle = entry.title;
+  for (int i = 0; i < 3 && entry.genres[i]; i++)
+    movie.m_genre.push_back(entry.genres[i]);
+  for (int i = 0; i < 3 && entry.actors[i]; i++)
+  {
+    SActorInfo actor;
+    actor.strName = entry.actors[i];
+    actor.order = i;
+    movie.m_cast.push_back(actor);
+  }
+  return movie;
+}
+}
+
+TEST(TestVideoDatabase, SetDetailsForMovies)
+{
+  CTestDatabase database;
+  ASSERT_TRUE(database.m_connected);
+
+  std::vector<CVideoInfoTag> movies;
+  for (const auto& entry : Movies)
+    movies.push_back(MakeMovie(entry));
+  std::vector<std::map<std::string, std::string>> artwork(movies.size());
+
+  EXPECT_EQ(3, database.SetDetailsForMovies(movies, artwork));
+  EXPECT_FALSE(database.InBatch());
+
+  for (const auto& movie : movies)
+  {
+    ASSERT_GT(movie.m_iDbId, 0);
+
+    CVideoInfoTag details;
+    ASSERT_TRUE(database.GetMovieInfo(movie.m_strFileNameAndPath, details, movie.m_iDbId));
+    EXPECT_EQ(movie.m_strTitle, details.m_strTitle);
+    EXPECT_EQ(movie.m_cast.size(), details.m_cast.size());
+  }
+
+  EXPECT_EQ("3", database.GetSingleValue("genre", "count(1)"));
+  EXPECT_EQ("1", database.GetSingleValue("genre", "count(1)", "name='Drama'"));
+  EXPECT_EQ("3", database.GetSingleValue("actor", "count(1)"));
+
+  // movies already in the library are updated, shared names are found again
+  movies[0].m_genre.push_back("Science Fiction");
+  EXPECT_EQ(3, database.SetDetailsForMovies(movies, artwork));
+  EXPECT_EQ("3", database.GetSingleValue("movie", "count(1)"));
+  EXPECT_EQ("4", database.GetSingleValue("genre", "count(1)"));
+}
+
+TEST(TestVideoDatabase, LookupIdsAfterRollback)
+{
+  CTestDatabase database;
+  ASSERT_TRUE(database.m_connected);
+
+  // an id handed out by a batch that is rolled back must not be reused
+  database.BeginBatch();
+  EXPECT_GT(database.AddToTable("genre", "genre_id", "name", "Western"), 0);
+  database.RollbackBatch();
+  EXPECT_EQ("0", database.GetSingleValue("genre", "count(1)"));
+
+  database.BeginBatch();
+  int id = database.AddToTable("genre", "genre_id", "name", "Western");
+  EXPECT_EQ("Western", database.GetSingleValue("genre", "name", StringUtils::Format("genre_id=%i", id)));
+
+  // nor one added after the savepoint of a rolled back transaction
+  database.BeginTransaction();
+  int dropped = database.AddToTable("genre", "genre_id", "name", "Comedy");
+  database.RollbackTransaction();
+  int added = database.AddToTable("genre", "genre_id", "name", "Comedy");
+  EXPECT_EQ(id, database.AddToTable("genre", "genre_id", "name", "Western"));
+  EXPECT_TRUE(database.CommitBatch());
+
+  EXPECT_EQ("Comedy", database.GetSingleValue("genre", "name", StringUtils::Format("genre_id=%i", added)));
+  if (dropped != added)
+    EXPECT_EQ("", database.GetSingleValue("genre", "name", StringUtils::Format("genre_id=%i", dropped)));
+  EXPECT_EQ("2", database.GetSingleValue("genre", "count(1)"));
+}
+
+// Adds 10000 movies one by one, then again in a single batch, and prints both
+// times. Run with --gtest_also_run_disabled_tests.
+TEST(TestVideoDatabase, DISABLED_Benchmark_SetDetailsForMovies)
+{
+  const int count = 10000;
+  std::vector<CVideoInfoTag> movies(count);
+  for (int i = 0; i < count; i++)
+  {
+    movies[i].m_strFileNameAndPath = StringUtils::Format("/movies/%i/movie %i.mkv", i / 100, i);
+    movies[i].m_strTitle = StringUtils::Format("Movie %i", i);
+    movies[i].m_genre = { StringUtils::Format("Genre %i", i % 20), "Drama" };
+    movies[i].m_studio = { StringUtils::Format("Studio %i", i % 200) };
+    movies[i].m_director = { StringUtils::Format("Director %i", i % 2000) };
+    for (int j = 0; j < 10; j++)
+    {
+      SActorInfo actor;
+      actor.strName = StringUtils::Format("Actor %i", (i * 7 + j * 131) % 20000);
+      actor.order = j;
+      movies[i].m_cast.push_back(actor);
+    }
+  }
+
+  std::chrono::steady_clock::duration single;
+  {
+    CTestDatabase database;
+    ASSERT_TRUE(database.m_connected);
+    const std::map<std::string, std::string> noArtwork;
+    auto start = std::chrono::steady_clock::now();
+    for (auto movie : movies)
+      database.SetDetailsForMovie(movie.m_strFileNameAndPath, movie, noArtwork);
+    single = std::chrono::steady_clock::now() - start;
+  }
+
+  std::chrono::steady_clock::duration batch;
+  {
+    CTestDatabase database;
+    ASSERT_TRUE(database.m_connected);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(count, database.SetDetailsForMovies(movies, std::vector<std::map<std::string, std::string>>()));
+    batch = std::chrono::steady_clock::now() - start;
+  }
+
+  std::cout << count << " movies: one by one "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(single).count() << " ms, batch "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(batch).count() << " ms" << std::endl;
+}
@@ -743,7 +743,9 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
     if (strDirectory.empty())
       SetupShares();
 
+    // the items are bound to our container, which fills in any placeholders as they're shown
     CFileItemList dirItems;
+    dirItems.SetAllowPlaceholders(true);
     if (!GetDirectoryItems(pathToUrl, dirItems, UseFileDirectories()))
       return false;
 
@@ -18,7 +18,9 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIControlFactory.h"
 #include "guilib/GUIFontManager.h"
+#include "guilib/GUIFrameStats.h"
 #include "guilib/GUITextLayout.h"
+#include "guilib/GUITexture.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/GUIControlProfiler.h"
 #include "GUIInfoManager.h"
@@ -30,6 +32,19 @@
 #include "platform/linux/XMemUtils.h"
 #endif
 
+#include <algorithm>
+
+namespace
+{
+// the frame statistics are only refreshed now and then to keep them readable
+const unsigned int FRAME_STATS_INTERVAL = 500;
+const unsigned int GRAPH_FRAMES = 240;
+const float GRAPH_BAR_WIDTH = 2.0f;
+const float GRAPH_HEIGHT = 100.0f;
+// frame time in ms shown at the top of the graph
+const float GRAPH_MAX_FRAMETIME = 50.0f;
+}
+
 CGUIWindowDebugInfo::CGUIWindowDebugInfo(void)
   : CGUIDialog(WINDOW_DEBUG_INFO, "", DialogModalityType::MODELESS)
 {
@@ -42,7 +57,8 @@ CGUIWindowDebugInfo::~CGUIWindowDebugInfo(void) = default;
 
 void CGUIWindowDebugInfo::UpdateVisibility()
 {
-  if (LOG_LEVEL_DEBUG_FREEMEM <= CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_logLevel || g_SkinInfo->IsDebugging())
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (LOG_LEVEL_DEBUG_FREEMEM <= advancedSettings->m_logLevel || advancedSettings->m_guiShowFrameStats || g_SkinInfo->IsDebugging())
     Open();
   else
     Close();
@@ -151,6 +167,17 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
     }
   }
 
+  // render the frame statistics
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiShowFrameStats)
+  {
+    UpdateFrameStats(currentTime);
+    if (!info.empty())
+      info += "\n";
+    info += m_frameStatsInfo;
+  }
+  else
+    m_frameTimes.clear();
+
   float w, h;
   if (m_layout->Update(info))
     MarkDirtyRegion();
@@ -159,6 +186,45 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
   float x = xShift + 0.04f * CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth();
   float y = yShift + 0.04f * CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight();
   m_renderRegion.SetRect(x, y, x+w, y+h);
+
+  if (!m_frameTimes.empty())
+  {
+    m_graphRegion.SetRect(x, y + h + 10, x + GRAPH_FRAMES * GRAPH_BAR_WIDTH, y + h + 10 + GRAPH_HEIGHT);
+    m_renderRegion.Union(m_graphRegion);
+  }
+}
+
+void CGUIWindowDebugInfo::UpdateFrameStats(unsigned int currentTime)
+{
+  if (!m_frameTimes.empty() && currentTime - m_frameStatsTime < FRAME_STATS_INTERVAL)
+    return;
+  m_frameStatsTime = currentTime;
+
+  const CGUIFrameStats &frameStats = CGUIFrameStats::GetInstance();
+  const CGUIFrameStats::Statistics stats = frameStats.GetStatistics();
+  const CGUIFrameStats::Summary *stages = stats.stages;
+  m_frameStatsInfo = StringUtils::Format("Frame: %.1f ms (p99 %.1f, max %.1f)  Hitches: %llu (upload %llu)\n"
+                                         "FrameMove %.2f  Process %.2f  Dirty %.2f  Render %.2f  Swap %.2f  Upload %.2f  Info %.2f ms (%.0f)",
+                                         stats.frameTime.average, stats.frameTime.p99, stats.frameTime.max,
+                                         static_cast<unsigned long long>(stats.hitches),
+                                         static_cast<unsigned long long>(stats.uploadHitches),
+                                         stages[CGUIFrameStats::STAGE_FRAMEMOVE].average,
+                                         stages[CGUIFrameStats::STAGE_PROCESS].average,
+                                         stages[CGUIFrameStats::STAGE_DIRTYREGIONS].average,
+                                         stages[CGUIFrameStats::STAGE_RENDER].average,
+                                         stages[CGUIFrameStats::STAGE_SWAP].average,
+                                         stages[CGUIFrameStats::STAGE_UPLOAD].average,
+                                         stages[CGUIFrameStats::STAGE_INFO].average,
+                                         stats.infoUpdates);
+
+  m_frameTimes.clear();
+  for (const auto &frame : frameStats.GetFrames(GRAPH_FRAMES))
+    m_frameTimes.push_back(frame.frameTime);
+  // keep the graph even before any frame was measured
+  if (m_frameTimes.empty())
+    m_frameTimes.push_back(0.0f);
+
+  MarkDirtyRegion();
 }
 
 void CGUIWindowDebugInfo::Render()
@@ -166,4 +232,21 @@ void CGUIWindowDebugInfo::Render()
   CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo(), false);
   if (m_layout)
     m_layout->RenderOutline(m_renderRegion.x1, m_renderRegion.y1, 0xffffffff, 0xff000000, 0, 0);
+
+  if (!m_frameTimes.empty())
+  {
+    CGUITexture::DrawQuad(m_graphRegion, 0x80000000);
+    float x = m_graphRegion.x1;
+    for (float frameTime : m_frameTimes)
+    {
+      // green for 60 fps, yellow for 30 fps, red below
+      UTILS::Color color = frameTime < 17.0f ? 0xff00ff00 : frameTime < 34.0f ? 0xffffff00 : 0xffff0000;
+      float height = std::min(frameTime, GRAPH_MAX_FRAMETIME) * GRAPH_HEIGHT / GRAPH_MAX_FRAMETIME;
+      CGUITexture::DrawQuad(CRect(x, m_graphRegion.y2 - height, x + GRAPH_BAR_WIDTH, m_graphRegion.y2), color);
+      x += GRAPH_BAR_WIDTH;
+    }
+    // a line at 16.7 ms
+    float y = m_graphRegion.y2 - (1000.0f / 60.0f) * GRAPH_HEIGHT / GRAPH_MAX_FRAMETIME;
+    CGUITexture::DrawQuad(CRect(m_graphRegion.x1, y, m_graphRegion.x2, y + 1), 0xffffffff);
+  }
 }
@@ -9,6 +9,9 @@
 #pragma once
 
 #include "guilib/GUIDialog.h"
+
+#include <string>
+#include <vector>
 #ifdef TARGET_POSIX
 #include "platform/linux/LinuxResourceCounter.h"
 #endif
@@ -27,7 +30,13 @@ public:
 protected:
   void UpdateVisibility() override;
 private:
+  void UpdateFrameStats(unsigned int currentTime);
+
   CGUITextLayout *m_layout;
+  std::string m_frameStatsInfo;
+  std::vector<float> m_frameTimes;
+  unsigned int m_frameStatsTime = 0;
+  CRect m_graphRegion;
 #ifdef TARGET_POSIX
   CLinuxResourceCounter m_resourceCounter;
 #endif